@@ -2,6 +2,7 @@ from ._version import __version__  # noqa: F401
 # :obj:`str`: version
 
 from .core import exec_sed_task, preprocess_sed_task, exec_sed_doc, exec_sedml_docs_in_combine_archive  # noqa: F401
+from .results import read_binary_results  # noqa: F401
 
 __all__ = [
     '__version__',
@@ -10,6 +11,7 @@ __all__ = [
     'preprocess_sed_task',
     'exec_sed_doc',
     'exec_sedml_docs_in_combine_archive',
+    'read_binary_results',
 ]
 
 
@@ -12,28 +12,38 @@ from biosimulators_utils.config import get_config, Config  # noqa: F401
 from biosimulators_utils.log.data_model import CombineArchiveLog, TaskLog, StandardOutputErrorCapturerLevel  # noqa: F401
 from biosimulators_utils.viz.data_model import VizFormat  # noqa: F401
 from biosimulators_utils.report.data_model import ReportFormat, VariableResults, SedDocumentResults  # noqa: F401
-from biosimulators_utils.sedml.data_model import (Task, ModelLanguage, ModelAttributeChange, UniformTimeCourseSimulation,  # noqa: F401
-                                                  Algorithm, Variable, Symbol)
+from biosimulators_utils.sedml.data_model import (Task, RepeatedTask, ModelLanguage, ModelAttributeChange,  # noqa: F401
+                                                  UniformTimeCourseSimulation, Algorithm, Variable, Symbol)
 from biosimulators_utils.sedml import validation
 from biosimulators_utils.sedml.exec import exec_sed_doc as base_exec_sed_doc
-from biosimulators_utils.sedml.utils import apply_changes_to_xml_model
+from biosimulators_utils.sedml.io import SedmlSimulationReader
+from biosimulators_utils.sedml.utils import apply_changes_to_xml_model, get_variables_for_task
 from biosimulators_utils.simulator.utils import get_algorithm_substitution_policy
 from biosimulators_utils.utils.core import raise_errors_warnings
 from biosimulators_utils.warnings import warn, BioSimulatorsWarning
 from kisao.data_model import AlgorithmSubstitutionPolicy, ALGORITHM_SUBSTITUTION_POLICY_LEVELS
 from kisao.utils import get_preferred_substitute_algorithm_by_ids
+from concurrent.futures import ThreadPoolExecutor
 import copy
+import filecmp
+import functools
 import libsbmlsim
 import lxml.etree
+import numpy
 import os
-import pandas
 import tempfile
+import warnings
 
 
-__all__ = ['exec_sedml_docs_in_combine_archive', 'exec_sed_doc', 'exec_sed_task', 'preprocess_sed_task']
+__all__ = ['exec_sedml_docs_in_combine_archive', 'exec_sed_doc', 'exec_sed_task', 'preprocess_sed_task',
+           'simulate_sed_task', 'get_num_of_workers', 'get_independent_tasks', 'get_model_change_setters',
+           'ParallelTaskExecuter', 'is_same_sed_task']
 
+NUM_OF_WORKERS_ENV_VAR = 'LIBSBMLSIM_NUM_OF_WORKERS'
+# :obj:`str`: environment variable which sets the default number of threads which execute the tasks of a SED document
 
-def exec_sedml_docs_in_combine_archive(archive_filename, out_dir, config=None):
+
+def exec_sedml_docs_in_combine_archive(archive_filename, out_dir, config=None, num_of_workers=None):
     """ Execute the SED tasks defined in a COMBINE/OMEX archive and save the outputs
 
     Args:
@@ -46,6 +56,8 @@ def exec_sedml_docs_in_combine_archive(archive_filename, out_dir, config=None):
               with reports at keys ``{ relative-path-to-SED-ML-file-within-archive }/{ report.id }`` within the HDF5 file
 
         config (:obj:`Config`, optional): BioSimulators common configuration
+        num_of_workers (:obj:`int`, optional): number of threads which execute the independent tasks of each
+            SED document (default: :obj:`get_num_of_workers`)
 
     Returns:
         :obj:`tuple`:
@@ -53,7 +65,8 @@ def exec_sedml_docs_in_combine_archive(archive_filename, out_dir, config=None):
             * :obj:`SedDocumentResults`: results
             * :obj:`CombineArchiveLog`: log
     """
-    return exec_sedml_docs_in_archive(exec_sed_doc, archive_filename, out_dir,
+    return exec_sedml_docs_in_archive(functools.partial(exec_sed_doc, num_of_workers=num_of_workers),
+                                      archive_filename, out_dir,
                                       apply_xml_model_changes=True,
                                       config=config)
 
@@ -61,9 +74,13 @@ def exec_sedml_docs_in_combine_archive(archive_filename, out_dir, config=None):
 def exec_sed_doc(doc, working_dir, base_out_path, rel_out_path=None,
                  apply_xml_model_changes=True,
                  log=None, indent=0, pretty_print_modified_xml_models=False,
-                 log_level=StandardOutputErrorCapturerLevel.c, config=None):
+                 log_level=StandardOutputErrorCapturerLevel.c, config=None, num_of_workers=None):
     """ Execute the tasks specified in a SED document and generate the specified outputs
 
+    The independent tasks of the document (see :obj:`get_independent_tasks`) are executed concurrently by
+    :obj:`ParallelTaskExecuter`. Their results and logs are handed to the outputs in the order of the document,
+    so they are the same as those of a sequential execution.
+
     Args:
         doc (:obj:`SedDocument` or :obj:`str`): SED document or a path to SED-ML file which defines a SED document
         working_dir (:obj:`str`): working directory of the SED document (path relative to which models are located)
@@ -83,7 +100,8 @@ def exec_sed_doc(doc, working_dir, base_out_path, rel_out_path=None,
         pretty_print_modified_xml_models (:obj:`bool`, optional): if :obj:`True`, pretty print modified XML models
         log_level (:obj:`StandardOutputErrorCapturerLevel`, optional): level at which to log output
         config (:obj:`Config`, optional): BioSimulators common configuration
-        simulator_config (:obj:`SimulatorConfig`, optional): tellurium configuration
+        num_of_workers (:obj:`int`, optional): number of threads which execute the independent tasks
+            (default: :obj:`get_num_of_workers`)
 
     Returns:
         :obj:`tuple`:
@@ -91,14 +109,268 @@ def exec_sed_doc(doc, working_dir, base_out_path, rel_out_path=None,
             * :obj:`ReportResults`: results of each report
             * :obj:`SedDocumentLog`: log of the document
     """
-    return base_exec_sed_doc(exec_sed_task, doc, working_dir, base_out_path,
-                             rel_out_path=rel_out_path,
-                             apply_xml_model_changes=apply_xml_model_changes,
-                             log=log,
-                             indent=indent,
-                             pretty_print_modified_xml_models=pretty_print_modified_xml_models,
-                             log_level=log_level,
-                             config=config)
+    if num_of_workers is None:
+        num_of_workers = get_num_of_workers()
+
+    task_executer = exec_sed_task
+    if num_of_workers > 1:
+        # read the document here to plan its tasks; reading errors are reported by ``base_exec_sed_doc``
+        if isinstance(doc, str):
+            try:
+                doc = SedmlSimulationReader().run(doc)
+            except Exception:
+                pass
+
+        if not isinstance(doc, str):
+            task_executer = ParallelTaskExecuter(doc, working_dir, num_of_workers, config=config)
+
+    try:
+        return base_exec_sed_doc(task_executer, doc, working_dir, base_out_path,
+                                 rel_out_path=rel_out_path,
+                                 apply_xml_model_changes=apply_xml_model_changes,
+                                 log=log,
+                                 indent=indent,
+                                 pretty_print_modified_xml_models=pretty_print_modified_xml_models,
+                                 log_level=log_level,
+                                 config=config)
+    finally:
+        if isinstance(task_executer, ParallelTaskExecuter):
+            task_executer.close()
+
+
+def get_num_of_workers():
+    """ Get the default number of threads which execute the tasks of a SED document
+
+    Returns:
+        :obj:`int`: value of the environment variable ``LIBSBMLSIM_NUM_OF_WORKERS``, or the number of processors
+    """
+    value = os.getenv(NUM_OF_WORKERS_ENV_VAR, None)
+    if value is None:
+        return os.cpu_count() or 1
+
+    try:
+        num_of_workers = int(value)
+    except ValueError:
+        num_of_workers = 0
+    if num_of_workers < 1:
+        raise ValueError('`{}` must be a positive integer, not `{}`.'.format(NUM_OF_WORKERS_ENV_VAR, value))
+    return num_of_workers
+
+
+def get_independent_tasks(doc):
+    """ Get the tasks of a SED document which do not depend on other tasks, and which no other task depends on
+
+    A repeated task and its sub-tasks form a chain of dependent executions (each iteration changes the models of the
+    sub-tasks), so they are left in the order of the document. The remaining basic tasks only read their own model
+    and simulation.
+
+    Args:
+        doc (:obj:`SedDocument`): SED document
+
+    Returns:
+        :obj:`list` of :obj:`Task`: independent tasks, in the order of the document
+    """
+    sub_task_ids = set()
+    for task in doc.tasks:
+        if isinstance(task, RepeatedTask):
+            for sub_task in task.sub_tasks:
+                sub_task_ids.add(sub_task.task.id)
+
+    return [task for task in doc.tasks if isinstance(task, Task) and task.id not in sub_task_ids]
+
+
+def get_model_change_setters(changes, model_etree):
+    """ Get the calls of a prepared model (``libsbmlsim.sbmlsim_model``) which apply model attribute changes, so
+    that they are applied without rewriting and parsing the SBML file again
+
+    The value of a global parameter, the size of a compartment, the initial amount or concentration of a species and
+    the value of a local parameter of a kinetic law are supported.
+
+    Args:
+        changes (:obj:`list` of :obj:`ModelAttributeChange`): changes
+        model_etree (:obj:`lxml.etree._ElementTree`): model
+
+    Returns:
+        :obj:`list` of :obj:`tuple`: name and arguments of the method of the prepared model for each change, or
+            :obj:`None` if a change is not supported
+    """
+    setters = []
+    for change in changes:
+        target, _, attribute = change.target.rpartition('/@')
+        namespaces = {prefix: uri for prefix, uri in (change.target_namespaces or {}).items() if prefix}
+        try:
+            elements = model_etree.xpath(target, namespaces=namespaces)
+            value = float(change.new_value)
+        except (lxml.etree.XPathError, TypeError, ValueError):
+            return None
+        if len(elements) != 1 or not isinstance(elements[0], lxml.etree._Element) or elements[0].get('id') is None:
+            return None
+
+        element = elements[0]
+        id = element.get('id')
+        tag = lxml.etree.QName(element).localname
+        parent = element.getparent()
+        container = parent.getparent() if parent is not None else None
+        container_tag = lxml.etree.QName(container).localname if container is not None else None
+
+        if tag == 'species' and attribute == 'initialAmount':
+            setters.append(('setInitialAmount', (id, value)))
+        elif tag == 'species' and attribute == 'initialConcentration':
+            setters.append(('setInitialConcentration', (id, value)))
+        elif tag == 'compartment' and attribute == 'size':
+            setters.append(('setValue', (id, value)))
+        elif tag == 'parameter' and attribute == 'value' and container_tag == 'model':
+            setters.append(('setValue', (id, value)))
+        elif (
+            tag in ['parameter', 'localParameter'] and attribute == 'value' and container_tag == 'kineticLaw'
+            and container.getparent() is not None and container.getparent().get('id') is not None
+        ):
+            setters.append(('setLocalParameter', (container.getparent().get('id'), id, value)))
+        else:
+            return None
+    return setters
+
+
+class ParallelTaskExecuter(object):
+    """ Task executer which simulates the independent tasks of a SED document on a pool of threads
+
+    The simulations are submitted when the executer is created. The document executer then calls it for each task
+    in the order of the document, with the arguments of the task at that point. If they are those of the submitted
+    simulation (same model file, changes, simulation and variables), its results are recorded into the log of the
+    call by :obj:`exec_sed_task` as a sequential execution does, otherwise the task is executed in place. The
+    threads only run the simulations (:obj:`simulate_sed_task`), which do not write to the Python streams nor raise
+    warnings, so the output, the warnings, the errors and the logs of the tasks do not depend on the order in which
+    the threads finish. Other tasks (sub-tasks of repeated tasks and models which need the document to be resolved)
+    are executed in place.
+
+    Simulations release the GIL (see ``libsbmlsim.i``), so the threads run concurrently. Each simulation uses a
+    single thread, so that the pool does not run more threads than processors. Tasks are preprocessed in the calling
+    thread, and the warnings which they raise are raised again when their results are requested.
+
+    Attributes:
+        config (:obj:`Config`): BioSimulators common configuration
+        executor (:obj:`ThreadPoolExecutor`): pool of threads
+        submitted (:obj:`dict`): dictionary that maps the id of each submitted task to the task, its variables,
+            preprocessed task, warnings and the future of its simulation
+    """
+
+    def __init__(self, doc, working_dir, num_of_workers, config=None):
+        """
+        Args:
+            doc (:obj:`SedDocument`): SED document
+            working_dir (:obj:`str`): working directory of the SED document (path relative to which models are located)
+            num_of_workers (:obj:`int`): number of threads
+            config (:obj:`Config`, optional): BioSimulators common configuration
+        """
+        self.config = config or get_config()
+        self.executor = ThreadPoolExecutor(max_workers=num_of_workers)
+        self.submitted = {}
+
+        for task in get_independent_tasks(doc):
+            # models which refer to other models, URLs or URNs, and other kinds of changes are resolved in place
+            model = task.model
+            if (
+                model is None
+                or model.source is None
+                or not os.path.isfile(os.path.join(working_dir, model.source))
+                or any(not isinstance(change, ModelAttributeChange) for change in model.changes)
+            ):
+                continue
+
+            variables = get_variables_for_task(doc, task)
+
+            task = copy.copy(task)
+            task.model = copy.copy(model)
+            task.model.source = os.path.join(working_dir, model.source)
+
+            with warnings.catch_warnings(record=True) as caught_warnings:
+                warnings.simplefilter('always')
+                try:
+                    preprocessed_task = preprocess_sed_task(task, variables, config=self.config)
+                except Exception:
+                    # executed again in place, where the error is reported
+                    continue
+            preprocessed_task['simulation']['num_of_threads'] = 1
+
+            future = self.executor.submit(simulate_sed_task, task, preprocessed_task)
+            self.submitted[task.id] = (task, variables, preprocessed_task, caught_warnings, future)
+
+    def __call__(self, task, variables, preprocessed_task=None, log=None, config=None):
+        """ Get the results of a task
+
+        Args:
+            task (:obj:`Task`): task
+            variables (:obj:`list` of :obj:`Variable`): variables that should be recorded
+            preprocessed_task (:obj:`dict`, optional): preprocessed information about the task
+            log (:obj:`TaskLog`, optional): log for the task
+            config (:obj:`Config`, optional): BioSimulators common configuration
+
+        Returns:
+            :obj:`tuple`:
+
+                :obj:`VariableResults`: results of variables
+                :obj:`TaskLog`: log
+        """
+        submitted = self.submitted.pop(task.id, None)
+        if submitted is not None and (
+            preprocessed_task is not None
+            or not is_same_sed_task(task, variables, submitted[0], submitted[1])
+        ):
+            submitted[4].cancel()
+            submitted = None
+        if submitted is None:
+            return exec_sed_task(task, variables, preprocessed_task=preprocessed_task, log=log, config=config)
+
+        _, _, preprocessed_task, caught_warnings, future = submitted
+        for caught_warning in caught_warnings:
+            warnings.warn(caught_warning.message, caught_warning.category)
+
+        return _exec_sed_task(task, variables, preprocessed_task=preprocessed_task, log=log, config=config,
+                              simulation=future.result())
+
+    def close(self):
+        """ Cancel the simulations whose results were not requested, and stop the threads """
+        for submitted in self.submitted.values():
+            submitted[4].cancel()
+        self.submitted = {}
+        self.executor.shutdown(wait=True)
+
+
+def is_same_sed_task(task, variables, other_task, other_variables):
+    """ Determine whether two tasks simulate the same model file with the same changes and simulation, and record
+    the same variables
+
+    Args:
+        task (:obj:`Task`): task
+        variables (:obj:`list` of :obj:`Variable`): variables of :obj:`task`
+        other_task (:obj:`Task`): other task
+        other_variables (:obj:`list` of :obj:`Variable`): variables of :obj:`other_task`
+
+    Returns:
+        :obj:`bool`: :obj:`True` if the tasks give the same results
+    """
+    model = task.model
+    other_model = other_task.model
+    if (
+        model is None
+        or model.source is None
+        or len(model.changes) != len(other_model.changes)
+        or any(not change.is_equal(other_change) for change, other_change in zip(model.changes, other_model.changes))
+        or not task.simulation.is_equal(other_task.simulation)
+    ):
+        return False
+
+    def get_variable_key(variable):
+        return (variable.id, variable.target, variable.target_namespaces or {}, variable.symbol)
+
+    if [get_variable_key(variable) for variable in variables] != [get_variable_key(variable) for variable in other_variables]:
+        return False
+
+    try:
+        return os.path.samefile(model.source, other_model.source) or filecmp.cmp(model.source, other_model.source,
+                                                                                   shallow=False)
+    except OSError:
+        return False
 
 
 def exec_sed_task(task, variables, preprocessed_task=None, log=None, config=None):
@@ -113,6 +385,26 @@ def exec_sed_task(task, variables, preprocessed_task=None, log=None, config=None
         log (:obj:`TaskLog`, optional): log for the task
         config (:obj:`Config`, optional): BioSimulators common configuration
 
+    Returns:
+        :obj:`tuple`:
+
+            :obj:`VariableResults`: results of variables
+            :obj:`TaskLog`: log
+    '''
+    return _exec_sed_task(task, variables, preprocessed_task=preprocessed_task, log=log, config=config)
+
+
+def _exec_sed_task(task, variables, preprocessed_task=None, log=None, config=None, simulation=None):
+    ''' Execute a task, or record the results of its simulation by :obj:`simulate_sed_task`
+
+    Args:
+        task (:obj:`Task`): task
+        variables (:obj:`list` of :obj:`Variable`): variables that should be recorded
+        preprocessed_task (:obj:`dict`, optional): preprocessed information about the task
+        log (:obj:`TaskLog`, optional): log for the task
+        config (:obj:`Config`, optional): BioSimulators common configuration
+        simulation (:obj:`dict`, optional): simulation of the task with :obj:`preprocessed_task`
+
     Returns:
         :obj:`tuple`:
 
@@ -127,14 +419,136 @@ def exec_sed_task(task, variables, preprocessed_task=None, log=None, config=None
     if preprocessed_task is None:
         preprocessed_task = preprocess_sed_task(task, variables, config=config)
 
+    if simulation is None:
+        simulation = simulate_sed_task(task, preprocessed_task)
+    results = simulation['results']
+    sim = task.simulation
+    print_interval = simulation['arguments']['print_interval']
+
+    if results.isError():
+        raise ValueError(results.error_message)
+
+    # columns of the results, as NumPy arrays backed by the result
+    results_columns = {'time': results.getTimeValues()}
+    for get_values, get_num_of_columns, get_column_name in [
+        (results.getSpeciesValues, results.getNumOfSpecies, results.getSpeciesNameAtIndex),
+        (results.getParameterValues, results.getNumOfParameters, results.getParameterNameAtIndex),
+        (results.getCompartmentValues, results.getNumOfCompartments, results.getCompartmentNameAtIndex),
+    ]:
+        values = get_values()
+        for i_column in range(get_num_of_columns()):
+            results_columns[get_column_name(i_column)] = values[:, i_column]
+
+    # extract results
+    xpath_sbml_id_map = preprocessed_task['model']['xpath_sbml_id_map']
+    variable_results = VariableResults()
+    unsupported_symbols = []
+    unsupported_targets = []
+    for variable in variables:
+        if variable.symbol:
+            if variable.symbol == Symbol.time.value:
+                variable_result = results_columns['time']
+            else:
+                variable_result = None
+                unsupported_symbols.append((variable.id, variable.symbol))
+
+        else:
+            sbml_id = xpath_sbml_id_map[variable.target]
+            if sbml_id in results_columns:
+                variable_result = results_columns[sbml_id]
+            else:
+                variable_result = None
+                unsupported_targets.append((variable.id, variable.target))
+
+        if variable_result is not None:
+            if preprocessed_task['simulation']['algorithm_kisao_id'] in ['KISAO_0000086', 'KISAO_0000321']:
+                variable_results[variable.id] = numpy.array(variable_result[-(sim.number_of_steps*print_interval + 1)::print_interval])
+
+            else:
+                variable_results[variable.id] = numpy.array(variable_result[-(sim.number_of_steps + 1):])
+
+    if unsupported_symbols:
+        msg = '{} variables involve unsupported symbols:\n  {}\n\nThe following symbols are supported:\n  {}'.format(
+            len(unsupported_symbols),
+            '\n  '.join('{}: {}'.format(id, symbol) for id, symbol in sorted(unsupported_symbols)),
+            '\n  '.join([Symbol.time.value]))
+        raise NotImplementedError(msg)
+
+    if unsupported_targets:
+        supported_targets = []
+
+        for i_compartment in range(results.getNumOfCompartments()):
+            id = results.getCompartmentNameAtIndex(i_compartment)
+            supported_targets.append("/sbml:sbml/sbml:model/sbml:listOfCompartments/sbml:compartment[@id='{}']".format(id))
+
+        for i_parameter in range(results.getNumOfParameters()):
+            id = results.getParameterNameAtIndex(i_parameter)
+            supported_targets.append("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='{}']".format(id))
+
+        for i_species in range(results.getNumOfSpecies()):
+            id = results.getSpeciesNameAtIndex(i_species)
+            supported_targets.append("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='{}']".format(id))
+
+        msg = '{} variables involve unsupported targets:\n  {}\n\nThe following targets are supported:\n  {}'.format(
+            len(unsupported_targets),
+            '\n  '.join('{}: {}'.format(id, target) for id, target in sorted(unsupported_targets)),
+            '\n  '.join(supported_targets))
+        raise NotImplementedError(msg)
+
+    # log action
+    if config.LOG:
+        log.algorithm = preprocessed_task['simulation']['algorithm_kisao_id']
+        log.simulator_details = {
+            'method': simulation['method'],
+            'arguments': simulation['arguments'],
+            'statistics': {
+                'steps': results.getNumOfSteps(),
+                'rejected_steps': results.getNumOfRejectedSteps(),
+                'rhs_evaluations': results.getNumOfRhsEvaluations(),
+                'jacobian_evaluations': results.getNumOfJacobianEvaluations(),
+                'lu_decompositions': results.getNumOfLUDecompositions(),
+                'stiff_steps': results.getNumOfStiffSteps(),
+                'method_switches': results.getNumOfMethodSwitches(),
+            },
+            # wall time (seconds) of the phases; the prepared model is read once by :obj:`preprocess_sed_task`
+            'timing': {
+                'read_sbml': simulation['read_time'],
+                'prepare': results.getPrepareTime(),
+                'simulation': results.getSimulationTime(),
+            },
+        }
+
+    # return results and log
+    return variable_results, log
+
+
+def simulate_sed_task(task, preprocessed_task):
+    """ Simulate the model of a preprocessed task, without recording its variables
+
+    The simulation only calls libSBMLSim, which releases the GIL, and does not raise warnings, so that
+    :obj:`ParallelTaskExecuter` runs it on its threads.
+
+    Args:
+        task (:obj:`Task`): task
+        preprocessed_task (:obj:`dict`): preprocessed information about the task (see :obj:`preprocess_sed_task`)
+
+    Returns:
+        :obj:`dict`: libSBMLSim function (``method``), its ``arguments``, ``results`` (``libsbmlsim.myResult``) and
+        the wall time (seconds) spent reading the SBML (``read_time``)
+    """
     model = task.model
     sim = task.simulation
 
-    # change model
+    # change model; the changes of values are set in the prepared model, other changes are applied to the SBML file
+    model_setters = []
+    model_filename = None
     if model.changes:
         raise_errors_warnings(validation.validate_model_change_types(model.changes, (ModelAttributeChange,)),
                               error_summary='Changes for model `{}` are not supported.'.format(model.id))
 
+        model_setters = get_model_change_setters(model.changes, preprocessed_task['model']['etree'])
+
+    if model_setters is None:
         model_etree = preprocessed_task['model']['etree']
 
         model = copy.deepcopy(model)
@@ -151,14 +565,12 @@ def exec_sed_task(task, variables, preprocessed_task=None, log=None, config=None
                           encoding="utf-8",
                           standalone=False,
                           pretty_print=False)
-    else:
-        model_filename = model.source
 
     # validate time course
     if sim.initial_time != 0:
         msg = 'Initial time must be zero, not `{}`.'.format(sim.initial_time)
 
-        if model.changes:
+        if model_filename:
             os.remove(model_filename)
 
         raise NotImplementedError(msg)
@@ -187,7 +599,7 @@ def exec_sed_task(task, variables, preprocessed_task=None, log=None, config=None
             time_step,
         )
 
-        if model.changes:
+        if model_filename:
             os.remove(model_filename)
 
         raise ValueError(msg)
@@ -210,107 +622,54 @@ def exec_sed_task(task, variables, preprocessed_task=None, log=None, config=None
             time_step,
         )
 
-        if model.changes:
+        if model_filename:
             os.remove(model_filename)
 
         raise ValueError(msg)
     print_interval = round(print_interval)
 
     # execute the simulation
-    results = libsbmlsim.simulateSBMLFromFile(model_filename,
-                                              sim.output_end_time,
-                                              time_step,
-                                              print_interval,
-                                              preprocessed_task['simulation']['print_amount'],
-                                              preprocessed_task['simulation']['integrator'],
-                                              preprocessed_task['simulation']['use_lazy_newton_method'])
-
-    if model.changes:
+    if model_filename:
+        simulation_method = 'sbmlsim_model_create_from_file'
+        prepared_model = libsbmlsim.sbmlsim_model_create_from_file(model_filename)
         os.remove(model_filename)
 
-    if results.isError():
-        raise ValueError(results.error_message)
-
-    # read results through CSV because the ``get*ValueAtIndex`` functions have bugs
-    fid, filename = tempfile.mkstemp(suffix='.csv')
-    os.close(fid)
-    libsbmlsim.write_csv(results, filename)
-    results_df = pandas.read_csv(filename)
-    os.remove(filename)
-
-    # extract results
-    xpath_sbml_id_map = preprocessed_task['model']['xpath_sbml_id_map']
-    variable_results = VariableResults()
-    unsupported_symbols = []
-    unsupported_targets = []
-    for variable in variables:
-        if variable.symbol:
-            if variable.symbol == Symbol.time.value:
-                variable_result = results_df['time']
-            else:
-                variable_result = None
-                unsupported_symbols.append((variable.id, variable.symbol))
-
-        else:
-            sbml_id = xpath_sbml_id_map[variable.target]
-            if sbml_id in results_df:
-                variable_result = results_df[sbml_id]
-            else:
-                variable_result = None
-                unsupported_targets.append((variable.id, variable.target))
-
-        if variable_result is not None:
-            if preprocessed_task['simulation']['algorithm_kisao_id'] in ['KISAO_0000086', 'KISAO_0000321']:
-                variable_results[variable.id] = variable_result[-(sim.number_of_steps*print_interval + 1)::print_interval].to_numpy()
-
-            else:
-                variable_results[variable.id] = variable_result[-(sim.number_of_steps + 1):].to_numpy()
-
-    if unsupported_symbols:
-        msg = '{} variables involve unsupported symbols:\n  {}\n\nThe following symbols are supported:\n  {}'.format(
-            len(unsupported_symbols),
-            '\n  '.join('{}: {}'.format(id, symbol) for id, symbol in sorted(unsupported_symbols)),
-            '\n  '.join([Symbol.time.value]))
-        raise NotImplementedError(msg)
-
-    if unsupported_targets:
-        supported_targets = []
-
-        for i_compartment in range(results.getNumOfCompartments()):
-            id = results.getCompartmentNameAtIndex(i_compartment)
-            supported_targets.append("/sbml:sbml/sbml:model/sbml:listOfCompartments/sbml:compartment[@id='{}']".format(id))
-
-        for i_parameter in range(results.getNumOfParameters()):
-            id = results.getParameterNameAtIndex(i_parameter)
-            supported_targets.append("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='{}']".format(id))
-
-        for i_species in range(results.getNumOfSpecies()):
-            id = results.getSpeciesNameAtIndex(i_species)
-            supported_targets.append("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='{}']".format(id))
-
-        msg = '{} variables involve unsupported targets:\n  {}\n\nThe following targets are supported:\n  {}'.format(
-            len(unsupported_targets),
-            '\n  '.join('{}: {}'.format(id, target) for id, target in sorted(unsupported_targets)),
-            '\n  '.join(supported_targets))
-        raise NotImplementedError(msg)
-
-    # log action
-    if config.LOG:
-        log.algorithm = preprocessed_task['simulation']['algorithm_kisao_id']
-        log.simulator_details = {
-            'method': "simulateSBMLFromFile",
-            'arguments': {
-                'sim_time': sim.output_end_time,
-                'dt': time_step,
-                'print_interval': print_interval,
-                'print_amount': preprocessed_task['simulation']['print_amount'],
-                'method': preprocessed_task['simulation']['integrator'],
-                'use_lazy_method': preprocessed_task['simulation']['use_lazy_newton_method'],
-            },
-        }
+    else:
+        simulation_method = 'sbmlsim_model.simulate'
+        prepared_model = preprocessed_task['model']['prepared']
+        if prepared_model is None:
+            # the task was preprocessed with changes which can not be set in a prepared model
+            prepared_model = preprocessed_task['model']['prepared'] = libsbmlsim.sbmlsim_model_create_from_file(model.source)
+        prepared_model.resetValues()
+        for setter, args in model_setters:
+            getattr(prepared_model, setter)(*args)
+
+    arguments = {
+        'sim_time': sim.output_end_time,
+        'dt': time_step,
+        'print_interval': print_interval,
+        'print_amount': preprocessed_task['simulation']['print_amount'],
+        'method': preprocessed_task['simulation']['integrator'],
+        'use_lazy_method': preprocessed_task['simulation']['use_lazy_newton_method'],
+        'atol': preprocessed_task['simulation']['atol'],
+        'rtol': preprocessed_task['simulation']['rtol'],
+    }
+    prepared_model.setNumOfThreads(preprocessed_task['simulation']['num_of_threads'])
+    results = prepared_model.simulate(arguments['sim_time'],
+                                      arguments['dt'],
+                                      arguments['print_interval'],
+                                      arguments['print_amount'],
+                                      arguments['method'],
+                                      arguments['use_lazy_method'],
+                                      arguments['atol'],
+                                      arguments['rtol'])
 
-    # return results and log
-    return variable_results, log
+    return {
+        'method': simulation_method,
+        'arguments': arguments,
+        'results': results,
+        'read_time': prepared_model.getReadTime(),
+    }
 
 
 def preprocess_sed_task(task, variables, config=None):
@@ -367,10 +726,13 @@ def preprocess_sed_task(task, variables, config=None):
             ALGORITHM_SUBSTITUTION_POLICY_LEVELS[algorithm_substitution_policy]
             > ALGORITHM_SUBSTITUTION_POLICY_LEVELS[AlgorithmSubstitutionPolicy.NONE]
         ):
+            supported_changes = ['KISAO_0000594', 'KISAO_0000483']
+            if KISAO_ALGORITHMS_MAP[exec_kisao_id]['uses_tolerances']:
+                supported_changes += ['KISAO_0000211', 'KISAO_0000209']
             changes = []
             unsupported_changes = []
             for change in sim.algorithm.changes:
-                if change.kisao_id in ['KISAO_0000594', 'KISAO_0000483']:
+                if change.kisao_id in supported_changes:
                     changes.append(change)
                 else:
                     unsupported_changes.append(change.kisao_id)
@@ -385,21 +747,36 @@ def preprocess_sed_task(task, variables, config=None):
     algorithm = Algorithm(kisao_id=exec_kisao_id, changes=changes)
 
     # determine the simulation method and its parameters
-    integrator, time_step = get_integrator(algorithm)
+    integrator, time_step, atol, rtol = get_integrator(algorithm)
     use_lazy_newton_method = 0
     print_amount = 0
 
+    # the model is parsed and prepared once for the executions of the task, which set the values of their changes;
+    # the changes which can not be set are applied to the SBML file by each execution instead
+    if (
+        all(isinstance(change, ModelAttributeChange) for change in model.changes)
+        and get_model_change_setters(model.changes, model_etree) is not None
+    ):
+        prepared_model = libsbmlsim.sbmlsim_model_create_from_file(model.source)
+    else:
+        prepared_model = None
+
     # return preprocessed task
     return {
         'model': {
             'etree': model_etree,
             'xpath_sbml_id_map': xpath_sbml_id_map,
+            'prepared': prepared_model,
         },
         'simulation': {
             'algorithm_kisao_id': exec_kisao_id,
             'integrator': integrator,
             'use_lazy_newton_method': use_lazy_newton_method,
             'time_step': time_step,
+            'atol': atol,
+            'rtol': rtol,
             'print_amount': print_amount,
+            # threads of each simulation (0: number of processors), see :obj:`ParallelTaskExecuter`
+            'num_of_threads': 0,
         },
     }
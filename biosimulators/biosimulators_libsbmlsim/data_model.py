@@ -24,6 +24,7 @@ KISAO_ALGORITHMS_MAP = collections.OrderedDict([
             None: libsbmlsim.MTHD_RUNGE_KUTTA_FEHLBERG_5,
         },
         'uses_print_interval': False,
+        'uses_tolerances': False,
     }),
     ('KISAO_0000030', {
         'id': 'KISAO_0000030',
@@ -32,6 +33,7 @@ KISAO_ALGORITHMS_MAP = collections.OrderedDict([
             None: libsbmlsim.MTHD_EULER,
         },
         'uses_print_interval': True,
+        'uses_tolerances': False,
     }),
     ('KISAO_0000279', {
         'id': 'KISAO_0000279',
@@ -44,6 +46,7 @@ KISAO_ALGORITHMS_MAP = collections.OrderedDict([
             None: libsbmlsim.MTHD_ADAMS_BASHFORTH_4,
         },
         'uses_print_interval': True,
+        'uses_tolerances': False,
     }),
     ('KISAO_0000032', {
         'id': 'KISAO_0000032',
@@ -52,6 +55,7 @@ KISAO_ALGORITHMS_MAP = collections.OrderedDict([
             None: libsbmlsim.MTHD_RUNGE_KUTTA,
         },
         'uses_print_interval': True,
+        'uses_tolerances': False,
     }),
     ('KISAO_0000321', {
         'id': 'KISAO_0000321',
@@ -60,6 +64,16 @@ KISAO_ALGORITHMS_MAP = collections.OrderedDict([
             None: libsbmlsim.MTHD_CASH_KARP,
         },
         'uses_print_interval': False,
+        'uses_tolerances': False,
+    }),
+    ('KISAO_0000087', {
+        'id': 'KISAO_0000087',
+        'name': 'Dormand-Prince method',
+        'orders': {
+            None: libsbmlsim.MTHD_DORMAND_PRINCE,
+        },
+        'uses_print_interval': False,
+        'uses_tolerances': True,
     }),
     ('KISAO_0000031', {
         'id': 'KISAO_0000031',
@@ -68,6 +82,7 @@ KISAO_ALGORITHMS_MAP = collections.OrderedDict([
             None: libsbmlsim.MTHD_BACKWARD_EULER,
         },
         'uses_print_interval': True,
+        'uses_tolerances': False,
     }),
     ('KISAO_0000309', {
         'id': 'KISAO_0000309',
@@ -76,6 +91,7 @@ KISAO_ALGORITHMS_MAP = collections.OrderedDict([
             None: libsbmlsim.MTHD_CRANK_NICOLSON,
         },
         'uses_print_interval': True,
+        'uses_tolerances': False,
     }),
     ('KISAO_0000280', {
         'id': 'KISAO_0000280',
@@ -87,6 +103,7 @@ KISAO_ALGORITHMS_MAP = collections.OrderedDict([
             None: libsbmlsim.MTHD_ADAMS_MOULTON_4,
         },
         'uses_print_interval': True,
+        'uses_tolerances': False,
     }),
     ('KISAO_0000288', {
         'id': 'KISAO_0000288',
@@ -98,6 +115,36 @@ KISAO_ALGORITHMS_MAP = collections.OrderedDict([
             None: libsbmlsim.MTHD_BACKWARD_DIFFERENCE_4,
         },
         'uses_print_interval': True,
+        'uses_tolerances': False,
+    }),
+    ('KISAO_0000094', {
+        'id': 'KISAO_0000094',
+        'name': 'Livermore Solver for Ordinary Differential Equations (LSODE)',
+        'orders': {
+            None: libsbmlsim.MTHD_ADAPTIVE_BACKWARD_DIFFERENCE,
+        },
+        'uses_print_interval': False,
+        'uses_tolerances': True,
+    }),
+    ('KISAO_0000033', {
+        'id': 'KISAO_0000033',
+        'name': 'Rosenbrock method',
+        'orders': {
+            3: libsbmlsim.MTHD_ROSENBROCK_3,
+            4: libsbmlsim.MTHD_ROSENBROCK_4,
+            None: libsbmlsim.MTHD_ROSENBROCK_4,
+        },
+        'uses_print_interval': False,
+        'uses_tolerances': True,
+    }),
+    ('KISAO_0000088', {
+        'id': 'KISAO_0000088',
+        'name': 'Livermore Solver for Ordinary Differential Equations with Automatic method switching for stiff and nonstiff problems (LSODA)',
+        'orders': {
+            None: libsbmlsim.MTHD_AUTO_SWITCHING,
+        },
+        'uses_print_interval': False,
+        'uses_tolerances': True,
     }),
 ])
 
@@ -113,6 +160,8 @@ def get_integrator(algorithm):
 
             :obj:`int`: id of LibSBMLsim integrator
             :obj:`float`: time step
+            :obj:`float`: absolute tolerance (``0.`` for the default of LibSBMLsim)
+            :obj:`float`: relative tolerance (``0.`` for the default of LibSBMLsim)
     """
     method_group = KISAO_ALGORITHMS_MAP.get(algorithm.kisao_id, None)
     if not method_group:
@@ -123,27 +172,34 @@ def get_integrator(algorithm):
         raise NotImplementedError(msg)
     supported_orders = list(method_group['orders'].keys())
     supported_orders.remove(None)
-    order, dt = get_integrator_parameters(algorithm,
-                                          supported_orders=supported_orders)
+    order, dt, atol, rtol = get_integrator_parameters(algorithm,
+                                                      supported_orders=supported_orders,
+                                                      uses_tolerances=method_group['uses_tolerances'])
     method = method_group['orders'][order]
-    return (method, dt)
+    return (method, dt, atol, rtol)
 
 
-def get_integrator_parameters(algorithm, supported_orders=None):
-    """ Get the order and time step of a LiSBMLsim integrator for a SED-ML/KiSAO algorithm
+def get_integrator_parameters(algorithm, supported_orders=None, uses_tolerances=False):
+    """ Get the order, time step and error tolerances of a LiSBMLsim integrator for a SED-ML/KiSAO algorithm
 
     Args:
         algorithm (:obj:`Algorithm`): SED-ML algorithm
         supported_orders (:obj:`list` of :obj:`int`, optional): orders supported by the SED-ML algorithm
+        uses_tolerances (:obj:`bool`, optional): whether the SED-ML algorithm controls its step with
+            absolute and relative error tolerances
 
     Returns:
         :obj:`tuple`:
 
             * :obj:`int`: order
             * :obj:`float`: time step
+            * :obj:`float`: absolute tolerance (``0.`` for the default of LibSBMLsim)
+            * :obj:`float`: relative tolerance (``0.`` for the default of LibSBMLsim)
     """
     order = None
     time_step = None
+    atol = 0.
+    rtol = 0.
     for change in algorithm.changes:
         if supported_orders and change.kisao_id == 'KISAO_0000594':
             try:
@@ -167,8 +223,25 @@ def get_integrator_parameters(algorithm, supported_orders=None):
                 raise ValueError('The time step must be a positive float, not `{}`.'.format(
                     change.new_value))
 
+        elif uses_tolerances and change.kisao_id in ['KISAO_0000211', 'KISAO_0000209']:
+            name = 'absolute' if change.kisao_id == 'KISAO_0000211' else 'relative'
+            try:
+                tolerance = float(change.new_value)
+            except ValueError:
+                raise ValueError('The {} tolerance must be a positive float, not `{}`.'.format(
+                    name, change.new_value))
+
+            if not tolerance > 0:
+                raise ValueError('The {} tolerance must be a positive float, not `{}`.'.format(
+                    name, change.new_value))
+
+            if change.kisao_id == 'KISAO_0000211':
+                atol = tolerance
+            else:
+                rtol = tolerance
+
         else:
             raise NotImplementedError('Algorithm {} does not support parameter {}.'.format(
                 algorithm.kisao_id, change.kisao_id))
 
-    return (order, time_step)
+    return (order, time_step, atol, rtol)
@@ -0,0 +1,78 @@
+""" Reading the binary result files written by ``libsbmlsim.write_binary``
+
+:Date: 2026-10-18
+:License: MIT
+"""
+
+import collections
+import numpy
+import struct
+
+__all__ = [
+    'BinaryResults',
+    'read_binary_results',
+]
+
+MAGIC = b'SBMLSIMB'
+VERSION = 1
+HEADER = struct.Struct('<8sIIQII')
+COLUMN = struct.Struct('<II')
+
+COLUMN_KINDS = ['time', 'species', 'parameter', 'compartment']
+
+BinaryResults = collections.namedtuple('BinaryResults', ['names', 'kinds', 'values'])
+BinaryResults.__doc__ = """ Columns of a binary result file
+
+Attributes:
+    names (:obj:`list` of :obj:`str`): ids of the columns, time first
+    kinds (:obj:`list` of :obj:`str`): kinds of the columns (``time``, ``species``, ``parameter`` or ``compartment``)
+    values (:obj:`numpy.memmap`): read-only values of the columns, one row per column (an empty
+        :obj:`numpy.ndarray` if the result has no rows)
+"""
+
+
+def read_binary_results(filename):
+    """ Map the values of a binary result file in memory
+
+    The values are not read until they are accessed, so that a few columns of a large result can be used without
+    loading the rest.
+
+    Args:
+        filename (:obj:`str`): path to a file written by ``libsbmlsim.write_binary``
+
+    Returns:
+        :obj:`BinaryResults`: names, kinds and values of the columns
+
+    Raises:
+        :obj:`ValueError`: if the file is not a binary result file
+    """
+    with open(filename, 'rb') as file:
+        header = file.read(HEADER.size)
+        if len(header) != HEADER.size:
+            raise ValueError('`{}` is not a binary result file of LibSBMLSim.'.format(filename))
+        magic, version, value_size, num_of_rows, num_of_columns, data_offset = HEADER.unpack(header)
+        if magic != MAGIC or version != VERSION or value_size not in (4, 8):
+            raise ValueError('`{}` is not a binary result file of LibSBMLSim.'.format(filename))
+
+        names = []
+        kinds = []
+        try:
+            for _ in range(num_of_columns):
+                kind, name_length = COLUMN.unpack(file.read(COLUMN.size))
+                name = file.read(name_length)
+                if len(name) != name_length:
+                    raise ValueError('`{}` is not a binary result file of LibSBMLSim.'.format(filename))
+                names.append(name.decode('utf-8'))
+                kinds.append(COLUMN_KINDS[kind])
+        except (struct.error, IndexError):
+            raise ValueError('`{}` is not a binary result file of LibSBMLSim.'.format(filename))
+
+    dtype = '<f{}'.format(value_size)
+    if num_of_rows == 0:
+        # an empty region can not be mapped
+        values = numpy.empty((num_of_columns, 0), dtype=dtype)
+        values.flags.writeable = False
+        return BinaryResults(names, kinds, values)
+
+    values = numpy.memmap(filename, dtype=dtype, mode='r', offset=data_offset, shape=(num_of_columns, num_of_rows))
+    return BinaryResults(names, kinds, values)
@@ -12,11 +12,13 @@ from biosimulators_libsbmlsim.data_model import KISAO_ALGORITHMS_MAP
 from biosimulators_utils.combine import data_model as combine_data_model
 from biosimulators_utils.combine.io import CombineArchiveWriter
 from biosimulators_utils.config import get_config
+from biosimulators_utils.log.data_model import TaskLog
 from biosimulators_utils.sedml.data_model import (
-    SedDocument, Model, ModelLanguage, ModelAttributeChange, UniformTimeCourseSimulation, Task, Variable, Symbol,
-    Algorithm, AlgorithmParameterChange,
+    SedDocument, Model, ModelLanguage, ModelAttributeChange, UniformTimeCourseSimulation, Task, RepeatedTask, SubTask,
+    Variable, Symbol, Algorithm, AlgorithmParameterChange,
     Report, DataGenerator, DataSet)
 from biosimulators_utils.sedml.io import SedmlSimulationWriter
+from biosimulators_utils.sedml.utils import get_variables_for_task
 from biosimulators_utils.report import data_model as report_data_model
 from biosimulators_utils.report.io import ReportReader
 from biosimulators_utils.warnings import BioSimulatorsWarning
@@ -28,6 +30,7 @@ import copy
 import datetime
 import dateutil.tz
 import json
+import lxml.etree
 import os
 import numpy.testing
 import shutil
@@ -171,6 +174,32 @@ class CliTestCase(unittest.TestCase):
                 self.assertEqual(results2['PIP2_PHGFP_PM'].shape, (11,))
                 self.assertFalse(numpy.any(numpy.isnan(results2['PIP2_PHGFP_PM'])))
 
+        # error tolerances
+        task2 = copy.deepcopy(task)
+        task2.simulation.algorithm.kisao_id = 'KISAO_0000087'
+        task2.simulation.algorithm.changes = [
+            AlgorithmParameterChange(kisao_id='KISAO_0000211', new_value='1e-3'),
+            AlgorithmParameterChange(kisao_id='KISAO_0000209', new_value='1e-1'),
+        ]
+        results2, log = core.exec_sed_task(task2, variables)
+        self.assertEqual(log.simulator_details['arguments']['atol'], 1e-3)
+        self.assertEqual(log.simulator_details['arguments']['rtol'], 1e-1)
+        self.assertFalse(numpy.any(numpy.isnan(results2['PIP2_PHGFP_PM'])))
+
+        task2.simulation.algorithm.changes[0].new_value = '1e-12'
+        task2.simulation.algorithm.changes[1].new_value = '1e-10'
+        results3, log = core.exec_sed_task(task2, variables)
+        self.assertEqual(log.simulator_details['arguments']['atol'], 1e-12)
+        self.assertEqual(log.simulator_details['arguments']['rtol'], 1e-10)
+        self.assertFalse(numpy.any(numpy.isnan(results3['PIP2_PHGFP_PM'])))
+        self.assertFalse(numpy.array_equal(results2['PIP2_PHGFP_PM'], results3['PIP2_PHGFP_PM']))
+
+        task2 = copy.deepcopy(task)
+        task2.simulation.algorithm.changes.append(AlgorithmParameterChange(kisao_id='KISAO_0000209', new_value='1e-10'))
+        with mock.patch.dict(os.environ, {'ALGORITHM_SUBSTITUTION_POLICY': 'NONE'}):
+            with self.assertRaisesRegex(NotImplementedError, 'does not support parameter'):
+                core.exec_sed_task(task2, variables)
+
         # error handling
         task2 = copy.deepcopy(task)
         task2.simulation.initial_time = 1.
@@ -231,6 +260,205 @@ class CliTestCase(unittest.TestCase):
         with self.assertRaisesRegex(NotImplementedError, 'unsupported targets'):
             core.exec_sed_task(task, variables2)
 
+    def _build_sed_doc(self, num_of_tasks):
+        doc = SedDocument()
+        report = Report(id='report')
+        doc.outputs.append(report)
+
+        model = Model(id='model', source=os.path.basename(self.FIXTURE), language=ModelLanguage.SBML)
+        doc.models.append(model)
+
+        for i_task in range(num_of_tasks):
+            simulation = UniformTimeCourseSimulation(
+                id='simulation_{}'.format(i_task),
+                initial_time=0.,
+                output_start_time=0.,
+                output_end_time=10. * (i_task + 1),
+                number_of_steps=10,
+                algorithm=Algorithm(kisao_id='KISAO_0000030'),
+            )
+            doc.simulations.append(simulation)
+
+            task = Task(id='task_{}'.format(i_task), model=model, simulation=simulation)
+            doc.tasks.append(task)
+
+            for variable in [
+                Variable(id='time_{}'.format(i_task), symbol=Symbol.time.value, task=task),
+                Variable(id='PIP2_PHGFP_PM_{}'.format(i_task),
+                         target="/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='PIP2_PHGFP_PM']",
+                         target_namespaces=self.NAMESPACES,
+                         task=task),
+            ]:
+                data_gen = DataGenerator(id='data_generator_' + variable.id, variables=[variable], math=variable.id)
+                doc.data_generators.append(data_gen)
+                report.data_sets.append(DataSet(id='data_set_' + variable.id, label=variable.id,
+                                                data_generator=data_gen))
+
+        return doc
+
+    def test_get_num_of_workers(self):
+        with mock.patch.dict(os.environ, {'LIBSBMLSIM_NUM_OF_WORKERS': '3'}):
+            self.assertEqual(core.get_num_of_workers(), 3)
+
+        with mock.patch.dict(os.environ, {'LIBSBMLSIM_NUM_OF_WORKERS': '0'}):
+            with self.assertRaisesRegex(ValueError, 'must be a positive integer'):
+                core.get_num_of_workers()
+
+        with mock.patch.dict(os.environ, {'LIBSBMLSIM_NUM_OF_WORKERS': 'abc'}):
+            with self.assertRaisesRegex(ValueError, 'must be a positive integer'):
+                core.get_num_of_workers()
+
+        env = dict(os.environ)
+        env.pop('LIBSBMLSIM_NUM_OF_WORKERS', None)
+        with mock.patch.dict(os.environ, env, clear=True):
+            self.assertGreaterEqual(core.get_num_of_workers(), 1)
+
+    def test_get_model_change_setters(self):
+        model_etree = lxml.etree.parse(self.FIXTURE)
+
+        def change(target, new_value):
+            return ModelAttributeChange(target=target, target_namespaces=self.NAMESPACES, new_value=new_value)
+
+        setters = core.get_model_change_setters([
+            change("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='PIP2_PHGFP_PM']/@initialConcentration", 1),
+            change("/sbml:sbml/sbml:model/sbml:listOfCompartments/sbml:compartment[@id='Cytosol']/@size", '2'),
+            change("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='KMOLE']/@value", '0.002'),
+            change("/sbml:sbml/sbml:model/sbml:listOfReactions/sbml:reaction[@id='PIP2_hyd']/sbml:kineticLaw"
+                   "/sbml:listOfLocalParameters/sbml:localParameter[@id='k_PIP2hyd']/@value", '3'),
+        ], model_etree)
+        self.assertEqual(setters, [
+            ('setInitialConcentration', ('PIP2_PHGFP_PM', 1.)),
+            ('setValue', ('Cytosol', 2.)),
+            ('setValue', ('KMOLE', 0.002)),
+            ('setLocalParameter', ('PIP2_hyd', 'k_PIP2hyd', 3.)),
+        ])
+
+        # other attributes are applied to the SBML file
+        self.assertEqual(core.get_model_change_setters([
+            change("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='PIP2_PHGFP_PM']/@compartment", 'PM'),
+        ], model_etree), None)
+        self.assertEqual(core.get_model_change_setters([
+            change("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='undefined']/@initialConcentration", 1),
+        ], model_etree), None)
+
+        # the prepared model gives the results of the rewritten SBML file
+        task = self._build_sed_doc(1).tasks[0]
+        task.model.source = self.FIXTURE
+        variables = [Variable(id='PIP2_PHGFP_PM', task=task,
+                              target="/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='PIP2_PHGFP_PM']",
+                              target_namespaces=self.NAMESPACES)]
+        task.model.changes = [
+            change("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='KMOLE']/@value", '0.002'),
+        ]
+        config = get_config()
+        config.LOG = True
+        results, log = core.exec_sed_task(task, variables, config=config)
+        self.assertEqual(log.simulator_details['method'], 'sbmlsim_model.simulate')
+        self.assertEqual(set(log.simulator_details['timing'].keys()), set(['read_sbml', 'prepare', 'simulation']))
+        self.assertGreater(log.simulator_details['timing']['simulation'], 0.)
+        with mock.patch.object(core, 'get_model_change_setters', return_value=None):
+            self.assertEqual(core.preprocess_sed_task(task, variables, config=config)['model']['prepared'], None)
+            expected_results, log = core.exec_sed_task(task, variables, config=config)
+        self.assertEqual(log.simulator_details['method'], 'sbmlsim_model_create_from_file')
+        numpy.testing.assert_allclose(results['PIP2_PHGFP_PM'], expected_results['PIP2_PHGFP_PM'], rtol=1e-12)
+
+        # the size of a compartment and a local parameter, set in the same prepared model one after the other
+        preprocessed_task = core.preprocess_sed_task(task, variables, config=config)
+        for changes in [
+            [change("/sbml:sbml/sbml:model/sbml:listOfCompartments/sbml:compartment[@id='PM']/@size", '0.3')],
+            [change("/sbml:sbml/sbml:model/sbml:listOfReactions/sbml:reaction[@id='PIP2_hyd']/sbml:kineticLaw"
+                    "/sbml:listOfLocalParameters/sbml:localParameter[@id='k_PIP2hyd']/@value", '1.2')],
+            [],
+        ]:
+            task.model.changes = changes
+            results, log = core.exec_sed_task(task, variables, preprocessed_task=preprocessed_task, config=config)
+            self.assertEqual(log.simulator_details['method'], 'sbmlsim_model.simulate')
+            with mock.patch.object(core, 'get_model_change_setters', return_value=None):
+                expected_results, log = core.exec_sed_task(task, variables, config=config)
+            numpy.testing.assert_allclose(results['PIP2_PHGFP_PM'], expected_results['PIP2_PHGFP_PM'], rtol=1e-12)
+
+    def test_get_independent_tasks(self):
+        doc = self._build_sed_doc(3)
+        repeated_task = RepeatedTask(id='repeated_task', sub_tasks=[SubTask(task=doc.tasks[1], order=1)])
+        doc.tasks.append(repeated_task)
+
+        self.assertEqual([task.id for task in core.get_independent_tasks(doc)], ['task_0', 'task_2'])
+
+    def test_exec_sed_doc_parallel(self):
+        doc = self._build_sed_doc(6)
+        doc.tasks[2].model = copy.deepcopy(doc.models[0])
+        doc.tasks[2].model.changes.append(ModelAttributeChange(
+            target="/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='PIP2_PHGFP_PM']/@initialConcentration",
+            target_namespaces=self.NAMESPACES,
+            new_value='1',
+        ))
+        working_dir = os.path.dirname(self.FIXTURE)
+
+        config = get_config()
+        config.REPORT_FORMATS = [report_data_model.ReportFormat.csv]
+        config.COLLECT_COMBINE_ARCHIVE_RESULTS = True
+        config.COLLECT_SED_DOCUMENT_RESULTS = True
+
+        serial_results, serial_log = core.exec_sed_doc(copy.deepcopy(doc), working_dir,
+                                                       os.path.join(self.dirname, 'serial'),
+                                                       config=config, num_of_workers=1)
+        parallel_results, parallel_log = core.exec_sed_doc(copy.deepcopy(doc), working_dir,
+                                                           os.path.join(self.dirname, 'parallel'),
+                                                           config=config, num_of_workers=4)
+
+        self.assertEqual(set(parallel_results['report'].keys()), set(serial_results['report'].keys()))
+        for data_set_id, values in serial_results['report'].items():
+            numpy.testing.assert_array_equal(parallel_results['report'][data_set_id], values)
+        self.assertEqual(parallel_results['report']['data_set_PIP2_PHGFP_PM_2'][0], 1.)
+
+        self.assertEqual(list(parallel_log.tasks.keys()), list(serial_log.tasks.keys()))
+        for task_id, task_log in serial_log.tasks.items():
+            self.assertEqual(parallel_log.tasks[task_id].status, task_log.status)
+            self.assertEqual(parallel_log.tasks[task_id].algorithm, task_log.algorithm)
+            # only the wall times of the phases differ
+            parallel_details = dict(parallel_log.tasks[task_id].simulator_details)
+            serial_details = dict(task_log.simulator_details)
+            parallel_details.pop('timing')
+            serial_details.pop('timing')
+            self.assertEqual(parallel_details, serial_details)
+
+        # the simulations use one thread each, and the tasks are recorded from the arguments of the calls
+        executer = core.ParallelTaskExecuter(doc, working_dir, 2, config=config)
+        try:
+            for _, _, preprocessed_task, _, _ in executer.submitted.values():
+                self.assertEqual(preprocessed_task['simulation']['num_of_threads'], 1)
+
+            task = copy.copy(doc.tasks[0])
+            task.model = copy.copy(task.model)
+            task.model.source = os.path.join(working_dir, task.model.source)
+            variables = get_variables_for_task(doc, doc.tasks[0])
+            expected_results, expected_log = core.exec_sed_task(task, variables, config=config)
+            log = TaskLog()
+            results, returned_log = executer(task, variables, log=log, config=config)
+            self.assertIs(returned_log, log)
+            self.assertEqual(log.algorithm, expected_log.algorithm)
+            numpy.testing.assert_array_equal(results['PIP2_PHGFP_PM_0'], expected_results['PIP2_PHGFP_PM_0'])
+
+            # a task which differs from the submitted one is executed in place
+            task = copy.copy(doc.tasks[1])
+            task.model = copy.copy(task.model)
+            task.model.source = os.path.join(working_dir, task.model.source)
+            task.simulation = copy.deepcopy(task.simulation)
+            task.simulation.output_end_time = 5.
+            variables = get_variables_for_task(doc, doc.tasks[1])
+            self.assertFalse(core.is_same_sed_task(task, variables, *executer.submitted['task_1'][0:2]))
+            results, log = executer(task, variables, config=config)
+            self.assertEqual(log.simulator_details['arguments']['sim_time'], 5.)
+        finally:
+            executer.close()
+
+        # errors are reported at the failing task
+        doc.simulations[3].initial_time = 1.
+        doc.simulations[3].output_start_time = 1.
+        with self.assertRaises(Exception):
+            core.exec_sed_doc(copy.deepcopy(doc), working_dir, os.path.join(self.dirname, 'error'),
+                              config=config, num_of_workers=4)
+
     def test_exec_sedml_docs_in_combine_archive(self):
         archive_dirname = os.path.join(self.dirname, 'archive')
         os.mkdir(archive_dirname)
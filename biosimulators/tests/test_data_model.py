@@ -16,7 +16,7 @@ class DataModelTestCase(unittest.TestCase):
             ],
         )
         self.assertEqual(data_model.get_integrator_parameters(alg, [1, 2, 3, 4]),
-                         (2, 0.01))
+                         (2, 0.01, 0., 0.))
 
         alg.changes[0].new_value = '4.1'
         with self.assertRaisesRegex(ValueError, 'must be an integer between'):
@@ -28,11 +28,11 @@ class DataModelTestCase(unittest.TestCase):
 
         alg.changes = alg.changes[1:]
         self.assertEqual(data_model.get_integrator_parameters(alg, [1, 2, 3, 4]),
-                         (None, 0.01))
+                         (None, 0.01, 0., 0.))
 
         alg.changes = []
         self.assertEqual(data_model.get_integrator_parameters(alg, [1, 2, 3, 4]),
-                         (None, None))
+                         (None, None, 0., 0.))
 
         alg = Algorithm(
             kisao_id='KISAO_0000030',
@@ -41,7 +41,7 @@ class DataModelTestCase(unittest.TestCase):
             ],
         )
         self.assertEqual(data_model.get_integrator_parameters(alg, None),
-                         (None, 0.01))
+                         (None, 0.01, 0., 0.))
 
         alg.changes[0].new_value = 'abc'
         with self.assertRaisesRegex(ValueError, 'must be a positive'):
@@ -56,6 +56,29 @@ class DataModelTestCase(unittest.TestCase):
         with self.assertRaisesRegex(NotImplementedError, 'does not support parameter'):
             data_model.get_integrator_parameters(alg, None)
 
+        alg.changes[0].kisao_id = 'KISAO_0000211'
+        alg.changes[0].new_value = '1e-12'
+        with self.assertRaisesRegex(NotImplementedError, 'does not support parameter'):
+            data_model.get_integrator_parameters(alg, None)
+
+        alg = Algorithm(
+            kisao_id='KISAO_0000087',
+            changes=[
+                AlgorithmParameterChange(kisao_id='KISAO_0000211', new_value='1e-12'),
+                AlgorithmParameterChange(kisao_id='KISAO_0000209', new_value='1e-8'),
+            ],
+        )
+        self.assertEqual(data_model.get_integrator_parameters(alg, None, uses_tolerances=True),
+                         (None, None, 1e-12, 1e-8))
+
+        alg.changes[1].new_value = 'abc'
+        with self.assertRaisesRegex(ValueError, 'relative tolerance must be a positive'):
+            data_model.get_integrator_parameters(alg, None, uses_tolerances=True)
+
+        alg.changes[1].new_value = '0'
+        with self.assertRaisesRegex(ValueError, 'relative tolerance must be a positive'):
+            data_model.get_integrator_parameters(alg, None, uses_tolerances=True)
+
     def test_get_integrator(self):
         alg = Algorithm(
             kisao_id='KISAO_0000279',
@@ -64,28 +87,53 @@ class DataModelTestCase(unittest.TestCase):
                 AlgorithmParameterChange(kisao_id='KISAO_0000483', new_value='0.01'),
             ],
         )
-        self.assertEqual(data_model.get_integrator(alg), (libsbmlsim.MTHD_ADAMS_BASHFORTH_2, 0.01))
+        self.assertEqual(data_model.get_integrator(alg), (libsbmlsim.MTHD_ADAMS_BASHFORTH_2, 0.01, 0., 0.))
 
         alg.changes = alg.changes[1:]
-        self.assertEqual(data_model.get_integrator(alg), (libsbmlsim.MTHD_ADAMS_BASHFORTH_4, 0.01))
+        self.assertEqual(data_model.get_integrator(alg), (libsbmlsim.MTHD_ADAMS_BASHFORTH_4, 0.01, 0., 0.))
 
         alg.changes = []
-        self.assertEqual(data_model.get_integrator(alg), (libsbmlsim.MTHD_ADAMS_BASHFORTH_4, None))
+        self.assertEqual(data_model.get_integrator(alg), (libsbmlsim.MTHD_ADAMS_BASHFORTH_4, None, 0., 0.))
 
         alg.kisao_id = 'KISAO_0000030'
-        self.assertEqual(data_model.get_integrator(alg), (libsbmlsim.MTHD_EULER, None))
+        self.assertEqual(data_model.get_integrator(alg), (libsbmlsim.MTHD_EULER, None, 0., 0.))
 
         for alg_props in data_model.KISAO_ALGORITHMS_MAP.values():
             alg = Algorithm(kisao_id=alg_props['id'])
             alg.changes.append(AlgorithmParameterChange(kisao_id='KISAO_0000483', new_value='0.01'))
-            method, time_step = data_model.get_integrator(alg)
+            method, time_step, atol, rtol = data_model.get_integrator(alg)
             self.assertIsInstance(method, int)
             self.assertEqual(time_step, 0.01)
+            self.assertEqual((atol, rtol), (0., 0.))
 
         alg.kisao_id = 'KISAO_0000086'
         alg.changes.append(AlgorithmParameterChange(kisao_id='KISAO_0000483', new_value='0.01'))
         data_model.get_integrator(alg)
 
+        alg.kisao_id = 'KISAO_0000094'
+        self.assertEqual(data_model.get_integrator(alg), (libsbmlsim.MTHD_ADAPTIVE_BACKWARD_DIFFERENCE, 0.01, 0., 0.))
+
+        alg.kisao_id = 'KISAO_0000087'
+        self.assertEqual(data_model.get_integrator(alg), (libsbmlsim.MTHD_DORMAND_PRINCE, 0.01, 0., 0.))
+
+        alg.kisao_id = 'KISAO_0000033'
+        self.assertEqual(data_model.get_integrator(alg), (libsbmlsim.MTHD_ROSENBROCK_4, 0.01, 0., 0.))
+
+        alg.changes.append(AlgorithmParameterChange(kisao_id='KISAO_0000594', new_value='3'))
+        self.assertEqual(data_model.get_integrator(alg), (libsbmlsim.MTHD_ROSENBROCK_3, 0.01, 0., 0.))
+        alg.changes.pop()
+
+        alg.kisao_id = 'KISAO_0000088'
+        self.assertEqual(data_model.get_integrator(alg), (libsbmlsim.MTHD_AUTO_SWITCHING, 0.01, 0., 0.))
+
+        alg.changes.append(AlgorithmParameterChange(kisao_id='KISAO_0000211', new_value='1e-12'))
+        alg.changes.append(AlgorithmParameterChange(kisao_id='KISAO_0000209', new_value='1e-8'))
+        self.assertEqual(data_model.get_integrator(alg), (libsbmlsim.MTHD_AUTO_SWITCHING, 0.01, 1e-12, 1e-8))
+
+        alg.kisao_id = 'KISAO_0000086'
+        with self.assertRaisesRegex(NotImplementedError, 'does not support parameter'):
+            data_model.get_integrator(alg)
+
         alg.kisao_id = 'KISAO_0000019'
         with self.assertRaisesRegex(NotImplementedError, 'supports the following algorithms'):
             data_model.get_integrator(alg)
@@ -104,6 +152,9 @@ class DataModelTestCase(unittest.TestCase):
             param_kisao_ids.add('KISAO_0000483')
             if len(alg_props['orders']) > 1:
                 param_kisao_ids.add('KISAO_0000594')
+            if alg_props['uses_tolerances']:
+                param_kisao_ids.add('KISAO_0000211')
+                param_kisao_ids.add('KISAO_0000209')
             self.assertEqual(param_kisao_ids,
                              set(param_specs['kisaoId']['id'] for param_specs in alg_specs['parameters']))
 
@@ -122,3 +173,13 @@ class DataModelTestCase(unittest.TestCase):
                     self.assertEqual(param_specs['type'], 'float')
                     self.assertEqual(param_specs['recommendedRange'], None)
                     self.assertEqual(param_specs['value'], None)
+
+                elif param_specs['kisaoId']['id'] == 'KISAO_0000211':
+                    self.assertEqual(param_specs['type'], 'float')
+                    self.assertEqual(param_specs['recommendedRange'], None)
+                    self.assertEqual(float(param_specs['value']), 1e-9)
+
+                elif param_specs['kisaoId']['id'] == 'KISAO_0000209':
+                    self.assertEqual(param_specs['type'], 'float')
+                    self.assertEqual(param_specs['recommendedRange'], None)
+                    self.assertEqual(float(param_specs['value']), 1e-6)
@@ -0,0 +1,121 @@
+""" Tests of the NumPy arrays of the results of simulations
+
+:Date: 2026-10-18
+:License: MIT
+"""
+
+from biosimulators_libsbmlsim.results import HEADER, COLUMN, MAGIC, VERSION, read_binary_results
+import gc
+import libsbmlsim
+import numpy
+import numpy.testing
+import os
+import shutil
+import tempfile
+import unittest
+
+
+class ResultsTestCase(unittest.TestCase):
+    FIXTURE = os.path.join(os.path.dirname(__file__), 'fixtures', 'BIOMD0000000075.xml')
+
+    def setUp(self):
+        self.dirname = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.dirname)
+
+    def simulate(self):
+        return libsbmlsim.simulateSBMLFromFile(self.FIXTURE, 10., 0.01, 10, 0, libsbmlsim.MTHD_RUNGE_KUTTA, 0)
+
+    def test_values(self):
+        result = self.simulate()
+        self.assertFalse(result.isError(), result.getErrorMessage())
+        num_of_rows = result.getNumOfRows()
+
+        time = result.getTimeValues()
+        self.assertEqual(time.shape, (num_of_rows,))
+        self.assertEqual(list(time), [result.getTimeValueAtIndex(row) for row in range(num_of_rows)])
+
+        for values, num_of_columns, get_name, get_value in [
+            (result.getSpeciesValues(), result.getNumOfSpecies(),
+             result.getSpeciesNameAtIndex, result.getSpeciesValueAtIndex),
+            (result.getParameterValues(), result.getNumOfParameters(),
+             result.getParameterNameAtIndex, result.getParameterValueAtIndex),
+            (result.getCompartmentValues(), result.getNumOfCompartments(),
+             result.getCompartmentNameAtIndex, result.getCompartmentValueAtIndex),
+        ]:
+            self.assertEqual(values.shape, (num_of_rows, num_of_columns))
+            self.assertFalse(values.flags.writeable)
+            for column in range(num_of_columns):
+                self.assertEqual(list(values[:, column]),
+                                 [get_value(get_name(column), row) for row in range(num_of_rows)])
+
+    def test_values_outlive_result(self):
+        result = self.simulate()
+        expected = numpy.array(result.getSpeciesValues())
+        values = result.getSpeciesValues()
+        del result
+        gc.collect()
+        numpy.testing.assert_array_equal(values, expected)
+
+    def test_values_of_error(self):
+        result = libsbmlsim.simulateSBMLFromFile('undefined.xml', 10., 0.01, 10, 0, libsbmlsim.MTHD_RUNGE_KUTTA, 0)
+        self.assertTrue(result.isError())
+        with self.assertRaises(ValueError):
+            result.getSpeciesValues()
+
+    def test_binary_results(self):
+        result = self.simulate()
+        filename = os.path.join(self.dirname, 'results.bin')
+        libsbmlsim.write_binary(result, filename, 0)
+
+        results = read_binary_results(filename)
+        self.assertEqual(results.names[0], 'time')
+        self.assertEqual(results.kinds[0], 'time')
+        self.assertEqual(results.values.shape, (len(results.names), result.getNumOfRows()))
+        numpy.testing.assert_array_equal(results.values[0], result.getTimeValues())
+        for kind, values, get_name in [
+            ('species', result.getSpeciesValues(), result.getSpeciesNameAtIndex),
+            ('parameter', result.getParameterValues(), result.getParameterNameAtIndex),
+            ('compartment', result.getCompartmentValues(), result.getCompartmentNameAtIndex),
+        ]:
+            columns = [index for index, column_kind in enumerate(results.kinds) if column_kind == kind]
+            self.assertEqual([results.names[index] for index in columns],
+                             [get_name(column) for column in range(values.shape[1])])
+            numpy.testing.assert_array_equal(results.values[columns].T, values)
+
+        read = libsbmlsim.read_binary(filename)
+        self.assertFalse(read.isError(), read.getErrorMessage())
+        numpy.testing.assert_array_equal(read.getSpeciesValues(), result.getSpeciesValues())
+
+        libsbmlsim.write_binary(result, filename, 1)
+        results = read_binary_results(filename)
+        self.assertEqual(results.values.dtype, numpy.dtype('<f4'))
+        numpy.testing.assert_array_equal(results.values[0], result.getTimeValues().astype(numpy.float32))
+
+    def test_binary_results_without_rows(self):
+        filename = os.path.join(self.dirname, 'results.bin')
+        with open(filename, 'wb') as file:
+            file.write(HEADER.pack(MAGIC, VERSION, 8, 0, 1, 64))
+            file.write(COLUMN.pack(0, 4) + b'time')
+            file.write(b'\0' * (64 - file.tell()))
+
+        results = read_binary_results(filename)
+        self.assertEqual(results.names, ['time'])
+        self.assertEqual(results.values.shape, (1, 0))
+        self.assertEqual(libsbmlsim.read_binary(filename).getNumOfRows(), 0)
+
+    def test_binary_results_of_other_file(self):
+        with self.assertRaises(ValueError):
+            read_binary_results(self.FIXTURE)
+        self.assertTrue(libsbmlsim.read_binary(self.FIXTURE).isError())
+
+    def test_binary_results_with_truncated_header(self):
+        filename = os.path.join(self.dirname, 'results.bin')
+        with open(filename, 'wb') as file:
+            file.write(HEADER.pack(MAGIC, VERSION, 8, 0, 1, 64))
+            file.write(COLUMN.pack(0, 4) + b'ti')
+
+        with self.assertRaises(ValueError):
+            read_binary_results(filename)
+        self.assertTrue(libsbmlsim.read_binary(filename).isError())
@@ -0,0 +1,72 @@
+""" Tests of simulations run concurrently from Python threads
+
+:Date: 2026-10-18
+:License: MIT
+"""
+
+from concurrent.futures import ThreadPoolExecutor
+import libsbmlsim
+import os
+import threading
+import time
+import unittest
+
+
+class ThreadsTestCase(unittest.TestCase):
+    FIXTURE = os.path.join(os.path.dirname(__file__), 'fixtures', 'BIOMD0000000075.xml')
+    NUM_OF_THREADS = 4
+
+    def simulate(self, sim_time=100.):
+        return libsbmlsim.simulateSBMLFromFile(self.FIXTURE, sim_time, 0.001, 1000, 0,
+                                               libsbmlsim.MTHD_RUNGE_KUTTA, 0)
+
+    def get_values(self, result):
+        self.assertFalse(result.isError(), result.getErrorMessage())
+        values = []
+        for index in range(result.getNumOfRows()):
+            values.append(result.getTimeValueAtIndex(index))
+            for column in range(result.getNumOfSpecies()):
+                values.append(result.getSpeciesValueAtIndex(result.getSpeciesNameAtIndex(column), index))
+        return values
+
+    def test_concurrent_simulations(self):
+        expected = self.get_values(self.simulate())
+
+        with ThreadPoolExecutor(max_workers=self.NUM_OF_THREADS) as executor:
+            results = list(executor.map(lambda _: self.simulate(), range(2 * self.NUM_OF_THREADS)))
+
+        for result in results:
+            self.assertEqual(self.get_values(result), expected)
+
+    def test_simulation_releases_gil(self):
+        # pick a simulation time which takes long enough for this thread to run meanwhile
+        sim_time = 100.
+        start = time.perf_counter()
+        self.simulate(sim_time)
+        while time.perf_counter() - start < 0.2 and sim_time < 1e5:
+            sim_time *= 4
+            start = time.perf_counter()
+            self.simulate(sim_time)
+
+        durations = []
+        done = threading.Event()
+
+        def simulate():
+            start = time.perf_counter()
+            self.simulate(sim_time)
+            durations.append(time.perf_counter() - start)
+            done.set()
+
+        # longest time this thread waited for the GIL while the other one simulated
+        thread = threading.Thread(target=simulate)
+        longest_stall = 0.
+        last = time.perf_counter()
+        thread.start()
+        while not done.is_set():
+            now = time.perf_counter()
+            longest_stall = max(longest_stall, now - last)
+            last = now
+        thread.join()
+
+        # with the GIL held, this thread would wait for the whole simulation
+        self.assertLess(longest_stall, durations[0] / 2)
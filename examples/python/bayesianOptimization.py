@@ -32,6 +32,8 @@ def main():
     # SBML model
     modelfile = './simple.xml'
     d = readSBML(modelfile)
+    # the model is prepared once, and simulated with each suggestion
+    model = sbmlsim_model_create_from_file(modelfile)
     # Simulation
     simulation_time = 10
     dt = 0.1
@@ -54,8 +56,10 @@ def main():
     for _ in range(20):
         suggestion = conn.experiments(experiment.id).suggestions().create()
         print _ , "suggestion:" , param_id, "=", suggestion.assignments[param_id]
-        updateParameter(d, param_id, suggestion.assignments[param_id])
-        result = integrate(d, simulation_time, dt)
+        model.setValue(param_id, suggestion.assignments[param_id])
+        result = model.simulate(simulation_time, dt, 1, 0, MTHD_RUNGE_KUTTA, 0)
+        if result.isError():
+            print result.getErrorMessage()
         value = calcError(result, data) * -1
         print "  value =", value
         #value = evaluate_model(suggestion.assignments)
@@ -74,11 +78,6 @@ def main():
         best_assignments = best_assignments_list.data[0].assignments
         print best_assignments
 
-def updateParameter(sbml, parameter_id, new_value):
-    m = sbml.getModel()
-    p = m.getParameter(parameter_id)
-    p.setValue(new_value)
-
 def calcError(result, data):
     error = 0.0
     numOfRows = result.getNumOfRows()
@@ -94,13 +93,6 @@ def calcError(result, data):
 
     return error
 
-def integrate(sbml, simulation_time, dt):
-    result = simulateSBMLFromString(sbml.toSBML(), simulation_time, dt, 1, 0, MTHD_RUNGE_KUTTA, 0)
-    if result.isError():
-        print result.getErrorMessage()
-
-    return result
-
 def debugPrint(result):
     numOfRows = result.getNumOfRows()
     print "numOfRows: " + str(numOfRows)
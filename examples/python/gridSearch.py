@@ -14,7 +14,8 @@
 
 #
 # This script will run a grid search for a given global parameter and
-# calculate error from a given experimental data.
+# calculate error from a given experimental data. The grid points are
+# simulated with the parameter sweep API.
 #
 from libsbml import *
 from libsbmlsim import *
@@ -37,9 +38,21 @@ def main():
     max_value = 1.0
     grid_spacing = 0.05
     grid_points = (max_value - min_value) / grid_spacing + 1
-    for param_value in linspace(min_value, max_value, num=grid_points):
-        updateParameter(d, param_id, param_value)
-        result = integrate(d, simulation_time, dt)
+    param_values = linspace(min_value, max_value, num=grid_points)
+    # all grid points are simulated in parallel (0: use all processors)
+    points = mySweepPoints()
+    index = points.addId(param_id)
+    for param_value in param_values:
+        points.setValue(points.addPoint(), index, param_value)
+    sweep = simulateSBMLFromStringSweep(d.toSBML(), points, simulation_time, dt, 1, 0, MTHD_RUNGE_KUTTA, 0, 0)
+    if sweep.isError():
+        print sweep.getErrorMessage()
+        return
+    for i, param_value in enumerate(param_values):
+        result = sweep.getResult(i)
+        if result.isError():
+            print "Parameter", param_id, "=", param_value, "\t", result.getErrorMessage()
+            continue
         error = calcError(result, data)
         print "Parameter", param_id, "=", param_value, "\tError =", error
 
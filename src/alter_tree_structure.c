@@ -31,6 +31,20 @@ void minus_func(ASTNode_t *node){
   return;
 }
 
+/* find the species named by an AST_NAME node, with the symbol table of
+ * the model being prepared if one is attached */
+Species_t *find_species_of_name(Model_t *m, const char *name){
+  mySymbol *symbol;
+  if(mySymbolTable_current() != NULL){
+    symbol = mySymbolTable_find(mySymbolTable_current(), name);
+    if(symbol == NULL || symbol->species == NULL){
+      return NULL;
+    }
+    return symbol->species->origin;
+  }
+  return Model_getSpeciesById(m, name);
+}
+
 void alter_tree_structure(Model_t *m, ASTNode_t **node_p, ASTNode_t *parent, int child_order, copied_AST *cp_AST){
   ASTNode_t *zero_node;
   ASTNode_t *compartment_node;
@@ -104,36 +118,32 @@ void alter_tree_structure(Model_t *m, ASTNode_t **node_p, ASTNode_t *parent, int
   /* If node is Name (Species, Parameter, etc.) */
   /* !!! CAUTION !!! this part should not be before the recursive call!!! */
   if(ASTNode_getType(node) == AST_NAME) {
-    for(i = 0; i < Model_getNumSpecies(m); i++) {
-      sp = (Species_t*)ListOf_get(Model_getListOfSpecies(m), i);
-      if(strcmp(Species_getId(sp), ASTNode_getName(node)) == 0){
-        if(!Species_getHasOnlySubstanceUnits(sp) && Species_isSetInitialAmount(sp) && Compartment_getSpatialDimensions(Model_getCompartmentById(m, Species_getCompartment(sp))) != 0){/* use val/comp in calculation */
-          divide_node = ASTNode_createWithType(AST_DIVIDE);
-          compartment_node = ASTNode_createWithType(AST_NAME);
-          ASTNode_setName(compartment_node, Compartment_getId(Model_getCompartmentById(m, Species_getCompartment(sp))));
-          ASTNode_addChild(divide_node, node);
-          ASTNode_addChild(divide_node, compartment_node);
-          if(parent != NULL){
-            ASTNode_replaceChild(parent, child_order, divide_node);
-          }else{
-            *node_p = divide_node;
-          }
-          node = *node_p;
-          break;
-        }else if(Species_getHasOnlySubstanceUnits(sp) && Species_isSetInitialConcentration(sp) && Compartment_getSpatialDimensions(Model_getCompartmentById(m, Species_getCompartment(sp))) != 0){/*  use val*comp in calculation */
-          times_node = ASTNode_createWithType(AST_TIMES);
-          compartment_node = ASTNode_createWithType(AST_NAME);
-          ASTNode_setName(compartment_node, Compartment_getId(Model_getCompartmentById(m, Species_getCompartment(sp))));
-          ASTNode_addChild(times_node, node);
-          ASTNode_addChild(times_node, compartment_node);
-          if(parent != NULL){
-            ASTNode_replaceChild(parent, child_order, times_node);
-          }else{
-            *node_p = times_node;
-          }
-          node = *node_p;
-          break;
+    sp = find_species_of_name(m, ASTNode_getName(node));
+    if(sp != NULL){
+      if(!Species_getHasOnlySubstanceUnits(sp) && Species_isSetInitialAmount(sp) && Compartment_getSpatialDimensions(Model_getCompartmentById(m, Species_getCompartment(sp))) != 0){/* use val/comp in calculation */
+        divide_node = ASTNode_createWithType(AST_DIVIDE);
+        compartment_node = ASTNode_createWithType(AST_NAME);
+        ASTNode_setName(compartment_node, Compartment_getId(Model_getCompartmentById(m, Species_getCompartment(sp))));
+        ASTNode_addChild(divide_node, node);
+        ASTNode_addChild(divide_node, compartment_node);
+        if(parent != NULL){
+          ASTNode_replaceChild(parent, child_order, divide_node);
+        }else{
+          *node_p = divide_node;
         }
+        node = *node_p;
+      }else if(Species_getHasOnlySubstanceUnits(sp) && Species_isSetInitialConcentration(sp) && Compartment_getSpatialDimensions(Model_getCompartmentById(m, Species_getCompartment(sp))) != 0){/*  use val*comp in calculation */
+        times_node = ASTNode_createWithType(AST_TIMES);
+        compartment_node = ASTNode_createWithType(AST_NAME);
+        ASTNode_setName(compartment_node, Compartment_getId(Model_getCompartmentById(m, Species_getCompartment(sp))));
+        ASTNode_addChild(times_node, node);
+        ASTNode_addChild(times_node, compartment_node);
+        if(parent != NULL){
+          ASTNode_replaceChild(parent, child_order, times_node);
+        }else{
+          *node_p = times_node;
+        }
+        node = *node_p;
       }
     }
   }
@@ -13,7 +13,18 @@
  * ---------------------------------------------------------------------- -->*/
 #include "libsbmlsim/libsbmlsim.h"
 
-ast_memory_node_t* ast_memory_root_node;
+/* ASTs are registered to the context attached to the calling thread
+ * (see sbmlsim_context_attach()). Without an attached context, they are
+ * kept in a context of the thread until free_all_ast_memory_nodes() */
+static SBMLSIM_THREAD_LOCAL sbmlsim_context default_context;
+
+static sbmlsim_context *ast_memory_context(void) {
+  sbmlsim_context *ctx = sbmlsim_context_current();
+  if (ctx == NULL) {
+    return &default_context;
+  }
+  return ctx;
+}
 
 ast_memory_node_t* create_ast_memory_node(ASTNode_t* ast) {
 #ifdef DEBUG_AST_MEMORY_DEBUG
@@ -30,16 +41,14 @@ void add_ast_memory_node(ASTNode_t* ast, char *file, int line) {
   /* printf("   add_ast_memory_node for (%s:%d) [%p] %s\n", file, line, ast, SBML_formulaToString(ast)); */
   printf("   add_ast_memory_node for (%s:%d) [%p]\n", file, line, ast);
 #endif
-  ast_memory_node_t* current;
-  if (ast_memory_root_node == NULL) {
-    ast_memory_root_node = create_ast_memory_node(ast);
+  sbmlsim_context *ctx = ast_memory_context();
+  ast_memory_node_t* node = create_ast_memory_node(ast);
+  if (ctx->ast_memory_root_node == NULL) {
+    ctx->ast_memory_root_node = node;
   } else {
-    current = ast_memory_root_node;
-    while (current->next != NULL) {
-      current = current->next;
-    }
-    current->next = create_ast_memory_node(ast);
+    ctx->ast_memory_last_node->next = node;
   }
+  ctx->ast_memory_last_node = node;
 }
 
 void remove_ast_memory_node(ASTNode_t* ast) {
@@ -47,35 +56,41 @@ void remove_ast_memory_node(ASTNode_t* ast) {
   /* printf("remove_ast_memory_node for [%p] %s\n", ast, SBML_formulaToString(ast)); */
   printf("remove_ast_memory_node for [%p]\n", ast);
 #endif
-  ast_memory_node_t* tmp_node;
-  ast_memory_node_t* current;
-  if (ast_memory_root_node->ast == ast) {
-    tmp_node = ast_memory_root_node;
-    ast_memory_root_node = ast_memory_root_node->next;
-    ASTNode_free(tmp_node->ast);
-    free(tmp_node);
-    return;
-  }
-  current = ast_memory_root_node;
-  while (current->next != NULL) {
-    if (current->next->ast == ast) {
-      tmp_node = current->next;
-      current->next = tmp_node->next;
-      ASTNode_free(tmp_node->ast);
-      free(tmp_node);
+  sbmlsim_context *ctx = ast_memory_context();
+  ast_memory_node_t* prev = NULL;
+  ast_memory_node_t* current = ctx->ast_memory_root_node;
+  while (current != NULL) {
+    if (current->ast == ast) {
+      if (prev == NULL) {
+        ctx->ast_memory_root_node = current->next;
+      } else {
+        prev->next = current->next;
+      }
+      if (ctx->ast_memory_last_node == current) {
+        ctx->ast_memory_last_node = prev;
+      }
+      ASTNode_free(current->ast);
+      free(current);
       return;
     }
+    prev = current;
     current = current->next;
   }
 }
 
 void free_all_ast_memory_nodes(void) {
-  ast_memory_node_t *current = ast_memory_root_node;
+  sbmlsim_context *ctx = ast_memory_context();
+  ast_memory_node_t *current = ctx->ast_memory_root_node;
   ast_memory_node_t *tmp_node;
   while (current != NULL) {
     tmp_node = current;
     current = tmp_node->next;
-    remove_ast_memory_node(tmp_node->ast);
+#ifdef DEBUG_AST_MEMORY_DEBUG
+    printf("remove_ast_memory_node for [%p]\n", tmp_node->ast);
+#endif
+    ASTNode_free(tmp_node->ast);
+    free(tmp_node);
   }
+  ctx->ast_memory_root_node = NULL;
+  ctx->ast_memory_last_node = NULL;
 }
-
@@ -13,167 +13,317 @@
  * ---------------------------------------------------------------------- -->*/
 #include "libsbmlsim/libsbmlsim.h"
 
-myResult* bifurcation_analysis(Model_t *m, double sim_time, double dt,
-    int print_interval, double time, int order, int print_amount,
-    int use_lazy_method, int is_explicit,
-    unsigned int num_of_species, unsigned int num_of_parameters,
-    unsigned int num_of_compartments, unsigned int num_of_reactions,
-    unsigned int num_of_rules, unsigned int num_of_events,
-    unsigned int num_of_initialAssignments,
-    mySpecies* mySp[], myParameter* myParam[], myCompartment* myComp[],
-    myReaction* myRe[], myRule* myRu[], myEvent* myEv[],
-    myInitialAssignment* myInitAssign[], myAlgebraicEquations* myAlgEq,
-    timeVariantAssignments* timeVarAssign,
-    allocated_memory* mem, copied_AST* cp_AST,
-    myResult* result, myResult* rtn, boolean bif_param_is_local,
-    char* sta_var_id, char* bif_param_id,
-    double bif_param_min, double bif_param_max,
-    double bif_param_stepsize, double transition_time) {
-	unsigned int i, a, b;
-	int j;
-	/* max(min) of steady state */
-	double local_max = 0.0;
-	double local_min = 0.0;
-
-	/* when bifurcation parameter is local*/
-	double bif_param_value = 0.0;
-
-	int sta_var_column = 0;
-	int bif_param_column = 0;
-
-
-	double init_max = 0.0;
-
-	/* print BA result to file*/
-	FILE* BAfp = NULL;
-
-	/*for randam numbers*/
-	dsfmt_t d;
-	dsfmt_init_gen_rand(&d, (unsigned int) my_time(NULL));
-
-
-	/* calculate the maximum of the state variable (to specify the range of initial value[range where the randam number is])*/
-	for (j = 0; j < rtn->num_of_columns_sp; j++) {
-		if (strcmp(sta_var_id, rtn->column_name_sp[j]) == 0) {
-			sta_var_column = j;
-			init_max = search_max(rtn, sta_var_column);
-		}
-	}
-	/* substitute the bifurcation parameter value */
-	for (i = 0; i < num_of_parameters; i++){
-		if (strcmp(bif_param_id, Parameter_getId(myParam[i]->origin)) == 0){
-			myParam[i]->value = bif_param_min;
-			bif_param_column = i;
-		}
-	}
-	if (bif_param_is_local) {
-		for(a = 0; a < Model_getNumReactions(m); a++) {
-			for(b = 0; b < ListOf_size((ListOf_t*)KineticLaw_getListOfParameters(Reaction_getKineticLaw(myRe[a]->origin))); b++){
-				if (strcmp(bif_param_id, Parameter_getId(KineticLaw_getParameter(Reaction_getKineticLaw(myRe[a]->origin), b))) == 0) {
-					free_mySBML_objects(m, mySp, myParam, myComp, myRe, myRu, myEv,
-              myInitAssign, myAlgEq,
-              timeVarAssign, mem, cp_AST);
-					free_myResult(result);
-					/* mySpecies *mySp[num_of_species]; */
-					mySp = (mySpecies**)malloc(sizeof(mySpecies*) * num_of_species);
-					/* myParameter *myParam[num_of_parameters]; */
-					myParam = (myParameter**)malloc(sizeof(myParameter*) * num_of_parameters);
-					/* myCompartment *myComp[num_of_compartments]; */
-					myComp = (myCompartment**)malloc(sizeof(mySpecies*) * num_of_compartments);
-					/* myReaction *myRe[num_of_reactions]; */
-					myRe = (myReaction**)malloc(sizeof(myReaction*) * num_of_reactions);
-					/* myRule *myRu[num_of_rules]; */
-					myRu = (myRule**)malloc(sizeof(myRule*) * num_of_rules);
-					/* myEvent *myEv[num_of_events]; */
-					myEv = (myEvent**)malloc(sizeof(myEvent*) * num_of_events);
-					/* myInitialAssignment *myInitAssign[num_of_initialAssignments]; */
-					myInitAssign = (myInitialAssignment**)malloc(sizeof(myInitialAssignment*) * num_of_initialAssignments);
-					mem = (allocated_memory*)malloc(sizeof(allocated_memory));
-					mem->num_of_allocated_memory = 0;
-					cp_AST = (copied_AST*)malloc(sizeof(copied_AST));
-					cp_AST->num_of_copied_AST = 0;
-					bif_param_value = bif_param_min;
-					create_mySBML_objects_forBA(m, mySp, myParam, myComp, myRe, myRu, myEv,
-              myInitAssign, &myAlgEq, &timeVarAssign,
-              sim_time, dt, &time, mem, cp_AST, bif_param_id, bif_param_value);
-					break;
-				}
-			}
-		}
-	}
-	if (!bif_param_is_local) {
-		if ((BAfp = my_fopen(BAfp, "bifurcation_analysis.csv", "w")) != NULL) {
-			while (myParam[bif_param_column]->value <= bif_param_max) {
-				time = 0.0;
-				mySp[sta_var_column]->value = init_max * dsfmt_genrand_close_open(&d);
-				if (is_explicit == 1) {
-					rtn = simulate_explicit(m, result, mySp, myParam, myComp, myRe, myRu, myEv, myInitAssign, myAlgEq, timeVarAssign, sim_time, dt, print_interval, &time, order, print_amount, mem);
-				}else{
-					rtn = simulate_implicit(m, result, mySp, myParam, myComp, myRe, myRu, myEv, myInitAssign, myAlgEq, timeVarAssign, sim_time, dt, print_interval, &time, order, use_lazy_method, print_amount, mem);
-				}
-				local_max = search_local_max(rtn, sta_var_column, transition_time, sim_time);
-				local_min = search_local_min(rtn, sta_var_column, transition_time, sim_time);
-				if(bif_param_value == bif_param_min) {
-					fprintf(BAfp, "%s,%s,%s\n", bif_param_id, sta_var_id, sta_var_id);
-				}
-				fprintf(BAfp, "%.16g,%.16g,%.16g\n", bif_param_value, local_max, local_min);
-				myParam[bif_param_column]->value += bif_param_stepsize;
-			}
-		}
-	}else{
-		if ((BAfp = my_fopen(BAfp, "bifurcation_analysis.csv", "w")) != NULL) {
-			while (bif_param_value <= bif_param_max) {
-				result = create_myResult(m, mySp, myParam, myComp, sim_time, dt, print_interval);
-				time = 0.0;
-				mySp[sta_var_column]->value = init_max * dsfmt_genrand_close_open(&d);
-				if (is_explicit == 1) {
-					rtn = simulate_explicit(m, result, mySp, myParam, myComp, myRe, myRu, myEv, myInitAssign, myAlgEq, timeVarAssign, sim_time, dt, print_interval, &time, order, print_amount, mem);
-				  }else{
-					rtn = simulate_implicit(m, result, mySp, myParam, myComp, myRe, myRu, myEv, myInitAssign, myAlgEq, timeVarAssign, sim_time, dt, print_interval, &time, order, use_lazy_method, print_amount, mem);
-				}
-				local_max = search_local_max(rtn, sta_var_column, transition_time, sim_time);
-				local_min = search_local_min(rtn, sta_var_column, transition_time, sim_time);
-				if(bif_param_value == bif_param_min) {
-					fprintf(BAfp, "%s,%s,%s\n", bif_param_id, sta_var_id, sta_var_id);
-				  }
-				fprintf(BAfp, "%.16g,%.16g,%.16g\n", bif_param_value, local_max, local_min);
-				free_mySBML_objects(m, mySp, myParam, myComp, myRe, myRu, myEv,
-            myInitAssign, myAlgEq,
-            timeVarAssign, mem, cp_AST);
-				if (bif_param_value + bif_param_stepsize < bif_param_max) {
-					free_myResult(result);
-				}
-				/* mySpecies *mySp[num_of_species]; */
-				mySp = (mySpecies**)malloc(sizeof(mySpecies*) * num_of_species);
-				/* myParameter *myParam[num_of_parameters]; */
-				myParam = (myParameter**)malloc(sizeof(myParameter*) * num_of_parameters);
-				/* myCompartment *myComp[num_of_compartments]; */
-				myComp = (myCompartment**)malloc(sizeof(mySpecies*) * num_of_compartments);
-				/* myReaction *myRe[num_of_reactions]; */
-				myRe = (myReaction**)malloc(sizeof(myReaction*) * num_of_reactions);
-				/* myRule *myRu[num_of_rules]; */
-				myRu = (myRule**)malloc(sizeof(myRule*) * num_of_rules);
-				/* myEvent *myEv[num_of_events]; */
-				myEv = (myEvent**)malloc(sizeof(myEvent*) * num_of_events);
-				/* myInitialAssignment *myInitAssign[num_of_initialAssignments]; */
-				myInitAssign = (myInitialAssignment**)malloc(sizeof(myInitialAssignment*) * num_of_initialAssignments);
-				mem = (allocated_memory*)malloc(sizeof(allocated_memory));
-				mem->num_of_allocated_memory = 0;
-				cp_AST = (copied_AST*)malloc(sizeof(copied_AST));
-				cp_AST->num_of_copied_AST = 0;
-				bif_param_value += bif_param_stepsize;
-				create_mySBML_objects_forBA(m, mySp, myParam, myComp, myRe, myRu, myEv,
-            myInitAssign, &myAlgEq,
-            &timeVarAssign,
-            sim_time, dt, &time, mem, cp_AST, bif_param_id, bif_param_value);
-				if (bif_param_value > bif_param_max) {
-					free_mySBML_objects(m, mySp, myParam, myComp, myRe, myRu, myEv,
-              myInitAssign, myAlgEq,
-              timeVarAssign, mem, cp_AST);
-				}
-			}
-		}
-	}
-	fclose(BAfp);
-	return rtn;
+/* Bifurcation analysis.
+ * Every value of the bifurcation parameter is simulated from a random
+ * initial value of the state variable (between 0 and its maximum in a
+ * simulation with the values in the model), and the local maximum and
+ * minimum after the transition time are recorded. The values are run on
+ * the work-stealing scheduler. As in the parameter sweep, each worker
+ * owns a clone of the document, prepared once as an sbmlsim_model, and
+ * its own context. The value of the parameter is set in the prepared
+ * model, whether it is global or local (in every kinetic law which has
+ * it; the equations of these kinetic laws are then built again for each
+ * value, and the whole model only if one of them is fast or has
+ * delay()). */
+
+/* the initial value of point p is drawn from the stream p of this seed */
+#define BIFURCATION_SEED 0
+
+typedef struct _bifurcation_job {
+  const char *variable_id;
+  const char *parameter_id;
+  double sim_time;
+  double dt;
+  int print_interval;
+  int method;
+  int use_lazy_method;
+  double transition_time;
+  double init_max;
+  myBifurcationResult *result;
+  struct _bifurcation_worker *workers;
+} bifurcation_job;
+
+typedef struct _bifurcation_worker {
+  SBMLDocument_t *d;
+  Model_t *m;
+  sbmlsim_model *model;
+  sbmlsim_context *ctx;
+} bifurcation_worker;
+
+/* count the global parameter, or the local parameters (of all kinetic
+ * laws) whose id is id */
+static unsigned int count_bifurcation_parameters(Model_t *m, const char *id) {
+  KineticLaw_t *kl;
+  unsigned int i, j, n = 0;
+
+  if (Model_getParameterById(m, id) != NULL)
+    return 1;
+  for (i = 0; i < Model_getNumReactions(m); i++) {
+    kl = Reaction_getKineticLaw(Model_getReaction(m, i));
+    if (kl == NULL)
+      continue;
+    for (j = 0; j < KineticLaw_getNumParameters(kl); j++) {
+      if (strcmp(id, Parameter_getId(KineticLaw_getParameter(kl, j))) == 0)
+        n++;
+    }
+  }
+  return n;
+}
+
+/* set the value of the global parameter id, or of the local parameters
+ * id of all kinetic laws */
+static void set_bifurcation_parameter(sbmlsim_model *model, const char *id, double value) {
+  Reaction_t *r;
+  unsigned int i;
+
+  if (sbmlsim_model_set_value(model, id, value))
+    return;
+  for (i = 0; i < Model_getNumReactions(model->m); i++) {
+    r = Model_getReaction(model->m, i);
+    sbmlsim_model_set_local_parameter(model, Reaction_getId(r), id, value);
+  }
+}
+
+static int find_species_column(myResult *res, const char *id) {
+  int i;
+
+  for (i = 0; i < res->num_of_columns_sp; i++) {
+    if (strcmp(id, res->column_name_sp[i]) == 0)
+      return i;
+  }
+  return -1;
+}
+
+/* sbmlsim_task_func of the scheduler, task is the index of the value */
+static void run_bifurcation_point(void *arg, int point, int worker_index) {
+  bifurcation_job *job = (bifurcation_job *)arg;
+  bifurcation_worker *worker = &job->workers[worker_index];
+  myBifurcationResult *result = job->result;
+  myResult *res;
+  int column;
+
+  set_bifurcation_parameter(worker->model, job->parameter_id, result->parameter_values[point]);
+  /* each point has its own stream, so that the initial value does not
+   * depend on the number of threads */
+  sbmlsim_context_seed_stream(worker->ctx, BIFURCATION_SEED, (unsigned int)point);
+  sbmlsim_model_set_value(worker->model, job->variable_id, job->init_max * sbmlsim_context_random(worker->ctx));
+  res = sbmlsim_model_run(worker->model, worker->ctx, job->sim_time,
+      job->dt, job->print_interval, 0, job->method, job->use_lazy_method,
+      0.0, 0.0, 0.0);
+  if (res == NULL) {
+    result->point_error_codes[point] = SimulationFailed;
+    return;
+  }
+  column = find_species_column(res, result->variable_id);
+  if (res->error_code != NoError || column < 0) {
+    result->point_error_codes[point] = (res->error_code != NoError) ? res->error_code : SimulationFailed;
+  } else {
+    result->local_max[point] = search_local_max(res, column, job->transition_time, job->sim_time);
+    result->local_min[point] = search_local_min(res, column, job->transition_time, job->sim_time);
+  }
+  free_myResult(res);
+}
+
+static myBifurcationResult *create_myBifurcationResult_with_errorCode(LibsbmlsimErrorCode code, const char *message) {
+  myBifurcationResult *result = (myBifurcationResult *)malloc(sizeof(myBifurcationResult));
+  myResult *res = NULL;
+
+  if (message == NULL) {
+    /* share the default error messages with myResult */
+    res = create_myResult_with_errorCode(code);
+    message = res->error_message;
+  }
+  result->error_code = code;
+  result->error_message = (code == NoError) ? NULL : dupstr(message);
+  result->variable_id = NULL;
+  result->parameter_id = NULL;
+  result->num_of_points = 0;
+  result->parameter_values = NULL;
+  result->local_max = NULL;
+  result->local_min = NULL;
+  result->point_error_codes = NULL;
+  result->num_of_threads = 0;
+  result->elapsed_time = 0;
+  if (res != NULL)
+    free_myResult(res);
+  return result;
+}
+
+SBMLSIM_EXPORT myBifurcationResult* analyzeBifurcationSBMLModel(Model_t *m,
+    const char *sta_var_id, const char *bif_param_id,
+    double bif_param_min, double bif_param_max, double bif_param_stepsize,
+    double transition_time, double sim_time, double dt, int print_interval,
+    int method, int use_lazy_method, int num_of_threads) {
+  bifurcation_job job;
+  bifurcation_worker *workers;
+  myBifurcationResult *result;
+  SBMLDocument_t *d;
+  sbmlsim_context *ctx;
+  myResult *res;
+  double start_time;
+  int num_of_points, num_of_workers, column;
+  int i;
+
+  if (m == NULL || sta_var_id == NULL || bif_param_id == NULL
+      || !(bif_param_stepsize > 0) || !(bif_param_min <= bif_param_max)
+      || !(transition_time >= 0 && transition_time < sim_time)) {
+    return create_myBifurcationResult_with_errorCode(InvalidArgument, NULL);
+  }
+  if (Model_getSpeciesById(m, sta_var_id) == NULL) {
+    return create_myBifurcationResult_with_errorCode(InvalidArgument, "Unknown Species ID");
+  }
+  if (count_bifurcation_parameters(m, bif_param_id) == 0) {
+    return create_myBifurcationResult_with_errorCode(InvalidArgument, "Unknown Parameter ID");
+  }
+  d = (SBMLDocument_t *)SBase_getSBMLDocument((SBase_t *)m);
+  if (d == NULL) {
+    return create_myBifurcationResult_with_errorCode(InvalidArgument, NULL);
+  }
+  start_time = sbmlsim_wall_time();
+
+  /* range of the initial value of the state variable */
+  ctx = sbmlsim_context_create(0);
+  res = simulateSBMLModelWithContext(ctx, m, sim_time, dt, print_interval, 0,
+      method, use_lazy_method, 0.0, 0.0, 0.0);
+  sbmlsim_context_free(ctx);
+  if (res == NULL) {
+    return create_myBifurcationResult_with_errorCode(SimulationFailed, NULL);
+  }
+  if (res->error_code != NoError || (column = find_species_column(res, sta_var_id)) < 0) {
+    result = create_myBifurcationResult_with_errorCode(
+        (res->error_code != NoError) ? res->error_code : SimulationFailed, NULL);
+    free_myResult(res);
+    return result;
+  }
+  job.init_max = search_max(res, column);
+  free_myResult(res);
+
+  /* a small tolerance, so that bif_param_max is included as in
+   * bif_param_min + k * bif_param_stepsize <= bif_param_max */
+  num_of_points = (int)floor((bif_param_max - bif_param_min) / bif_param_stepsize * (1 + 1e-12)) + 1;
+  result = create_myBifurcationResult_with_errorCode(NoError, NULL);
+  result->variable_id = dupstr(sta_var_id);
+  result->parameter_id = dupstr(bif_param_id);
+  result->num_of_points = num_of_points;
+  result->parameter_values = (double *)malloc(sizeof(double) * num_of_points);
+  result->local_max = (double *)malloc(sizeof(double) * num_of_points);
+  result->local_min = (double *)malloc(sizeof(double) * num_of_points);
+  result->point_error_codes = (LibsbmlsimErrorCode *)malloc(sizeof(LibsbmlsimErrorCode) * num_of_points);
+  for (i = 0; i < num_of_points; i++) {
+    result->parameter_values[i] = bif_param_min + i * bif_param_stepsize;
+    result->local_max[i] = my_nan();
+    result->local_min[i] = my_nan();
+    result->point_error_codes[i] = NoError;
+  }
+
+  job.variable_id = sta_var_id;
+  job.parameter_id = bif_param_id;
+  job.sim_time = sim_time;
+  job.dt = dt;
+  job.print_interval = print_interval;
+  job.method = method;
+  job.use_lazy_method = use_lazy_method;
+  job.transition_time = transition_time;
+  job.result = result;
+
+  /* clone the documents here, libSBML objects are not thread safe */
+  num_of_workers = sbmlsim_num_of_workers(num_of_threads, num_of_points);
+  workers = (bifurcation_worker *)malloc(sizeof(bifurcation_worker) * num_of_workers);
+  job.workers = workers;
+  for (i = 0; i < num_of_workers; i++) {
+    workers[i].d = SBMLDocument_clone(d);
+    workers[i].m = SBMLDocument_getModel(workers[i].d);
+    workers[i].model = sbmlsim_model_create(workers[i].m);
+    workers[i].ctx = sbmlsim_context_create(0);
+    /* the points are already run in parallel */
+    sbmlsim_context_set_num_of_threads(workers[i].ctx, 1);
+  }
+  sbmlsim_run_tasks(num_of_points, NULL, num_of_workers,
+      run_bifurcation_point, &job, NULL);
+  for (i = 0; i < num_of_workers; i++) {
+    sbmlsim_model_free(workers[i].model);
+    sbmlsim_context_free(workers[i].ctx);
+    SBMLDocument_free(workers[i].d);
+  }
+  free(workers);
+
+  result->num_of_threads = num_of_workers;
+  result->elapsed_time = sbmlsim_wall_time() - start_time;
+  return result;
+}
+
+SBMLSIM_EXPORT myBifurcationResult* analyzeBifurcationSBMLFromFile(const char *file,
+    const char *sta_var_id, const char *bif_param_id,
+    double bif_param_min, double bif_param_max, double bif_param_stepsize,
+    double transition_time, double sim_time, double dt, int print_interval,
+    int method, int use_lazy_method, int num_of_threads) {
+  SBMLDocument_t *d;
+  myBifurcationResult *rtn;
+  LibsbmlsimErrorCode err_code;
+
+  d = readSBMLFromFile(file);
+  if (d == NULL)
+    return create_myBifurcationResult_with_errorCode(Unknown, NULL);
+  err_code = get_SBMLDocument_errorCode(d);
+  if (err_code == NoError) {
+    rtn = analyzeBifurcationSBMLModel(SBMLDocument_getModel(d), sta_var_id,
+        bif_param_id, bif_param_min, bif_param_max, bif_param_stepsize,
+        transition_time, sim_time, dt, print_interval, method, use_lazy_method,
+        num_of_threads);
+  } else {
+    rtn = create_myBifurcationResult_with_errorCode(err_code, NULL);
+  }
+  SBMLDocument_free(d);
+  return rtn;
+}
+
+SBMLSIM_EXPORT myBifurcationResult* analyzeBifurcationSBMLFromString(const char *str,
+    const char *sta_var_id, const char *bif_param_id,
+    double bif_param_min, double bif_param_max, double bif_param_stepsize,
+    double transition_time, double sim_time, double dt, int print_interval,
+    int method, int use_lazy_method, int num_of_threads) {
+  SBMLDocument_t *d;
+  myBifurcationResult *rtn;
+  LibsbmlsimErrorCode err_code;
+
+  d = readSBMLFromString(str);
+  if (d == NULL)
+    return create_myBifurcationResult_with_errorCode(Unknown, NULL);
+  err_code = get_SBMLDocument_errorCode(d);
+  if (err_code == NoError) {
+    rtn = analyzeBifurcationSBMLModel(SBMLDocument_getModel(d), sta_var_id,
+        bif_param_id, bif_param_min, bif_param_max, bif_param_stepsize,
+        transition_time, sim_time, dt, print_interval, method, use_lazy_method,
+        num_of_threads);
+  } else {
+    rtn = create_myBifurcationResult_with_errorCode(err_code, NULL);
+  }
+  SBMLDocument_free(d);
+  return rtn;
+}
+
+SBMLSIM_EXPORT int myBifurcationResult_isError(myBifurcationResult *result) {
+  if (result->error_code == NoError)
+    return 0;
+  return 1;
+}
+
+SBMLSIM_EXPORT const char *myBifurcationResult_getErrorMessage(myBifurcationResult *result) {
+  return result->error_message;
+}
+
+SBMLSIM_EXPORT void free_myBifurcationResult(myBifurcationResult *result) {
+  if (result == NULL)
+    return;
+  if (result->error_message != NULL)
+    free((void *)result->error_message);
+  if (result->variable_id != NULL)
+    free((void *)result->variable_id);
+  if (result->parameter_id != NULL)
+    free((void *)result->parameter_id);
+  free(result->parameter_values);
+  free(result->local_max);
+  free(result->local_min);
+  free(result->point_error_codes);
+  free(result);
 }
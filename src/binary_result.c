@@ -0,0 +1,311 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "libsbmlsim/libsbmlsim.h"
+#include <limits.h>
+
+/*
+ * Binary result file, little endian:
+ *   "SBMLSIMB"                        magic (8 bytes)
+ *   uint32 version                    BINARY_RESULT_VERSION
+ *   uint32 value_size                 8 (float64) or 4 (float32)
+ *   uint64 num_of_rows
+ *   uint32 num_of_columns             time, species, parameters, compartments
+ *   uint32 data_offset                multiple of BINARY_RESULT_ALIGNMENT
+ *   num_of_columns x {
+ *     uint32 kind                     BINARY_COLUMN_*
+ *     uint32 name_length
+ *     char name[name_length]          not terminated
+ *   }
+ *   zeros up to data_offset
+ *   num_of_columns x num_of_rows values, column by column
+ * so that the values can be mapped in memory as an array of
+ * num_of_columns x num_of_rows values from data_offset.
+ */
+#define BINARY_RESULT_MAGIC "SBMLSIMB"
+#define BINARY_RESULT_VERSION 1
+#define BINARY_RESULT_ALIGNMENT 64
+#define BINARY_RESULT_HEADER_SIZE 32
+
+#define BINARY_COLUMN_TIME 0
+#define BINARY_COLUMN_SPECIES 1
+#define BINARY_COLUMN_PARAMETER 2
+#define BINARY_COLUMN_COMPARTMENT 3
+
+/* number of values written by one fwrite() */
+#define BINARY_RESULT_BLOCK 8192
+
+static void put_u32(unsigned char *p, uint32_t v) {
+  p[0] = (unsigned char)v;
+  p[1] = (unsigned char)(v >> 8);
+  p[2] = (unsigned char)(v >> 16);
+  p[3] = (unsigned char)(v >> 24);
+}
+
+static void put_u64(unsigned char *p, uint64_t v) {
+  put_u32(p, (uint32_t)v);
+  put_u32(p + 4, (uint32_t)(v >> 32));
+}
+
+static uint32_t get_u32(const unsigned char *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_u64(const unsigned char *p) {
+  return (uint64_t)get_u32(p) | ((uint64_t)get_u32(p + 4) << 32);
+}
+
+static void put_double(unsigned char *p, double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(double));
+  put_u64(p, bits);
+}
+
+static void put_float(unsigned char *p, double value) {
+  float f = (float)value;
+  uint32_t bits;
+  memcpy(&bits, &f, sizeof(float));
+  put_u32(p, bits);
+}
+
+static double get_double(const unsigned char *p) {
+  uint64_t bits = get_u64(p);
+  double value;
+  memcpy(&value, &bits, sizeof(double));
+  return value;
+}
+
+static double get_float(const unsigned char *p) {
+  uint32_t bits = get_u32(p);
+  float f;
+  memcpy(&f, &bits, sizeof(float));
+  return f;
+}
+
+static void write_column_name(FILE *fp, uint32_t kind, const char *name) {
+  unsigned char buf[8];
+  size_t length = strlen(name);
+
+  put_u32(buf, kind);
+  put_u32(buf + 4, (uint32_t)length);
+  fwrite(buf, 1, 8, fp);
+  fwrite(name, 1, length, fp);
+}
+
+/* write column of a table of num_of_rows x num_of_columns values */
+static void write_column(FILE *fp, unsigned char *buf, const double *table,
+    int num_of_rows, int num_of_columns, int column, int value_size) {
+  int i, n = 0;
+
+  for (i = 0; i < num_of_rows; i++) {
+    if (value_size == 8)
+      put_double(buf + n * 8, table[(size_t)i * num_of_columns + column]);
+    else
+      put_float(buf + n * 4, table[(size_t)i * num_of_columns + column]);
+    if (++n == BINARY_RESULT_BLOCK) {
+      fwrite(buf, value_size, n, fp);
+      n = 0;
+    }
+  }
+  if (n > 0)
+    fwrite(buf, value_size, n, fp);
+}
+
+SBMLSIM_EXPORT void write_binary(myResult* result, const char* file, int use_float32) {
+  FILE *fp = NULL;
+  unsigned char header[BINARY_RESULT_HEADER_SIZE];
+  unsigned char *buf;
+  int value_size = use_float32 ? 4 : 8;
+  int num_of_columns = 1 + result->num_of_columns_sp + result->num_of_columns_param + result->num_of_columns_comp;
+  size_t offset;
+  int i;
+
+  if ((fp = my_fopen(fp, file, "wb")) == NULL)
+    return;
+  offset = BINARY_RESULT_HEADER_SIZE + 8 + strlen(result->column_name_time);
+  for (i = 0; i < result->num_of_columns_sp; i++)
+    offset += 8 + strlen(result->column_name_sp[i]);
+  for (i = 0; i < result->num_of_columns_param; i++)
+    offset += 8 + strlen(result->column_name_param[i]);
+  for (i = 0; i < result->num_of_columns_comp; i++)
+    offset += 8 + strlen(result->column_name_comp[i]);
+  offset = (offset + BINARY_RESULT_ALIGNMENT - 1) / BINARY_RESULT_ALIGNMENT * BINARY_RESULT_ALIGNMENT;
+
+  memcpy(header, BINARY_RESULT_MAGIC, 8);
+  put_u32(header + 8, BINARY_RESULT_VERSION);
+  put_u32(header + 12, (uint32_t)value_size);
+  put_u64(header + 16, (uint64_t)result->num_of_rows);
+  put_u32(header + 24, (uint32_t)num_of_columns);
+  put_u32(header + 28, (uint32_t)offset);
+  fwrite(header, 1, BINARY_RESULT_HEADER_SIZE, fp);
+  write_column_name(fp, BINARY_COLUMN_TIME, result->column_name_time);
+  for (i = 0; i < result->num_of_columns_sp; i++)
+    write_column_name(fp, BINARY_COLUMN_SPECIES, result->column_name_sp[i]);
+  for (i = 0; i < result->num_of_columns_param; i++)
+    write_column_name(fp, BINARY_COLUMN_PARAMETER, result->column_name_param[i]);
+  for (i = 0; i < result->num_of_columns_comp; i++)
+    write_column_name(fp, BINARY_COLUMN_COMPARTMENT, result->column_name_comp[i]);
+  while ((size_t)ftell(fp) < offset)
+    fputc(0, fp);
+
+  buf = (unsigned char *)malloc(BINARY_RESULT_BLOCK * 8);
+  if (buf == NULL) {
+    fclose(fp);
+    return;
+  }
+  write_column(fp, buf, result->values_time, result->num_of_rows, 1, 0, value_size);
+  for (i = 0; i < result->num_of_columns_sp; i++)
+    write_column(fp, buf, result->values_sp, result->num_of_rows, result->num_of_columns_sp, i, value_size);
+  for (i = 0; i < result->num_of_columns_param; i++)
+    write_column(fp, buf, result->values_param, result->num_of_rows, result->num_of_columns_param, i, value_size);
+  for (i = 0; i < result->num_of_columns_comp; i++)
+    write_column(fp, buf, result->values_comp, result->num_of_rows, result->num_of_columns_comp, i, value_size);
+  free(buf);
+  fclose(fp);
+}
+
+/* read column of a table of num_of_rows x num_of_columns values */
+static int read_column(FILE *fp, unsigned char *buf, double *table,
+    int num_of_rows, int num_of_columns, int column, int value_size) {
+  int i = 0, j, n;
+
+  while (i < num_of_rows) {
+    n = num_of_rows - i;
+    if (n > BINARY_RESULT_BLOCK)
+      n = BINARY_RESULT_BLOCK;
+    if (fread(buf, value_size, n, fp) != (size_t)n)
+      return 0;
+    for (j = 0; j < n; j++, i++) {
+      if (value_size == 8)
+        table[(size_t)i * num_of_columns + column] = get_double(buf + j * 8);
+      else
+        table[(size_t)i * num_of_columns + column] = get_float(buf + j * 4);
+    }
+  }
+  return 1;
+}
+
+static myResult *invalid_binary_result(FILE *fp, myResult *result) {
+  fclose(fp);
+  if (result != NULL)
+    free_myResult(result);
+  return create_myResult_with_error(InvalidArgument, "Not a binary result file of libSBMLSim");
+}
+
+static myResult *binary_result_out_of_memory(FILE *fp, myResult *result) {
+  fclose(fp);
+  free_myResult(result);
+  return create_myResult_with_errorCode(OutOfMemory);
+}
+
+SBMLSIM_EXPORT myResult *read_binary(const char* file) {
+  FILE *fp = NULL;
+  unsigned char header[BINARY_RESULT_HEADER_SIZE];
+  unsigned char *buf;
+  uint32_t value_size, num_of_columns, data_offset, kind, prev_kind, length;
+  uint64_t num_of_rows;
+  long file_size;
+  myResult *result;
+  char *name;
+  int ok;
+  uint32_t i;
+  int column;
+
+  if ((fp = my_fopen(fp, file, "rb")) == NULL)
+    return create_myResult_with_errorCode(FileNotFound);
+  if (fread(header, 1, BINARY_RESULT_HEADER_SIZE, fp) != BINARY_RESULT_HEADER_SIZE
+      || memcmp(header, BINARY_RESULT_MAGIC, 8) != 0
+      || get_u32(header + 8) != BINARY_RESULT_VERSION)
+    return invalid_binary_result(fp, NULL);
+  value_size = get_u32(header + 12);
+  num_of_rows = get_u64(header + 16);
+  num_of_columns = get_u32(header + 24);
+  data_offset = get_u32(header + 28);
+  if (fseek(fp, 0, SEEK_END) != 0 || (file_size = ftell(fp)) < 0
+      || fseek(fp, BINARY_RESULT_HEADER_SIZE, SEEK_SET) != 0)
+    return invalid_binary_result(fp, NULL);
+  /* the columns (at least 8 bytes each) are described before data_offset,
+   * and their values follow it in the file */
+  if ((value_size != 8 && value_size != 4) || num_of_columns == 0
+      || data_offset < BINARY_RESULT_HEADER_SIZE
+      || num_of_columns > (data_offset - BINARY_RESULT_HEADER_SIZE) / 8
+      || (uint64_t)data_offset > (uint64_t)file_size || num_of_rows > INT_MAX
+      || num_of_rows * num_of_columns * value_size > (uint64_t)file_size - data_offset)
+    return invalid_binary_result(fp, NULL);
+
+  result = create_myResult_with_error(NoError, NULL);
+  result->num_of_rows = (int)num_of_rows;
+  result->column_name_sp = (const char **)malloc(sizeof(char *) * num_of_columns);
+  result->column_name_param = (const char **)malloc(sizeof(char *) * num_of_columns);
+  result->column_name_comp = (const char **)malloc(sizeof(char *) * num_of_columns);
+  if (result->column_name_sp == NULL || result->column_name_param == NULL
+      || result->column_name_comp == NULL)
+    return binary_result_out_of_memory(fp, result);
+  prev_kind = BINARY_COLUMN_TIME;
+  for (i = 0; i < num_of_columns; i++) {
+    if (fread(header, 1, 8, fp) != 8)
+      return invalid_binary_result(fp, result);
+    kind = get_u32(header);
+    length = get_u32(header + 4);
+    /* time first, then the species, the parameters and the compartments */
+    if (length > data_offset || (i == 0) != (kind == BINARY_COLUMN_TIME) || kind < prev_kind)
+      return invalid_binary_result(fp, result);
+    prev_kind = kind;
+    name = (char *)malloc(length + 1);
+    if (name == NULL)
+      return binary_result_out_of_memory(fp, result);
+    if (fread(name, 1, length, fp) != length) {
+      free(name);
+      return invalid_binary_result(fp, result);
+    }
+    name[length] = '\0';
+    if (kind == BINARY_COLUMN_TIME) {
+      result->column_name_time = name;
+    } else if (kind == BINARY_COLUMN_SPECIES) {
+      result->column_name_sp[result->num_of_columns_sp++] = name;
+    } else if (kind == BINARY_COLUMN_PARAMETER) {
+      result->column_name_param[result->num_of_columns_param++] = name;
+    } else if (kind == BINARY_COLUMN_COMPARTMENT) {
+      result->column_name_comp[result->num_of_columns_comp++] = name;
+    } else {
+      free(name);
+      return invalid_binary_result(fp, result);
+    }
+  }
+  if ((uint32_t)ftell(fp) > data_offset || fseek(fp, (long)data_offset, SEEK_SET) != 0)
+    return invalid_binary_result(fp, result);
+
+  /* the columns are written by kind, time first */
+  result->values_time = (double *)malloc(sizeof(double) * (result->num_of_rows + 1));
+  result->values_sp = (double *)malloc(sizeof(double) * ((size_t)result->num_of_rows * result->num_of_columns_sp + 1));
+  result->values_param = (double *)malloc(sizeof(double) * ((size_t)result->num_of_rows * result->num_of_columns_param + 1));
+  result->values_comp = (double *)malloc(sizeof(double) * ((size_t)result->num_of_rows * result->num_of_columns_comp + 1));
+  buf = (unsigned char *)malloc(BINARY_RESULT_BLOCK * 8);
+  if (result->values_time == NULL || result->values_sp == NULL
+      || result->values_param == NULL || result->values_comp == NULL || buf == NULL) {
+    free(buf);
+    return binary_result_out_of_memory(fp, result);
+  }
+  ok = read_column(fp, buf, result->values_time, result->num_of_rows, 1, 0, (int)value_size);
+  for (column = 0; ok && column < result->num_of_columns_sp; column++)
+    ok = read_column(fp, buf, result->values_sp, result->num_of_rows, result->num_of_columns_sp, column, (int)value_size);
+  for (column = 0; ok && column < result->num_of_columns_param; column++)
+    ok = read_column(fp, buf, result->values_param, result->num_of_rows, result->num_of_columns_param, column, (int)value_size);
+  for (column = 0; ok && column < result->num_of_columns_comp; column++)
+    ok = read_column(fp, buf, result->values_comp, result->num_of_rows, result->num_of_columns_comp, column, (int)value_size);
+  free(buf);
+  if (!ok)
+    return invalid_binary_result(fp, result);
+  fclose(fp);
+  return result;
+}
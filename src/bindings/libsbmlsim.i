@@ -21,9 +21,80 @@ extern myResult* simulateSBMLFromString(const char *str, double sim_time, double
 extern void print_result(myResult* result);
 extern void write_result(myResult* result, char* file);
 extern void write_csv(myResult* result, char* file);
+extern void write_tsv(myResult* result, char* file);
+extern void write_binary(myResult* result, char* file, int use_float32);
 extern void write_separate_result(myResult* result, char* file_s, char* file_p, char* file_c);
+extern myResult* read_binary(char* file);
 extern void __free_myResult(myResult *result);
+#include "../../src/libsbmlsim/mySweep.h"
+extern mySweepPoints *create_mySweepPoints(void);
+extern void free_mySweepPoints(mySweepPoints *points);
+extern int mySweepPoints_addId(mySweepPoints *points, const char *id);
+extern int mySweepPoints_addPoint(mySweepPoints *points);
+extern int mySweepPoints_setValue(mySweepPoints *points, int point, int index, double value);
+extern double mySweepPoints_getValue(mySweepPoints *points, int point, int index);
+extern int mySweepPoints_setCost(mySweepPoints *points, int point, double cost);
+extern void mySweepPoints_setSeed(mySweepPoints *points, unsigned int seed);
+extern int mySweepPoints_setCostsFromResult(mySweepPoints *points, mySweepResult *result);
+extern double mySweepResult_getWorkerUtilization(mySweepResult *result, int worker);
+extern mySweepResult* simulateSBMLFromFileSweep(const char *file, mySweepPoints *points, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method, int num_of_threads);
+extern mySweepResult* simulateSBMLFromStringSweep(const char *str, mySweepPoints *points, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method, int num_of_threads);
+extern myResult *mySweepResult_getResult(mySweepResult *result, int point);
+extern void free_mySweepResult(mySweepResult *result);
+#include "../../src/libsbmlsim/myBifurcation.h"
+extern myBifurcationResult* analyzeBifurcationSBMLFromFile(const char *file, const char *sta_var_id, const char *bif_param_id, double bif_param_min, double bif_param_max, double bif_param_stepsize, double transition_time, double sim_time, double dt, int print_interval, int method, int use_lazy_method, int num_of_threads);
+extern myBifurcationResult* analyzeBifurcationSBMLFromString(const char *str, const char *sta_var_id, const char *bif_param_id, double bif_param_min, double bif_param_max, double bif_param_stepsize, double transition_time, double sim_time, double dt, int print_interval, int method, int use_lazy_method, int num_of_threads);
+extern void write_bifurcation_csv(myBifurcationResult* result, const char* file);
+extern void free_myBifurcationResult(myBifurcationResult *result);
+typedef struct _sbmlsim_model sbmlsim_model;
+extern sbmlsim_model *sbmlsim_model_create_from_file(const char *file);
+extern sbmlsim_model *sbmlsim_model_create_from_string(const char *str);
+extern void sbmlsim_model_free(sbmlsim_model *model);
+extern double sbmlsim_model_get_read_time(sbmlsim_model *model);
+extern myResult *sbmlsim_model_simulate(sbmlsim_model *model, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method, double atol, double rtol, double facmax);
+extern int sbmlsim_model_set_value(sbmlsim_model *model, const char *id, double value);
+extern int sbmlsim_model_set_initial_amount(sbmlsim_model *model, const char *id, double value);
+extern int sbmlsim_model_set_initial_concentration(sbmlsim_model *model, const char *id, double value);
+extern int sbmlsim_model_set_local_parameter(sbmlsim_model *model, const char *reaction_id, const char *id, double value);
+extern void sbmlsim_model_reset_values(sbmlsim_model *model);
+extern void sbmlsim_model_set_num_of_threads(sbmlsim_model *model, int num_of_threads);
 typedef int BOOLEAN;
+
+/* index of the column named name, or -1 */
+static int find_column(const char **names, int num_of_columns, const char *name) {
+  int i;
+  if (name == NULL)
+    return -1;
+  for (i = 0; i < num_of_columns; i++) {
+    if (strcmp(names[i], name) == 0)
+      return i;
+  }
+  return -1;
+}
+
+/* helpers of the bulk accessors, which Python replaces by NumPy arrays */
+#ifndef SWIGPYTHON
+/* copy the values of column of a table of num_of_rows x num_of_columns
+ * values into values (at most size), return the number of rows or -1 */
+static int copy_column(const double *table, int num_of_rows, int num_of_columns, int column, double *values, int size) {
+  int i;
+  if (table == NULL || column < 0 || column >= num_of_columns)
+    return -1;
+  for (i = 0; i < num_of_rows && i < size; i++)
+    values[i] = table[i * num_of_columns + column];
+  return num_of_rows;
+}
+
+/* copy num_of_values values into values (at most size), return
+ * num_of_values or -1 */
+static int copy_values(const double *from, int num_of_values, double *values, int size) {
+  if (from == NULL && num_of_values > 0)
+    return -1;
+  if (num_of_values > 0 && size > 0)
+    memcpy(values, from, sizeof(double) * (size < num_of_values ? size : num_of_values));
+  return num_of_values;
+}
+#endif
 %}
 
 %include "../../src/libsbmlsim/methods.h"
@@ -58,6 +129,106 @@ typedef int BOOLEAN;
 %}
 #endif
 
+/*
+ * The bulk accessors of myResult copy values into an array supplied by
+ * the caller, as (double *values, int size), and return the number of
+ * values of the column, row or table (which may be larger than size).
+ * Java, Ruby and Perl pass a native array whose length is the size; C#
+ * passes a double[] and its size. Python has the NumPy arrays instead.
+ */
+#ifdef SWIGJAVA
+%typemap(jni) (double *values, int size) "jdoubleArray"
+%typemap(jtype) (double *values, int size) "double[]"
+%typemap(jstype) (double *values, int size) "double[]"
+%typemap(javain) (double *values, int size) "$javainput"
+%typemap(in) (double *values, int size) {
+  if (!$input) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "null array");
+    return $null;
+  }
+  $1 = (double *)JCALL2(GetDoubleArrayElements, jenv, $input, 0);
+  $2 = (int)JCALL1(GetArrayLength, jenv, $input);
+}
+%typemap(freearg) (double *values, int size) {
+  JCALL3(ReleaseDoubleArrayElements, jenv, $input, (jdouble *)$1, 0);
+}
+#endif
+
+#ifdef SWIGCSHARP
+%include "arrays_csharp.i"
+%apply double OUTPUT[] { double *values };
+#endif
+
+#ifdef SWIGRUBY
+%typemap(in) (double *values, int size) {
+  Check_Type($input, T_ARRAY);
+  $2 = (int)RARRAY_LEN($input);
+  $1 = (double *)calloc($2 + 1, sizeof(double));
+}
+%typemap(argout) (double *values, int size) {
+  int i;
+  for (i = 0; i < result && i < $2; i++)
+    rb_ary_store($input, i, rb_float_new($1[i]));
+}
+%typemap(freearg) (double *values, int size) {
+  free($1);
+}
+#endif
+
+#ifdef SWIGPERL
+%typemap(in) (double *values, int size) {
+  if (!SvROK($input) || SvTYPE(SvRV($input)) != SVt_PVAV)
+    SWIG_croak("Expected an array reference");
+  $2 = (int)av_len((AV *)SvRV($input)) + 1;
+  $1 = (double *)calloc($2 + 1, sizeof(double));
+}
+%typemap(argout) (double *values, int size) {
+  int i;
+  for (i = 0; i < result && i < $2; i++)
+    av_store((AV *)SvRV($input), i, newSVnv($1[i]));
+}
+%typemap(freearg) (double *values, int size) {
+  free($1);
+}
+#endif
+
+#ifdef SWIGPYTHON
+/*
+ * The simulations, sweeps, bifurcation analyses and the writers of the
+ * results do not call back into Python, and libSBMLSim has no mutable
+ * global state, so they release the GIL while they run. Calls from
+ * several Python threads then run concurrently.
+ */
+%define RELEASE_GIL(func)
+%exception func {
+  Py_BEGIN_ALLOW_THREADS
+  $action
+  Py_END_ALLOW_THREADS
+}
+%enddef
+
+RELEASE_GIL(simulateSBMLFromFile)
+RELEASE_GIL(simulateSBMLFromString)
+RELEASE_GIL(simulateSBMLFromFileSweep)
+RELEASE_GIL(simulateSBMLFromStringSweep)
+RELEASE_GIL(analyzeBifurcationSBMLFromFile)
+RELEASE_GIL(analyzeBifurcationSBMLFromString)
+RELEASE_GIL(sbmlsim_model::simulate)
+RELEASE_GIL(write_result)
+RELEASE_GIL(write_csv)
+RELEASE_GIL(write_tsv)
+RELEASE_GIL(write_binary)
+RELEASE_GIL(read_binary)
+RELEASE_GIL(write_separate_result)
+RELEASE_GIL(write_bifurcation_csv)
+
+%init %{
+#if PY_VERSION_HEX < 0x03070000
+  PyEval_InitThreads();
+#endif
+%}
+#endif
+
 /* %include "src/libsbmlsim/myResult.h" */
 typedef struct myResult {
   LibsbmlsimErrorCode error_code;
@@ -80,16 +251,32 @@ typedef struct myResult {
   double *values_comp;
   double *values_time_fordelay;
   int num_of_delay_rows;
+%immutable;
+  int num_of_steps;
+  int num_of_rejected_steps;
+  int num_of_rhs_evaluations;
+  int num_of_jacobian_evaluations;
+  int num_of_lu_decompositions;
+  int num_of_stiff_steps;
+  int num_of_method_switches;
+  double read_time;
+  double prepare_time;
+  double simulation_time;
+%mutable;
 } myResult;
 
 %newobject simulateSBMLFromFile;
 %newobject simulateSBMLFromString;
+%newobject read_binary;
 extern myResult* simulateSBMLFromFile(const char *file, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method);
 extern myResult* simulateSBMLFromString(const char *str, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method);
 extern void print_result(myResult* result);
 extern void write_result(myResult* result, char* file);
 extern void write_csv(myResult* result, char* file);
+extern void write_tsv(myResult* result, char* file);
+extern void write_binary(myResult* result, char* file, int use_float32);
 extern void write_separate_result(myResult* result, char* file_s, char* file_p, char* file_c);
+extern myResult* read_binary(char* file);
 
 %extend myResult {
   myResult() {
@@ -159,51 +346,520 @@ extern void write_separate_result(myResult* result, char* file_s, char* file_p,
   }
 
   double getSpeciesValueAtIndex(char *sname, int index) {
-    int i, spindex;
-    spindex = -1;
+    int spindex;
     if (index < 0 || index >= $self->num_of_rows || $self->error_code != NoError)
       return -0.0;
-    for (i = 0; i < $self->num_of_columns_sp; i++) {
-      if (strcmp($self->column_name_sp[i], sname) == 0) {
-        spindex = i;
-        break;
-      }
-    }
+    spindex = find_column($self->column_name_sp, $self->num_of_columns_sp, sname);
     if (spindex == -1)
       return -0.0;
     return $self->values_sp[index * $self->num_of_columns_sp + spindex];
   }
 
   double getParameterValueAtIndex(char *pname, int index) {
-    int i, pindex;
-    pindex = -1;
+    int pindex;
     if (index < 0 || index >= $self->num_of_rows || $self->error_code != NoError)
       return -0.0;
-    for (i = 0; i < $self->num_of_columns_param; i++) {
-      if (strcmp($self->column_name_param[i], pname) == 0) {
-        pindex = i;
-        break;
-      }
-    }
+    pindex = find_column($self->column_name_param, $self->num_of_columns_param, pname);
     if (pindex == -1)
       return -0.0;
-    return $self->values_param[index];
+    return $self->values_param[index * $self->num_of_columns_param + pindex];
   }
 
   double getCompartmentValueAtIndex(char *cname, int index) {
-    int i, cindex;
-    cindex = -1;
+    int cindex;
     if (index < 0 || index >= $self->num_of_rows || $self->error_code != NoError)
       return -0.0;
-    for (i = 0; i < $self->num_of_columns_comp; i++) {
-      if (strcmp($self->column_name_comp[i], cname) == 0) {
-        cindex = i;
-        break;
-      }
-    }
+    cindex = find_column($self->column_name_comp, $self->num_of_columns_comp, cname);
     if (cindex == -1)
       return -0.0;
-    return $self->values_comp[index];
+    return $self->values_comp[index * $self->num_of_columns_comp + cindex];
+  }
+
+  /* column of the species, parameter or compartment named name, or -1 */
+  int getSpeciesIndex(const char *name) {
+    if ($self->error_code != NoError)
+      return -1;
+    return find_column($self->column_name_sp, $self->num_of_columns_sp, name);
+  }
+
+  int getParameterIndex(const char *name) {
+    if ($self->error_code != NoError)
+      return -1;
+    return find_column($self->column_name_param, $self->num_of_columns_param, name);
+  }
+
+  int getCompartmentIndex(const char *name) {
+    if ($self->error_code != NoError)
+      return -1;
+    return find_column($self->column_name_comp, $self->num_of_columns_comp, name);
+  }
+
+#ifndef SWIGPYTHON
+  /* the times, and the values of a column (one per row) */
+  int getTimeColumn(double *values, int size) {
+    if ($self->error_code != NoError)
+      return -1;
+    return copy_values($self->values_time, $self->num_of_rows, values, size);
+  }
+
+  int getSpeciesColumn(int column, double *values, int size) {
+    if ($self->error_code != NoError)
+      return -1;
+    return copy_column($self->values_sp, $self->num_of_rows, $self->num_of_columns_sp, column, values, size);
+  }
+
+  int getParameterColumn(int column, double *values, int size) {
+    if ($self->error_code != NoError)
+      return -1;
+    return copy_column($self->values_param, $self->num_of_rows, $self->num_of_columns_param, column, values, size);
+  }
+
+  int getCompartmentColumn(int column, double *values, int size) {
+    if ($self->error_code != NoError)
+      return -1;
+    return copy_column($self->values_comp, $self->num_of_rows, $self->num_of_columns_comp, column, values, size);
+  }
+
+  /* the values of a row (one per column) */
+  int getSpeciesRow(int row, double *values, int size) {
+    if (row < 0 || row >= $self->num_of_rows || $self->error_code != NoError)
+      return -1;
+    return copy_values($self->values_sp + row * $self->num_of_columns_sp, $self->num_of_columns_sp, values, size);
+  }
+
+  int getParameterRow(int row, double *values, int size) {
+    if (row < 0 || row >= $self->num_of_rows || $self->error_code != NoError)
+      return -1;
+    return copy_values($self->values_param + row * $self->num_of_columns_param, $self->num_of_columns_param, values, size);
+  }
+
+  int getCompartmentRow(int row, double *values, int size) {
+    if (row < 0 || row >= $self->num_of_rows || $self->error_code != NoError)
+      return -1;
+    return copy_values($self->values_comp + row * $self->num_of_columns_comp, $self->num_of_columns_comp, values, size);
+  }
+
+  /* all the values, row by row (rows x columns) */
+  int getSpeciesValues(double *values, int size) {
+    if ($self->error_code != NoError)
+      return -1;
+    return copy_values($self->values_sp, $self->num_of_rows * $self->num_of_columns_sp, values, size);
+  }
+
+  int getParameterValues(double *values, int size) {
+    if ($self->error_code != NoError)
+      return -1;
+    return copy_values($self->values_param, $self->num_of_rows * $self->num_of_columns_param, values, size);
+  }
+
+  int getCompartmentValues(double *values, int size) {
+    if ($self->error_code != NoError)
+      return -1;
+    return copy_values($self->values_comp, $self->num_of_rows * $self->num_of_columns_comp, values, size);
+  }
+#endif
+
+  int getNumOfSteps() {
+    return $self->num_of_steps;
+  }
+
+  int getNumOfRejectedSteps() {
+    return $self->num_of_rejected_steps;
+  }
+
+  int getNumOfRhsEvaluations() {
+    return $self->num_of_rhs_evaluations;
   }
 
+  int getNumOfJacobianEvaluations() {
+    return $self->num_of_jacobian_evaluations;
+  }
+
+  int getNumOfLUDecompositions() {
+    return $self->num_of_lu_decompositions;
+  }
+
+  int getNumOfStiffSteps() {
+    return $self->num_of_stiff_steps;
+  }
+
+  int getNumOfMethodSwitches() {
+    return $self->num_of_method_switches;
+  }
+
+  double getReadTime() {
+    return $self->read_time;
+  }
+
+  double getPrepareTime() {
+    return $self->prepare_time;
+  }
+
+  double getSimulationTime() {
+    return $self->simulation_time;
+  }
+
+#ifdef SWIGPYTHON
+  /* address of values_time (0), _sp (1), _param (2) or _comp (3), which
+   * the NumPy arrays of getTimeValues(), ... are backed by */
+  size_t _getValuesAddress(int kind) {
+    switch (kind) {
+      case 0: return (size_t)$self->values_time;
+      case 1: return (size_t)$self->values_sp;
+      case 2: return (size_t)$self->values_param;
+      case 3: return (size_t)$self->values_comp;
+      default: return 0;
+    }
+  }
+
+  %pythoncode %{
+    def _getValues(self, kind, num_of_columns=None):
+        import numpy
+        if self.isError():
+            raise ValueError(self.getErrorMessage())
+        if num_of_columns is None:
+            shape = (self.getNumOfRows(),)
+        else:
+            shape = (self.getNumOfRows(), num_of_columns)
+        address = self._getValuesAddress(kind)
+        if address == 0 or 0 in shape:
+            return numpy.zeros(shape)
+        return numpy.asarray(_ResultValues(self, address, shape))
+
+    def getTimeValues(self):
+        """ Read-only NumPy array of the times, backed by the result """
+        return self._getValues(0)
+
+    def getSpeciesValues(self):
+        """ Read-only NumPy array of the values of the species (rows x species), backed by the result """
+        return self._getValues(1, self.getNumOfSpecies())
+
+    def getParameterValues(self):
+        """ Read-only NumPy array of the values of the parameters (rows x parameters), backed by the result """
+        return self._getValues(2, self.getNumOfParameters())
+
+    def getCompartmentValues(self):
+        """ Read-only NumPy array of the sizes of the compartments (rows x compartments), backed by the result """
+        return self._getValues(3, self.getNumOfCompartments())
+  %}
+#endif
+
+};
+
+#ifdef SWIGPYTHON
+%pythoncode %{
+class _ResultValues(object):
+    """ Values of a myResult, exposed to NumPy without copying them. The arrays keep this object, and so the
+    result, alive """
+
+    def __init__(self, result, address, shape):
+        import sys
+        self.result = result
+        self.__array_interface__ = {
+            'version': 3,
+            'shape': shape,
+            'typestr': ('<' if sys.byteorder == 'little' else '>') + 'f8',
+            'data': (address, True),
+        }
+%}
+#endif
+
+/* %include "src/libsbmlsim/mySweep.h" */
+typedef struct mySweepPoints {
+%immutable;
+  int num_of_ids;
+  char **ids;
+  int num_of_points;
+  unsigned int seed;
+%mutable;
+} mySweepPoints;
+
+typedef struct mySweepResult {
+%immutable;
+  LibsbmlsimErrorCode error_code;
+  char *error_message;
+  int num_of_points;
+  int num_of_rows;
+  int num_of_columns;
+  int num_of_columns_sp;
+  int num_of_columns_param;
+  int num_of_columns_comp;
+  char *column_name_time;
+  char **column_name_sp;
+  char **column_name_param;
+  char **column_name_comp;
+  double *values_time;
+  double *values;
+  int num_of_threads;
+  double elapsed_time;
+%mutable;
+} mySweepResult;
+
+%newobject simulateSBMLFromFileSweep;
+%newobject simulateSBMLFromStringSweep;
+extern mySweepResult* simulateSBMLFromFileSweep(const char *file, mySweepPoints *points, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method, int num_of_threads);
+extern mySweepResult* simulateSBMLFromStringSweep(const char *str, mySweepPoints *points, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method, int num_of_threads);
+
+%extend mySweepPoints {
+  mySweepPoints() {
+    return create_mySweepPoints();
+  }
+
+  ~mySweepPoints() {
+    free_mySweepPoints($self);
+  }
+
+  /* methods without a body are the functions mySweepPoints_<method>()
+   * of the library (a body would define a wrapper of the same name) */
+  int addId(const char *id);
+  int addPoint();
+  BOOLEAN setValue(int point, int index, double value);
+  double getValue(int point, int index);
+  BOOLEAN setCost(int point, double cost);
+  BOOLEAN setCostsFromResult(mySweepResult *result);
+  void setSeed(unsigned int seed);
+
+  unsigned int getSeed() {
+    return $self->seed;
+  }
+
+  int getNumOfIds() {
+    return $self->num_of_ids;
+  }
+
+  int getNumOfPoints() {
+    return $self->num_of_points;
+  }
+};
+
+%newobject mySweepResult::getResult;
+%extend mySweepResult {
+  ~mySweepResult() {
+    free_mySweepResult($self);
+  }
+
+  BOOLEAN isError() {
+    return $self->error_code != NoError;
+  }
+
+  LibsbmlsimErrorCode getErrorCode() {
+    return $self->error_code;
+  }
+
+  const char *getErrorMessage() {
+    return $self->error_message;
+  }
+
+  int getNumOfPoints() {
+    return $self->num_of_points;
+  }
+
+  int getNumOfRows() {
+    return $self->num_of_rows;
+  }
+
+  int getNumOfColumns() {
+    return $self->num_of_columns;
+  }
+
+  int getNumOfSpecies() {
+    return $self->num_of_columns_sp;
+  }
+
+  int getNumOfParameters() {
+    return $self->num_of_columns_param;
+  }
+
+  int getNumOfCompartments() {
+    return $self->num_of_columns_comp;
+  }
+
+  int getNumOfThreads() {
+    return $self->num_of_threads;
+  }
+
+  const char *getTimeName() {
+    return $self->column_name_time;
+  }
+
+  /* name of column, columns are species, parameters and compartments */
+  const char *getColumnNameAtIndex(int column) {
+    if (column < 0 || column >= $self->num_of_columns || $self->error_code != NoError)
+      return NULL;
+    if (column < $self->num_of_columns_sp)
+      return $self->column_name_sp[column];
+    column -= $self->num_of_columns_sp;
+    if (column < $self->num_of_columns_param)
+      return $self->column_name_param[column];
+    return $self->column_name_comp[column - $self->num_of_columns_param];
+  }
+
+  double getTimeValueAtIndex(int index) {
+    if (index < 0 || index >= $self->num_of_rows || $self->error_code != NoError)
+      return -0.0;
+    return $self->values_time[index];
+  }
+
+  double getValue(int point, int index, int column) {
+    if (point < 0 || point >= $self->num_of_points || index < 0 || index >= $self->num_of_rows
+        || column < 0 || column >= $self->num_of_columns || $self->error_code != NoError)
+      return -0.0;
+    return $self->values[((long)point * $self->num_of_rows + index) * $self->num_of_columns + column];
+  }
+
+  LibsbmlsimErrorCode getPointErrorCode(int point) {
+    if (point < 0 || point >= $self->num_of_points || $self->error_code != NoError)
+      return $self->error_code;
+    return $self->point_error_codes[point];
+  }
+
+  /* mySweepResult_getResult() */
+  myResult *getResult(int point);
+
+  double getPointTime(int point) {
+    if (point < 0 || point >= $self->num_of_points || $self->point_times == NULL)
+      return -0.0;
+    return $self->point_times[point];
+  }
+
+  double getElapsedTime() {
+    return $self->elapsed_time;
+  }
+
+  /* mySweepResult_getWorkerUtilization() */
+  double getWorkerUtilization(int worker);
+
+  int getWorkerNumOfPoints(int worker) {
+    if (worker < 0 || worker >= $self->num_of_threads || $self->worker_stats == NULL)
+      return 0;
+    return $self->worker_stats[worker].num_of_tasks;
+  }
+
+  int getWorkerNumOfSteals(int worker) {
+    if (worker < 0 || worker >= $self->num_of_threads || $self->worker_stats == NULL)
+      return 0;
+    return $self->worker_stats[worker].num_of_steals;
+  }
+};
+
+/* %include "src/libsbmlsim/myBifurcation.h" */
+typedef struct myBifurcationResult {
+%immutable;
+  LibsbmlsimErrorCode error_code;
+  char *error_message;
+  char *variable_id;
+  char *parameter_id;
+  int num_of_points;
+  double *parameter_values;
+  double *local_max;
+  double *local_min;
+  int num_of_threads;
+  double elapsed_time;
+%mutable;
+} myBifurcationResult;
+
+%newobject analyzeBifurcationSBMLFromFile;
+%newobject analyzeBifurcationSBMLFromString;
+extern myBifurcationResult* analyzeBifurcationSBMLFromFile(const char *file, const char *sta_var_id, const char *bif_param_id, double bif_param_min, double bif_param_max, double bif_param_stepsize, double transition_time, double sim_time, double dt, int print_interval, int method, int use_lazy_method, int num_of_threads);
+extern myBifurcationResult* analyzeBifurcationSBMLFromString(const char *str, const char *sta_var_id, const char *bif_param_id, double bif_param_min, double bif_param_max, double bif_param_stepsize, double transition_time, double sim_time, double dt, int print_interval, int method, int use_lazy_method, int num_of_threads);
+extern void write_bifurcation_csv(myBifurcationResult* result, const char* file);
+
+%extend myBifurcationResult {
+  ~myBifurcationResult() {
+    free_myBifurcationResult($self);
+  }
+
+  BOOLEAN isError() {
+    return $self->error_code != NoError;
+  }
+
+  LibsbmlsimErrorCode getErrorCode() {
+    return $self->error_code;
+  }
+
+  const char *getErrorMessage() {
+    return $self->error_message;
+  }
+
+  int getNumOfPoints() {
+    return $self->num_of_points;
+  }
+
+  int getNumOfThreads() {
+    return $self->num_of_threads;
+  }
+
+  double getElapsedTime() {
+    return $self->elapsed_time;
+  }
+
+  double getParameterValueAtIndex(int index) {
+    if (index < 0 || index >= $self->num_of_points)
+      return -0.0;
+    return $self->parameter_values[index];
+  }
+
+  double getLocalMaxAtIndex(int index) {
+    if (index < 0 || index >= $self->num_of_points)
+      return -0.0;
+    return $self->local_max[index];
+  }
+
+  double getLocalMinAtIndex(int index) {
+    if (index < 0 || index >= $self->num_of_points)
+      return -0.0;
+    return $self->local_min[index];
+  }
+
+  LibsbmlsimErrorCode getPointErrorCode(int index) {
+    if (index < 0 || index >= $self->num_of_points)
+      return $self->error_code;
+    return $self->point_error_codes[index];
+  }
+};
+
+/* a model prepared once and simulated repeatedly */
+typedef struct _sbmlsim_model {} sbmlsim_model;
+
+%newobject sbmlsim_model_create_from_file;
+%newobject sbmlsim_model_create_from_string;
+extern sbmlsim_model *sbmlsim_model_create_from_file(const char *file);
+extern sbmlsim_model *sbmlsim_model_create_from_string(const char *str);
+
+%newobject sbmlsim_model::simulate;
+%extend sbmlsim_model {
+  ~sbmlsim_model() {
+    sbmlsim_model_free($self);
+  }
+
+  /* sbmlsim_model_simulate() of the library */
+  myResult *simulate(double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method, double atol = 0.0, double rtol = 0.0, double facmax = 0.0);
+
+  BOOLEAN setValue(const char *id, double value) {
+    return sbmlsim_model_set_value($self, id, value);
+  }
+
+  BOOLEAN setInitialAmount(const char *id, double value) {
+    return sbmlsim_model_set_initial_amount($self, id, value);
+  }
+
+  BOOLEAN setInitialConcentration(const char *id, double value) {
+    return sbmlsim_model_set_initial_concentration($self, id, value);
+  }
+
+  BOOLEAN setLocalParameter(const char *reaction_id, const char *id, double value) {
+    return sbmlsim_model_set_local_parameter($self, reaction_id, id, value);
+  }
+
+  void resetValues() {
+    sbmlsim_model_reset_values($self);
+  }
+
+  void setNumOfThreads(int num_of_threads) {
+    sbmlsim_model_set_num_of_threads($self, num_of_threads);
+  }
+
+  double getReadTime() {
+    return sbmlsim_model_get_read_time($self);
+  }
 };
@@ -0,0 +1,792 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "libsbmlsim/libsbmlsim.h"
+#include "sweep.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* Ensemble runner: simulates a model over the points of a CSV file in
+ * forked worker processes.
+ *
+ * The parent hands out the points one at a time over a pair of pipes per
+ * worker, and each worker writes the rows of its points directly into a
+ * shared memory-mapped result file. A worker which dies (e.g. a segfault
+ * on a pathological parameter set) only loses its current point, which is
+ * recorded with the signal that killed it, and a new worker takes over.
+ *
+ * The layout of a run is only known when the first point has been
+ * simulated, so a worker keeps the result of its point until the parent
+ * tells it where to store it:
+ *   parent -> worker  {ENSEMBLE_RUN, point}
+ *   worker -> parent  {point, error code, number of rows, seconds}
+ *   parent -> worker  {ENSEMBLE_STORE, point}  (result file is laid out)
+ *   worker -> parent  {point, NoError, number of rows, seconds}
+ *
+ * Result file (native byte order, offsets from the start of the file):
+ *   ensemble_header
+ *   names         "time", ids of species, parameters and compartments,
+ *                 each terminated by '\0'
+ *   error_codes   int32[num_of_points], LibsbmlsimErrorCode or -1 (not run)
+ *   signals       int32[num_of_points], signal which killed the worker, or 0
+ *   point_times   double[num_of_points], seconds spent in each point
+ *   values_time   double[num_of_rows]
+ *   values        for each point, in the layout of myResult:
+ *                 values_sp[num_of_rows * num_of_columns_sp],
+ *                 values_param[num_of_rows * num_of_columns_param],
+ *                 values_comp[num_of_rows * num_of_columns_comp]
+ * Values of the points which failed are NaN. */
+
+#define ENSEMBLE_MAGIC "SBMLSIME"
+#define ENSEMBLE_VERSION 1
+#define ENSEMBLE_RUN 0
+#define ENSEMBLE_STORE 1
+#define ENSEMBLE_NOT_RUN (-1)
+#define ENSEMBLE_LINE_SIZE 65536
+
+typedef struct {
+  char magic[8];
+  int version;
+  int num_of_points;
+  int num_of_rows;
+  int num_of_columns_sp;
+  int num_of_columns_param;
+  int num_of_columns_comp;
+  long long names_offset;
+  long long error_codes_offset;
+  long long signals_offset;
+  long long point_times_offset;
+  long long values_time_offset;
+  long long values_offset;
+  long long file_size;
+} ensemble_header;
+
+typedef struct {
+  int op;
+  int point;
+} ensemble_command;
+
+typedef struct {
+  int point;
+  int error_code;
+  int num_of_rows;
+  double time;
+} ensemble_reply;
+
+typedef struct {
+  pid_t pid;
+  int command_fd;
+  int reply_fd;
+  int op; /* ENSEMBLE_RUN or ENSEMBLE_STORE */
+  int point; /* point being run or stored, -1 if idle */
+} ensemble_worker;
+
+typedef struct {
+  /* model and simulation */
+  Model_t *m;
+  mySweepPoints *points;
+  double sim_time;
+  double dt;
+  int print_interval;
+  int print_amount;
+  int method;
+  int use_lazy_method;
+  double atol;
+  double rtol;
+  double facmax;
+  /* result file */
+  const char *file;
+  int fd;
+  char *map;
+  ensemble_header *header;
+} ensemble_job;
+
+static void usage(char *str) {
+  printf("Usage    : %s [option] sbml_file points_file\n", str);
+  printf("           points_file is a CSV file whose header line has the ids of species,\n");
+  printf("           parameters and compartments, and whose other lines are the points\n");
+  printf("           (an empty value or nan keeps the value in the model)\n");
+  printf(" -t #    : specify simulation time (ex. -t 100 )\n");
+  printf(" -s #    : specify simulation step (ex. -s 100 )\n");
+  printf(" -d #    : specify simulation delta (ex. -d 0.01 [default:1/4096])\n");
+  printf("           dt is calculated in (delta)*(time)/(step)\n");
+  printf(" -a      : print Species Value in Amount\n");
+  printf(" -o file : specify result file (ex. -o ensemble.dat [default:ensemble.dat])\n");
+  printf(" -l      : use lazy method for integration\n");
+  printf(" -A #    : specify absolute tolerance for variable stepsize (ex. -A 1e-03 [default:1e-09])\n");
+  printf(" -R #    : specify relative tolerance for variable stepsize (ex. -R 0.1   [default:1e-06])\n");
+  printf(" -M #    : specify the max change rate of stepsize (ex. -M 1.5 [default:2.0])\n");
+  printf(" -S #    : specify the seed of the random numbers, point p uses the stream p\n");
+  printf("           of the seed, as in the parameter sweep (ex. -S 5489 [default:0])\n");
+  printf(" -p #    : specify the number of worker processes (ex. -p 8 [default:all processors])\n");
+  printf(" -m #    : specify numerical integration algorithm as in simulateSBML (ex. -m 3 )\n");
+  printf("           [default:1 (Runge-Kutta)]\n");
+  exit(1);
+}
+
+/* methods of -m 1 to 19, as in simulateSBML */
+static const int ensemble_methods[] = {
+  MTHD_RUNGE_KUTTA, MTHD_BACKWARD_EULER, MTHD_CRANK_NICOLSON,
+  MTHD_ADAMS_MOULTON_3, MTHD_ADAMS_MOULTON_4, MTHD_BACKWARD_DIFFERENCE_2,
+  MTHD_BACKWARD_DIFFERENCE_3, MTHD_BACKWARD_DIFFERENCE_4, MTHD_EULER,
+  MTHD_ADAMS_BASHFORTH_2, MTHD_ADAMS_BASHFORTH_3, MTHD_ADAMS_BASHFORTH_4,
+  MTHD_RUNGE_KUTTA_FEHLBERG_5, MTHD_CASH_KARP, MTHD_ADAPTIVE_BACKWARD_DIFFERENCE,
+  MTHD_DORMAND_PRINCE, MTHD_ROSENBROCK_3, MTHD_ROSENBROCK_4, MTHD_AUTO_SWITCHING
+};
+
+static int read_full(int fd, void *buf, size_t size) {
+  char *p = (char *)buf;
+  ssize_t n;
+
+  while (size > 0) {
+    n = read(fd, p, size);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return 0;
+    }
+    p += n;
+    size -= (size_t)n;
+  }
+  return 1;
+}
+
+static int write_full(int fd, const void *buf, size_t size) {
+  const char *p = (const char *)buf;
+  ssize_t n;
+
+  while (size > 0) {
+    n = write(fd, p, size);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return 0;
+    }
+    p += n;
+    size -= (size_t)n;
+  }
+  return 1;
+}
+
+/* split line at commas (in place), returns the number of fields */
+static int split_csv_line(char *line, char **fields, int max_fields) {
+  int n = 0;
+  char *p = line;
+  char *end;
+
+  line[strcspn(line, "\r\n")] = '\0';
+  while (n < max_fields) {
+    while (*p == ' ' || *p == '\t') {
+      p++;
+    }
+    fields[n++] = p;
+    end = strchr(p, ',');
+    if (end != NULL) {
+      *end = '\0';
+    }
+    /* trim the end of the field */
+    p += strlen(p);
+    while (p > fields[n - 1] && (p[-1] == ' ' || p[-1] == '\t')) {
+      *--p = '\0';
+    }
+    if (end == NULL) {
+      break;
+    }
+    p = end + 1;
+  }
+  return n;
+}
+
+static mySweepPoints *read_points(const char *file) {
+  FILE *fp;
+  mySweepPoints *points;
+  char *line;
+  char **fields;
+  char *end;
+  double value;
+  int num_of_fields, point, lineno;
+  int i;
+
+  if ((fp = fopen(file, "r")) == NULL) {
+    fprintf(stderr, "Cannot open points file [%s]\n", file);
+    return NULL;
+  }
+  points = create_mySweepPoints();
+  line = (char *)malloc(ENSEMBLE_LINE_SIZE);
+  fields = (char **)malloc(sizeof(char *) * ENSEMBLE_LINE_SIZE);
+  lineno = 0;
+  while (fgets(line, ENSEMBLE_LINE_SIZE, fp) != NULL) {
+    lineno++;
+    if (line[0] == '#' || line[strspn(line, " \t\r\n")] == '\0') {
+      continue;
+    }
+    num_of_fields = split_csv_line(line, fields, ENSEMBLE_LINE_SIZE);
+    if (points->num_of_ids == 0) {
+      for (i = 0; i < num_of_fields; i++) {
+        mySweepPoints_addId(points, fields[i]);
+      }
+      continue;
+    }
+    if (num_of_fields > points->num_of_ids) {
+      fprintf(stderr, "%s:%d: more values than ids\n", file, lineno);
+      goto error;
+    }
+    point = mySweepPoints_addPoint(points);
+    for (i = 0; i < num_of_fields; i++) {
+      if (fields[i][0] == '\0') {
+        continue;
+      }
+      value = strtod(fields[i], &end);
+      if (*end != '\0') {
+        fprintf(stderr, "%s:%d: [%s] is not a number\n", file, lineno, fields[i]);
+        goto error;
+      }
+      mySweepPoints_setValue(points, point, i, value);
+    }
+  }
+  free(fields);
+  free(line);
+  fclose(fp);
+  return points;
+
+error:
+  free(fields);
+  free(line);
+  fclose(fp);
+  free_mySweepPoints(points);
+  return NULL;
+}
+
+static long long align8(long long offset) {
+  return (offset + 7) & ~7LL;
+}
+
+static double *point_values(ensemble_job *job, int point) {
+  ensemble_header *h = job->header;
+  long long n = (long long)h->num_of_rows
+    * (h->num_of_columns_sp + h->num_of_columns_param + h->num_of_columns_comp);
+
+  return (double *)(job->map + h->values_offset) + n * point;
+}
+
+/* map the result file of the parent, which has already laid it out */
+static int map_result_file(ensemble_job *job) {
+  ensemble_header header;
+
+  if (job->map != NULL) {
+    return 1;
+  }
+  if ((job->fd = open(job->file, O_RDWR)) < 0) {
+    return 0;
+  }
+  if (!read_full(job->fd, &header, sizeof(header))) {
+    return 0;
+  }
+  job->map = (char *)mmap(NULL, (size_t)header.file_size, PROT_READ | PROT_WRITE, MAP_SHARED, job->fd, 0);
+  if (job->map == MAP_FAILED) {
+    job->map = NULL;
+    return 0;
+  }
+  job->header = (ensemble_header *)job->map;
+  return 1;
+}
+
+/* name of column i of myResult (species, parameters and compartments
+ * of the model, in the order of the model) */
+static const char *column_name(Model_t *m, int i) {
+  if (i < (int)Model_getNumSpecies(m))
+    return Species_getId(Model_getSpecies(m, i));
+  i -= Model_getNumSpecies(m);
+  if (i < (int)Model_getNumParameters(m))
+    return Parameter_getId(Model_getParameter(m, i));
+  i -= Model_getNumParameters(m);
+  return Compartment_getId(Model_getCompartment(m, i));
+}
+
+/* lay out the result file for the number of rows of the first result,
+ * all values are NaN until stored */
+static int create_result_file(ensemble_job *job, int num_of_rows) {
+  ensemble_header h;
+  long long names_size, k, n;
+  int num_of_points = job->points->num_of_points;
+  int num_of_columns;
+  int *codes;
+  int i;
+  char *p;
+  double *values;
+
+  num_of_columns = Model_getNumSpecies(job->m) + Model_getNumParameters(job->m)
+    + Model_getNumCompartments(job->m);
+  names_size = strlen("time") + 1;
+  for (i = 0; i < num_of_columns; i++)
+    names_size += strlen(column_name(job->m, i)) + 1;
+
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, ENSEMBLE_MAGIC, sizeof(h.magic));
+  h.version = ENSEMBLE_VERSION;
+  h.num_of_points = num_of_points;
+  h.num_of_rows = num_of_rows;
+  h.num_of_columns_sp = Model_getNumSpecies(job->m);
+  h.num_of_columns_param = Model_getNumParameters(job->m);
+  h.num_of_columns_comp = Model_getNumCompartments(job->m);
+  h.names_offset = align8(sizeof(h));
+  h.error_codes_offset = align8(h.names_offset + names_size);
+  h.signals_offset = align8(h.error_codes_offset + (long long)sizeof(int) * num_of_points);
+  h.point_times_offset = align8(h.signals_offset + (long long)sizeof(int) * num_of_points);
+  h.values_time_offset = h.point_times_offset + (long long)sizeof(double) * num_of_points;
+  h.values_offset = h.values_time_offset + (long long)sizeof(double) * num_of_rows;
+  n = (long long)num_of_points * num_of_rows
+    * (h.num_of_columns_sp + h.num_of_columns_param + h.num_of_columns_comp);
+  h.file_size = h.values_offset + (long long)sizeof(double) * n;
+
+  if ((job->fd = open(job->file, O_RDWR | O_CREAT | O_TRUNC, 0644)) < 0) {
+    return 0;
+  }
+  if (ftruncate(job->fd, (off_t)h.file_size) != 0) {
+    return 0;
+  }
+  job->map = (char *)mmap(NULL, (size_t)h.file_size, PROT_READ | PROT_WRITE, MAP_SHARED, job->fd, 0);
+  if (job->map == MAP_FAILED) {
+    job->map = NULL;
+    return 0;
+  }
+  job->header = (ensemble_header *)job->map;
+  memcpy(job->map, &h, sizeof(h));
+
+  p = job->map + h.names_offset;
+  strcpy(p, "time");
+  p += strlen(p) + 1;
+  for (i = 0; i < num_of_columns; i++) {
+    strcpy(p, column_name(job->m, i));
+    p += strlen(p) + 1;
+  }
+  codes = (int *)(job->map + h.error_codes_offset);
+  for (i = 0; i < num_of_points; i++) {
+    codes[i] = ENSEMBLE_NOT_RUN;
+  }
+  /* signals are 0 (the file is zero-filled) */
+  values = (double *)(job->map + h.point_times_offset);
+  for (i = 0; i < num_of_points; i++) {
+    values[i] = my_nan();
+  }
+  values = (double *)(job->map + h.values_time_offset);
+  for (i = 0; i < num_of_rows; i++) {
+    values[i] = my_nan();
+  }
+  values = (double *)(job->map + h.values_offset);
+  for (k = 0; k < n; k++) {
+    values[k] = my_nan();
+  }
+  return 1;
+}
+
+static void store_result(ensemble_job *job, int point, myResult *res) {
+  double *values = point_values(job, point);
+  double *values_time = (double *)(job->map + job->header->values_time_offset);
+  long long n;
+
+  /* every point has the same time column */
+  memcpy(values_time, res->values_time, sizeof(double) * res->num_of_rows);
+  n = (long long)res->num_of_rows * res->num_of_columns_sp;
+  memcpy(values, res->values_sp, sizeof(double) * n);
+  values += n;
+  n = (long long)res->num_of_rows * res->num_of_columns_param;
+  memcpy(values, res->values_param, sizeof(double) * n);
+  values += n;
+  n = (long long)res->num_of_rows * res->num_of_columns_comp;
+  memcpy(values, res->values_comp, sizeof(double) * n);
+}
+
+/* body of a worker process, m is its own copy of the model, which is
+ * prepared once for all the points of the worker */
+static void run_worker(ensemble_job *job, int command_fd, int reply_fd) {
+  ensemble_command command;
+  ensemble_reply reply;
+  mySweepPoints *points = job->points;
+  sbmlsim_model *model;
+  sbmlsim_context *ctx;
+  myResult *res = NULL;
+  double start_time;
+
+  model = sbmlsim_model_create(job->m);
+  ctx = sbmlsim_context_create(0);
+  /* the points already run in parallel */
+  sbmlsim_context_set_num_of_threads(ctx, 1);
+
+  while (read_full(command_fd, &command, sizeof(command))) {
+    reply.point = command.point;
+    if (command.op == ENSEMBLE_RUN) {
+      if (res != NULL) {
+        free_myResult(res);
+      }
+      start_time = sbmlsim_wall_time();
+      sbmlsim_sweep_set_point(model, points, command.point);
+      /* same stream as simulateSBMLModelSweep */
+      sbmlsim_context_seed_stream(ctx, points->seed, (unsigned int)command.point);
+      res = sbmlsim_model_run(model, ctx, job->sim_time, job->dt,
+          job->print_interval, job->print_amount, job->method, job->use_lazy_method,
+          job->atol, job->rtol, job->facmax);
+      reply.error_code = (res == NULL) ? SimulationFailed : res->error_code;
+      reply.num_of_rows = (reply.error_code == NoError) ? res->num_of_rows : 0;
+      reply.time = sbmlsim_wall_time() - start_time;
+    } else {
+      reply.error_code = SimulationFailed;
+      if (res != NULL && map_result_file(job)) {
+        store_result(job, command.point, res);
+        reply.error_code = NoError;
+      }
+      reply.num_of_rows = (res != NULL) ? res->num_of_rows : 0;
+      reply.time = 0;
+    }
+    if (!write_full(reply_fd, &reply, sizeof(reply))) {
+      break;
+    }
+  }
+  if (res != NULL) {
+    free_myResult(res);
+  }
+  sbmlsim_context_free(ctx);
+  sbmlsim_model_free(model);
+}
+
+static int start_worker(ensemble_job *job, ensemble_worker *workers, int num_of_workers, int index) {
+  int command_pipe[2], reply_pipe[2];
+  int i;
+  pid_t pid;
+
+  if (pipe(command_pipe) != 0) {
+    return 0;
+  }
+  if (pipe(reply_pipe) != 0) {
+    close(command_pipe[0]);
+    close(command_pipe[1]);
+    return 0;
+  }
+  fflush(stdout);
+  fflush(stderr);
+  pid = fork();
+  if (pid < 0) {
+    close(command_pipe[0]);
+    close(command_pipe[1]);
+    close(reply_pipe[0]);
+    close(reply_pipe[1]);
+    return 0;
+  }
+  if (pid == 0) {
+    /* the pipes of the other workers must not be kept open here, or
+     * their deaths would not be seen by the parent */
+    for (i = 0; i < num_of_workers; i++) {
+      if (i != index && workers[i].pid > 0) {
+        close(workers[i].command_fd);
+        close(workers[i].reply_fd);
+      }
+    }
+    close(command_pipe[1]);
+    close(reply_pipe[0]);
+    run_worker(job, command_pipe[0], reply_pipe[1]);
+    _exit(0);
+  }
+  close(command_pipe[0]);
+  close(reply_pipe[1]);
+  workers[index].pid = pid;
+  workers[index].command_fd = command_pipe[1];
+  workers[index].reply_fd = reply_pipe[0];
+  workers[index].op = ENSEMBLE_RUN;
+  workers[index].point = -1;
+  return 1;
+}
+
+static void stop_worker(ensemble_worker *worker, int *status) {
+  close(worker->command_fd);
+  close(worker->reply_fd);
+  while (waitpid(worker->pid, status, 0) < 0 && errno == EINTR)
+    ;
+  worker->pid = -1;
+  worker->point = -1;
+}
+
+static int send_command(ensemble_worker *worker, int op, int point) {
+  ensemble_command command;
+
+  command.op = op;
+  command.point = point;
+  worker->op = op;
+  worker->point = point;
+  return write_full(worker->command_fd, &command, sizeof(command));
+}
+
+int main(int argc, char *argv[]) {
+  SBMLDocument_t *d;
+  ensemble_job job;
+  ensemble_worker *workers;
+  ensemble_reply reply;
+  struct pollfd *fds;
+  int *error_codes = NULL;
+  int *signals = NULL;
+  double *point_times = NULL;
+  /*  Variables for getopt() */
+  int ch;
+  extern char *optarg;
+  extern int optind;
+
+  char *myname;
+  int step = 100;
+  double delta = 1.0/4096;
+  int method_key = 1;
+  int num_of_processes = 0;
+  unsigned int seed = 0;
+  int num_of_workers, num_of_points;
+  int next_point, num_of_finished, num_of_failed, num_of_crashed, num_of_alive;
+  int kind, status, rows_of_first;
+  SBase_t *target;
+  double value, start_time;
+  int i, j;
+
+  job.sim_time = 0;
+  job.print_amount = 0;
+  job.use_lazy_method = false;
+  job.atol = ABSOLUTE_ERROR_TOLERANCE;
+  job.rtol = RELATIVE_ERROR_TOLERANCE;
+  job.facmax = DEFAULT_FACMAX;
+  job.file = "ensemble.dat";
+  job.fd = -1;
+  job.map = NULL;
+  job.header = NULL;
+
+  myname = argv[0];
+  while ((ch = getopt(argc, argv, "t:s:d:m:A:R:M:o:S:p:la")) != -1){
+    switch (ch) {
+      case 't':
+        job.sim_time = atof(optarg);
+        break;
+      case 's':
+        step = atoi(optarg);
+        break;
+      case 'd':
+        delta = atof(optarg);
+        break;
+      case 'm':
+        method_key = atoi(optarg);
+        break;
+      case 'l':
+        job.use_lazy_method = true;
+        break;
+      case 'a':
+        job.print_amount = 1;
+        break;
+      case 'A':
+        job.atol = atof(optarg);
+        break;
+      case 'R':
+        job.rtol = atof(optarg);
+        break;
+      case 'M':
+        job.facmax = atof(optarg);
+        break;
+      case 'o':
+        job.file = optarg;
+        break;
+      case 'S':
+        seed = (unsigned int)strtoul(optarg, NULL, 10);
+        break;
+      case 'p':
+        num_of_processes = atoi(optarg);
+        break;
+      default:
+        usage(myname);
+    }
+  }
+  argc -= optind;
+  argv += optind;
+  if (argc < 2 || job.sim_time <= 0 || step <= 0 || method_key < 1 || method_key > 19) {
+    usage(myname);
+  }
+  job.method = ensemble_methods[method_key - 1];
+  /* as in simulateSBML */
+  if (method_key == 13 || method_key == 14) {
+    job.dt = job.sim_time / step;
+  } else {
+    job.dt = delta * (job.sim_time / step);
+  }
+  job.print_interval = (int)(1/delta);
+
+  d = readSBML(argv[0]);
+  if (get_SBMLDocument_errorCode(d) != NoError) {
+    printf("Input file [%s] is not an appropriate SBML file\n", argv[0]);
+    exit(1);
+  }
+  job.m = SBMLDocument_getModel(d);
+  if ((job.points = read_points(argv[1])) == NULL) {
+    exit(1);
+  }
+  mySweepPoints_setSeed(job.points, seed);
+  num_of_points = job.points->num_of_points;
+  if (num_of_points == 0) {
+    printf("No points in [%s]\n", argv[1]);
+    exit(1);
+  }
+  for (i = 0; i < job.points->num_of_ids; i++) {
+    if (!sbmlsim_sweep_find_target(job.m, job.points->ids[i], &kind, &target, &value)) {
+      printf("Unknown Species, Parameter or Compartment ID [%s]\n", job.points->ids[i]);
+      exit(1);
+    }
+  }
+
+  /* a dead worker is seen through its pipes */
+  signal(SIGPIPE, SIG_IGN);
+  num_of_workers = sbmlsim_num_of_workers(num_of_processes, num_of_points);
+  workers = (ensemble_worker *)malloc(sizeof(ensemble_worker) * num_of_workers);
+  fds = (struct pollfd *)malloc(sizeof(struct pollfd) * num_of_workers);
+  for (i = 0; i < num_of_workers; i++) {
+    workers[i].pid = -1;
+  }
+  /* the layout is known after the first point, until then the parent
+   * keeps the outcome of the points */
+  error_codes = (int *)malloc(sizeof(int) * num_of_points);
+  signals = (int *)malloc(sizeof(int) * num_of_points);
+  point_times = (double *)malloc(sizeof(double) * num_of_points);
+  for (i = 0; i < num_of_points; i++) {
+    error_codes[i] = ENSEMBLE_NOT_RUN;
+    signals[i] = 0;
+    point_times[i] = my_nan();
+  }
+
+  start_time = sbmlsim_wall_time();
+  next_point = 0;
+  num_of_finished = 0;
+  rows_of_first = -1;
+  while (num_of_finished < num_of_points) {
+    /* start workers and hand out points to the idle ones */
+    num_of_alive = 0;
+    for (i = 0; i < num_of_workers; i++) {
+      if (workers[i].pid < 0 && next_point < num_of_points) {
+        if (!start_worker(&job, workers, num_of_workers, i)) {
+          perror("fork");
+          continue;
+        }
+      }
+      if (workers[i].pid < 0) {
+        continue;
+      }
+      if (workers[i].point < 0 && next_point < num_of_points) {
+        send_command(&workers[i], ENSEMBLE_RUN, next_point++);
+      }
+      if (workers[i].point >= 0) {
+        fds[num_of_alive].fd = workers[i].reply_fd;
+        fds[num_of_alive].events = POLLIN;
+        num_of_alive++;
+      }
+    }
+    if (num_of_alive == 0) {
+      fprintf(stderr, "No worker process could be started\n");
+      break;
+    }
+    if (poll(fds, num_of_alive, -1) < 0) {
+      if (errno == EINTR)
+        continue;
+      perror("poll");
+      break;
+    }
+    for (i = 0, j = 0; i < num_of_workers; i++) {
+      if (workers[i].pid < 0 || workers[i].point < 0) {
+        continue;
+      }
+      if (fds[j++].revents == 0) {
+        continue;
+      }
+      if (!read_full(workers[i].reply_fd, &reply, sizeof(reply))) {
+        /* the worker died in its point, skip the point */
+        reply.point = workers[i].point;
+        stop_worker(&workers[i], &status);
+        error_codes[reply.point] = SimulationFailed;
+        signals[reply.point] = WIFSIGNALED(status) ? WTERMSIG(status) : -1;
+        num_of_finished++;
+        fprintf(stderr, "point %d: worker %d %s %d\n", reply.point, i,
+            WIFSIGNALED(status) ? "killed by signal" : "exited with status",
+            WIFSIGNALED(status) ? WTERMSIG(status) : WEXITSTATUS(status));
+        continue;
+      }
+      if (workers[i].op == ENSEMBLE_RUN) {
+        point_times[reply.point] = reply.time;
+      }
+      if (workers[i].op == ENSEMBLE_STORE || reply.error_code != NoError) {
+        error_codes[reply.point] = reply.error_code;
+        workers[i].point = -1;
+        num_of_finished++;
+        continue;
+      }
+      /* simulated, the first point lays out the result file */
+      if (rows_of_first < 0) {
+        if (!create_result_file(&job, reply.num_of_rows)) {
+          fprintf(stderr, "Cannot create result file [%s]\n", job.file);
+          exit(1);
+        }
+        rows_of_first = reply.num_of_rows;
+      }
+      if (reply.num_of_rows != rows_of_first) {
+        error_codes[reply.point] = SimulationFailed;
+        workers[i].point = -1;
+        num_of_finished++;
+        continue;
+      }
+      send_command(&workers[i], ENSEMBLE_STORE, reply.point);
+    }
+  }
+
+  for (i = 0; i < num_of_workers; i++) {
+    if (workers[i].pid > 0) {
+      stop_worker(&workers[i], &status);
+    }
+  }
+
+  num_of_failed = 0;
+  num_of_crashed = 0;
+  for (i = 0; i < num_of_points; i++) {
+    if (error_codes[i] != NoError)
+      num_of_failed++;
+    if (signals[i] != 0)
+      num_of_crashed++;
+  }
+  if (job.map != NULL) {
+    memcpy(job.map + job.header->error_codes_offset, error_codes, sizeof(int) * num_of_points);
+    memcpy(job.map + job.header->signals_offset, signals, sizeof(int) * num_of_points);
+    memcpy(job.map + job.header->point_times_offset, point_times, sizeof(double) * num_of_points);
+    msync(job.map, (size_t)job.header->file_size, MS_SYNC);
+    munmap(job.map, (size_t)job.header->file_size);
+    close(job.fd);
+  } else {
+    fprintf(stderr, "No point succeeded, [%s] is not written\n", job.file);
+  }
+  printf("  %d points (%d failed, %d crashed) with %d processes in %g seconds\n",
+      num_of_points, num_of_failed, num_of_crashed, num_of_workers,
+      sbmlsim_wall_time() - start_time);
+
+  free(error_codes);
+  free(signals);
+  free(point_times);
+  free(fds);
+  free(workers);
+  free_mySweepPoints(job.points);
+  SBMLDocument_free(d);
+  return num_of_failed == num_of_points;
+}
@@ -13,6 +13,37 @@
  * ---------------------------------------------------------------------- -->*/
 #include "libsbmlsim/libsbmlsim.h"
 
+/* the equation which gives the value of name before the simulation
+ * starts (delay() of a time variant initial assignment or assignment
+ * rule), or NULL */
+static equation *get_explicit_delay_eq(Model_t *m, const char *name,
+    myInitialAssignment *initAssign[], char *time_variant_target_id[],
+    unsigned int num_of_time_variant_targets,
+    timeVariantAssignments *timeVarAssign) {
+  unsigned int j, k;
+  equation *explicit_delay_eq = NULL;
+
+  if(initAssign != NULL){
+    for(j=0; j<num_of_time_variant_targets; j++){
+      if(strcmp(time_variant_target_id[j], name) == 0){
+        for(k=0; k<Model_getNumInitialAssignments(m); k++){
+          if(strcmp(InitialAssignment_getSymbol(initAssign[k]->origin), name) == 0){
+            explicit_delay_eq = initAssign[k]->eq;
+          }
+        }
+      }
+    }
+  }
+  if(timeVarAssign != NULL){
+    for(j=0; j<timeVarAssign->num_of_time_variant_assignments; j++){
+      if(strcmp(timeVarAssign->target_id[j], name) == 0){
+        explicit_delay_eq = timeVarAssign->eq[j];
+      }
+    }
+  }
+  return explicit_delay_eq;
+}
+
 unsigned int get_equation(boolean is_variable_step,
     Model_t *m, equation *eq, mySpecies *sp[],
     myParameter *param[], myCompartment *comp[], myReaction *re[],
@@ -21,8 +52,7 @@ unsigned int get_equation(boolean is_variable_step,
     char *time_variant_target_id[], unsigned int num_of_time_variant_targets,
     timeVariantAssignments *timeVarAssign, allocated_memory *mem,
     int _print_interval) {
-  unsigned int i, j, k;
-  int flag;
+  unsigned int j;
   int op;
   unsigned int delay_val_length;
   const char *name;
@@ -30,6 +60,11 @@ unsigned int get_equation(boolean is_variable_step,
   ASTNode_t *left, *right, *comp_node;
   int width;
   int print_interval;
+  /* names are resolved with the symbol table of the model being prepared */
+  mySymbolTable *symbols = mySymbolTable_current();
+  mySymbol *symbol, *comp_symbol;
+  mySpeciesReference *ref;
+  myCompartment *delay_comp;
 
   if (is_variable_step) {
     eq->time_reverse_flag = 0;
@@ -54,224 +89,58 @@ unsigned int get_equation(boolean is_variable_step,
       left = ASTNode_getLeftChild(left);
     }
     name = ASTNode_getName(left);
-    flag = 1;
-    for(i=0; i<Model_getNumSpecies(m); i++){
-      if(strcmp(name, Species_getId(sp[i]->origin)) == 0){
-        /* create delay */
-        if (sp[i]->delay_val == NULL) {
-          delay_val_length = (unsigned int)(sim_time / (dt / print_interval) + 1);
-          mySpecies_initDelayVal(sp[i], delay_val_length, width);
+    symbol = mySymbolTable_find(symbols, name);
+    if(symbol != NULL){
+      /* create delay */
+      delay_val_length = (unsigned int)(sim_time / (dt / print_interval) + 1);
+      eq->number[index] = NULL;
+      eq->op[index] = 0;
+      eq->delay_comp_size[index] = NULL;
+      if(symbol->species != NULL){
+        if (symbol->species->delay_val == NULL) {
+          mySpecies_initDelayVal(symbol->species, delay_val_length, width);
         }
         if(comp_node != NULL){
           TRACE(("comp delay creation for species start\n"));
-          for(j=0; j<Model_getNumCompartments(m); j++){
-            if(strcmp(ASTNode_getName(comp_node), Compartment_getId(comp[j]->origin)) == 0){
-              if (comp[j]->delay_val == NULL) {
-                delay_val_length = (unsigned int)(sim_time / (dt / print_interval) + 1);
-                myCompartment_initDelayVal(comp[j], delay_val_length, width);
-              }
+          comp_symbol = mySymbolTable_find(symbols, ASTNode_getName(comp_node));
+          if(comp_symbol != NULL && comp_symbol->compartment != NULL){
+            delay_comp = comp_symbol->compartment;
+            if (delay_comp->delay_val == NULL) {
+              myCompartment_initDelayVal(delay_comp, delay_val_length, width);
             }
+            eq->delay_comp_size[index] = delay_comp->delay_val;
           }
-        }
-        TRACE(("comp delay creation for species finish\n"));
-        eq->number[index] = NULL;
-        eq->op[index] = 0;
-        eq->delay_number[index] = sp[i]->delay_val;
-        if(comp_node != NULL){
-          for(j=0; j<Model_getNumCompartments(m); j++){
-            if(strcmp(ASTNode_getName(comp_node), Compartment_getId(comp[j]->origin)) == 0){
-              eq->delay_comp_size[index] = comp[j]->delay_val;
-              break;
-            }
+          TRACE(("comp delay creation for species finish\n"));
+        }
+        eq->delay_number[index] = symbol->species->delay_val;
+      }else if(symbol->parameter != NULL){
+        if (symbol->parameter->delay_val == NULL) {
+          myParameter_initDelayVal(symbol->parameter, delay_val_length, width);
+        }
+        eq->delay_number[index] = symbol->parameter->delay_val;
+      }else if(symbol->compartment != NULL){
+        delay_comp = symbol->compartment;
+        if(delay_comp->delay_val == NULL){
+          delay_comp->delay_val = (double**)malloc(sizeof(double*)*delay_val_length);
+          for(j=0; j<delay_val_length; j++){
+            delay_comp->delay_val[j] = (double*)malloc(sizeof(double) * width);
           }
-        }else{
-          eq->delay_comp_size[index] = NULL;
         }
-        eq->explicit_delay_eq[index] = NULL;
-        if(initAssign != NULL){
-          for(j=0; j<num_of_time_variant_targets; j++){
-            if(strcmp(time_variant_target_id[j], name) == 0){
-              for(k=0; k<Model_getNumInitialAssignments(m); k++){
-                if(strcmp(InitialAssignment_getSymbol(initAssign[k]->origin), name) == 0){
-                  eq->explicit_delay_eq[index] = initAssign[k]->eq;
-                }
-              }
-            }
+        eq->delay_number[index] = delay_comp->delay_val;
+      }else{
+        ref = symbol->species_reference;
+        if(ref->delay_val == NULL){
+          ref->delay_val = (double**)malloc(sizeof(double*)*delay_val_length);
+          for(j=0; j<delay_val_length; j++){
+            ref->delay_val[j] = (double*)malloc(sizeof(double) * width);
           }
         }
-        if(timeVarAssign != NULL){
-          for(j=0; j<timeVarAssign->num_of_time_variant_assignments; j++){
-            if(strcmp(timeVarAssign->target_id[j], name) == 0){
-              eq->explicit_delay_eq[index] = timeVarAssign->eq[j];
-            }
-          }
-        }
-        index++;
-        flag = 0;
-        break;
-      }
-    }
-    if(flag){
-      for(i=0; i<Model_getNumParameters(m); i++){
-        if(strcmp(name, Parameter_getId(param[i]->origin)) == 0){
-          /* create delay */
-          if (param[i]->delay_val == NULL) {
-            delay_val_length = (unsigned int)(sim_time / (dt / print_interval) + 1);
-            myParameter_initDelayVal(param[i], delay_val_length, width);
-          }
-          eq->number[index] = NULL;
-          eq->op[index] = 0;
-          eq->delay_number[index] = param[i]->delay_val;
-          eq->delay_comp_size[index] = NULL;
-          eq->explicit_delay_eq[index] = NULL;
-          if(initAssign != NULL){
-            for(j=0; j<num_of_time_variant_targets; j++){
-              if(strcmp(time_variant_target_id[j], name) == 0){
-                for(k=0; k<Model_getNumInitialAssignments(m); k++){
-                  if(strcmp(InitialAssignment_getSymbol(initAssign[k]->origin), name) == 0){
-                    eq->explicit_delay_eq[index] = initAssign[k]->eq;
-                  }
-                }
-              }
-            }
-          }
-          if(timeVarAssign != NULL){
-            for(j=0; j<timeVarAssign->num_of_time_variant_assignments; j++){
-              if(strcmp(timeVarAssign->target_id[j], name) == 0){
-                eq->explicit_delay_eq[index] = timeVarAssign->eq[j];
-              }
-            }
-          }
-          index++;
-          flag = 0;
-          break;
-        }
-      }
-    }
-    if(flag){
-      for(i=0; i<Model_getNumCompartments(m); i++){
-        if(strcmp(name, Compartment_getId(comp[i]->origin)) == 0){
-          /* create delay */
-          if(comp[i]->delay_val == NULL){
-            comp[i]->delay_val = (double**)malloc(sizeof(double*)*(unsigned int)(sim_time / (dt / print_interval) + 1));
-            for(j=0; j<(unsigned int)(sim_time / (dt / print_interval) + 1); j++){
-              comp[i]->delay_val[j] = (double*)malloc(sizeof(double) * width);
-            }
-          }
-          eq->number[index] = NULL;
-          eq->op[index] = 0;
-          eq->delay_number[index] = comp[i]->delay_val;
-          eq->delay_comp_size[index] = NULL;
-          eq->explicit_delay_eq[index] = NULL;
-          if(initAssign != NULL){
-            for(j=0; j<num_of_time_variant_targets; j++){
-              if(strcmp(time_variant_target_id[j], name) == 0){
-                for(k=0; k<Model_getNumInitialAssignments(m); k++){
-                  if(strcmp(InitialAssignment_getSymbol(initAssign[k]->origin), name) == 0){
-                    eq->explicit_delay_eq[index] = initAssign[k]->eq;
-                  }
-                }
-              }
-            }
-          }
-          if(timeVarAssign != NULL){
-            for(j=0; j<timeVarAssign->num_of_time_variant_assignments; j++){
-              if(strcmp(timeVarAssign->target_id[j], name) == 0){
-                eq->explicit_delay_eq[index] = timeVarAssign->eq[j];
-              }
-            }
-          }
-          index++;
-          flag = 0;
-          break;
-        }
-      }
-    }
-    if(flag){
-      for(i=0; i<Model_getNumReactions(m); i++){
-        for(j=0; j<re[i]->num_of_products; j++){
-          if(SpeciesReference_isSetId(re[i]->products[j]->origin)
-              && strcmp(name, SpeciesReference_getId(re[i]->products[j]->origin)) == 0){
-            /* create delay */
-            if(re[i]->products[j]->delay_val == NULL){
-              re[i]->products[j]->delay_val = (double**)malloc(sizeof(double*)*(unsigned int)(sim_time / (dt / print_interval) + 1));
-              for(k=0; k<(unsigned int)(sim_time / (dt / print_interval) + 1); k++){
-                re[i]->products[j]->delay_val[k] = (double*)malloc(sizeof(double) * width);
-              }
-            }
-            eq->number[index] = NULL;
-            eq->op[index] = 0;
-            eq->delay_number[index] = re[i]->products[j]->delay_val;
-            eq->delay_comp_size[index] = NULL;
-            eq->explicit_delay_eq[index] = NULL;
-            if(initAssign != NULL){
-              for(k=0; k<num_of_time_variant_targets; k++){
-                if(strcmp(time_variant_target_id[k], name) == 0){
-                  for(k=0; k<Model_getNumInitialAssignments(m); k++){
-                    if(strcmp(InitialAssignment_getSymbol(initAssign[k]->origin), name) == 0){
-                      eq->explicit_delay_eq[index] = initAssign[k]->eq;
-                    }
-                  }
-                }
-              }
-            }
-            if(timeVarAssign != NULL){
-              for(k=0; k<timeVarAssign->num_of_time_variant_assignments; k++){
-                if(strcmp(timeVarAssign->target_id[k], name) == 0){
-                  eq->explicit_delay_eq[index] = timeVarAssign->eq[k];
-                }
-              }
-            }
-            index++;
-            flag = 0;
-            break;
-          }
-        }
-        if(!flag){
-          break;
-        }
-        for(j=0; j<re[i]->num_of_reactants; j++){
-          if(SpeciesReference_isSetId(re[i]->reactants[j]->origin)
-              && strcmp(name, SpeciesReference_getId(re[i]->reactants[j]->origin)) == 0){
-            /* create delay */
-            if(re[i]->reactants[j]->delay_val == NULL){
-              re[i]->reactants[j]->delay_val = (double**)malloc(sizeof(double*)*(unsigned int)(sim_time / (dt / print_interval) + 1));
-              for(k=0; k<(unsigned int)(sim_time / (dt / print_interval) + 1); k++){
-                re[i]->reactants[j]->delay_val[k] = (double*)malloc(sizeof(double) * width);
-              }
-            }
-            eq->number[index] = NULL;
-            eq->op[index] = 0;
-            eq->delay_number[index] = re[i]->reactants[j]->delay_val;
-            eq->delay_comp_size[index] = NULL;
-            eq->explicit_delay_eq[index] = NULL;
-            if(initAssign != NULL){
-              for(k=0; k<num_of_time_variant_targets; k++){
-                if(strcmp(time_variant_target_id[k], name) == 0){
-                  for(k=0; k<Model_getNumInitialAssignments(m); k++){
-                    if(strcmp(InitialAssignment_getSymbol(initAssign[k]->origin), name) == 0){
-                      eq->explicit_delay_eq[index] = initAssign[k]->eq;
-                    }
-                  }
-                }
-              }
-            }
-            if(timeVarAssign != NULL){
-              for(k=0; k<timeVarAssign->num_of_time_variant_assignments; k++){
-                if(strcmp(timeVarAssign->target_id[k], name) == 0){
-                  eq->explicit_delay_eq[index] = timeVarAssign->eq[k];
-                }
-              }
-            }
-            index++;
-            flag = 0;
-            break;
-          }
-        }
-        if(!flag){
-          break;
-        }
+        eq->delay_number[index] = ref->delay_val;
       }
+      eq->explicit_delay_eq[index] = get_explicit_delay_eq(m, name,
+          initAssign, time_variant_target_id, num_of_time_variant_targets,
+          timeVarAssign);
+      index++;
     }
   }else if((left=ASTNode_getLeftChild(node)) != NULL){
     index = get_equation(is_variable_step, m, eq, sp, param, comp, re, left, index, sim_time, dt, time, initAssign, time_variant_target_id, num_of_time_variant_targets, timeVarAssign, mem, print_interval);
@@ -291,99 +160,36 @@ unsigned int get_equation(boolean is_variable_step,
     index++;
   }else if(ASTNode_getType(node) == AST_NAME){
     name = ASTNode_getName(node);
-    flag = 1;
-    for(i=0; i<Model_getNumSpecies(m); i++){
-      if(strcmp(name, Species_getId(sp[i]->origin)) == 0){
-        eq->number[index] = &sp[i]->temp_value;
-        eq->op[index] = 0;
-        eq->delay_number[index] = NULL;
-        eq->delay_comp_size[index] = NULL;
-        eq->explicit_delay_eq[index] = NULL;
-        index++;
-        flag = 0;
-        break;
-      }
-    }
-    if(flag){
-      for(i=0; i<Model_getNumParameters(m); i++){
-        if(strcmp(name, Parameter_getId(param[i]->origin)) == 0){
-          eq->number[index] = &param[i]->temp_value;
-          eq->op[index] = 0;
-          eq->delay_number[index] = NULL;
-          eq->delay_comp_size[index] = NULL;
-          eq->explicit_delay_eq[index] = NULL;
-          index++;
-          flag = 0;
-          break;
-        }
-      }
-    }
-    if(flag){
-      for(i=0; i<Model_getNumCompartments(m); i++){
-        if(strcmp(name, Compartment_getId(comp[i]->origin)) == 0){
-          eq->number[index] = &comp[i]->temp_value;
-          eq->op[index] = 0;
-          eq->delay_number[index] = NULL;
-          eq->delay_comp_size[index] = NULL;
-          eq->explicit_delay_eq[index] = NULL;
-          index++;
-          flag = 0;
-          break;
-        }
-      }
-    }
-    if(flag){
-      for(i=0; i<Model_getNumReactions(m); i++){
-        for(j=0; j<re[i]->num_of_products; j++){
-          if(SpeciesReference_isSetId(re[i]->products[j]->origin)
-              && strcmp(name, SpeciesReference_getId(re[i]->products[j]->origin)) == 0){
-            eq->number[index] = &re[i]->products[j]->temp_value;
-            eq->op[index] = 0;
-            eq->delay_number[index] = NULL;
-            eq->delay_comp_size[index] = NULL;
-            eq->explicit_delay_eq[index] = NULL;
-            index++;
-            flag = 0;
-            break;
-          }
-        }
-        if(!flag){
-          break;
-        }
-        for(j=0; j<re[i]->num_of_reactants; j++){
-          if(SpeciesReference_isSetId(re[i]->reactants[j]->origin)
-              && strcmp(name, SpeciesReference_getId(re[i]->reactants[j]->origin)) == 0){
-            eq->number[index] = &re[i]->reactants[j]->temp_value;
-            eq->op[index] = 0;
-            eq->delay_number[index] = NULL;
-            eq->delay_comp_size[index] = NULL;
-            eq->explicit_delay_eq[index] = NULL;
-            index++;
-            flag = 0;
-            break;
-          }
-        }
-        if(!flag){
-          break;
-        }
+    symbol = mySymbolTable_find(symbols, name);
+    if(symbol != NULL){
+      if(symbol->species != NULL){
+        eq->number[index] = &symbol->species->temp_value;
+      }else if(symbol->parameter != NULL){
+        eq->number[index] = &symbol->parameter->temp_value;
+      }else if(symbol->compartment != NULL){
+        eq->number[index] = &symbol->compartment->temp_value;
+      }else{
+        eq->number[index] = &symbol->species_reference->temp_value;
       }
-    }
-    if(flag){
-      if(strcmp(name, "time") == 0
-          || strcmp(name, "t") == 0
-          || strcmp(name, "s") == 0){
-        if (is_variable_step) {
-          eq->number[index] = NULL;
-          eq->op[index] = AST_NAME_TIME;
-        } else {
-          eq->number[index] = time;
-          eq->op[index] = 0;
-        }
-        eq->delay_number[index] = NULL;
-        eq->delay_comp_size[index] = NULL;
-        eq->explicit_delay_eq[index] = NULL;
-        index++;
+      eq->op[index] = 0;
+      eq->delay_number[index] = NULL;
+      eq->delay_comp_size[index] = NULL;
+      eq->explicit_delay_eq[index] = NULL;
+      index++;
+    }else if(strcmp(name, "time") == 0
+        || strcmp(name, "t") == 0
+        || strcmp(name, "s") == 0){
+      if (is_variable_step) {
+        eq->number[index] = NULL;
+        eq->op[index] = AST_NAME_TIME;
+      } else {
+        eq->number[index] = time;
+        eq->op[index] = 0;
       }
+      eq->delay_number[index] = NULL;
+      eq->delay_comp_size[index] = NULL;
+      eq->explicit_delay_eq[index] = NULL;
+      index++;
     }
   }else if(ASTNode_getType(node) == AST_NAME_TIME){
     if (is_variable_step) {
@@ -60,6 +60,11 @@
 #define FINE_ABSOLUTE_ERROR_TOLERANCE 1.0e-22
 #define FINE_RELATIVE_ERROR_TOLERANCE 1.0e-11
 #define DEFAULT_FACMAX 2.0
+#define MAX_ROSENBROCK_STAGES 6
+/* below these numbers of reactions / variables, calc_k() / the jacobian
+ * of the implicit methods do not use threads */
+#define PARALLEL_RHS_MIN_REACTIONS 1000
+#define PARALLEL_JACOBIAN_MIN_VARIABLES 100
 #define DOUBLE_EQ(x, v) (((v - EPSIRON) < x) && (x < (v + EPSIRON)))
 
 #endif  /* LibSBMLSim_Common_h */
@@ -22,7 +22,8 @@ typedef enum {
   SBMLOperationFailed,
   InternalParserError,
   OutOfMemory,
-  SimulationFailed
+  SimulationFailed,
+  InvalidArgument
 } LibsbmlsimErrorCode;
 
 #endif  /* LibSBMLSim_ErrorCodes_h */
@@ -52,6 +52,8 @@ extern "C" {
 #include "typedefs.h"
 #include "equation.h"
 #include "myResult.h"
+#include "mySweep.h"
+#include "myBifurcation.h"
 #include "mySpecies.h"
 #include "mySpeciesReference.h"
 #include "myParameter.h"
@@ -62,14 +64,23 @@ extern "C" {
 #include "myInitialAssignment.h"
 #include "myRule.h"
 #include "myDelay.h"
+#include "mySymbolTable.h"
 #include "allocated_memory.h"
 #include "copied_AST.h"
+#include "ode_system.h"
+#include "parallel_rhs.h"
+#include "parallel_jacobian.h"
 #include "ast_memory_manager.h"
 
 #define DSFMT_MEXP 19937
 #include "dSFMT-params19937.h"
 #include "dSFMT.h"
 #include "dSFMT-params.h"
+#include "sbmlsim_context.h"
+#include "sbmlsim_model.h"
+#include "sbmlsim_model_cache.h"
+#include "sbmlsim_thread.h"
+#include "sbmlsim_dtoa.h"
 
 
 struct _timeVariantAssignments{
@@ -126,7 +137,6 @@ struct _myAlgTargetComp{
 /* Substitute kineticlaw local parameter node to simple Real value node in AST Tree
  * for efficient calculation) */
 void set_local_para_as_value(ASTNode_t *node, KineticLaw_t *kl);
-void set_local_para_as_value_forBA(ASTNode_t *node, KineticLaw_t *kl, char* bif_param_id, double bif_param_value);
 
 
 /* Get mathematical equations for calculation in reverse polish Notation */
@@ -142,18 +152,32 @@ double calcf(equation *eq, double dt, int cycle, double *reverse_time, int rk_or
 
 
 /* Calculate event equations written in reverse polish notation */
-void calc_event(myEvent *event[], unsigned int num_of_events, double dt, double time, int cycle, double *reverse_time);
+void calc_event(myEvent *event[], unsigned int num_of_events, double dt, double time, int cycle, double *reverse_time, sbmlsim_context *ctx);
 
-void calc_eventf(myEvent *event[], unsigned int num_of_events, double dt, double time, int cycle, double *reverse_time, myResult* res, int print_interval, int* err_zero_flag);
+void calc_eventf(myEvent *event[], unsigned int num_of_events, double dt, double time, int cycle, double *reverse_time, myResult* res, int print_interval, int* err_zero_flag, sbmlsim_context *ctx);
 
-void recursive_calc_event(myEvent *event[], unsigned int num_of_events, myEvent *event_buf[], unsigned int *num_of_remained_events, double *assignment_values_from_trigger_time[], double dt, double time, int cycle, double *reverse_time);
+void recursive_calc_event(myEvent *event[], unsigned int num_of_events, myEvent *event_buf[], unsigned int *num_of_remained_events, double *assignment_values_from_trigger_time[], double dt, double time, int cycle, double *reverse_time, sbmlsim_context *ctx);
 
-void recursive_calc_eventf(myEvent *event[], unsigned int num_of_events, myEvent *event_buf[], unsigned int *num_of_remained_events, double *assignment_values_from_trigger_time[], double dt, double time, int cycle, double *reverse_time, myResult* res, int print_interval, int* err_zero_flag);
+void recursive_calc_eventf(myEvent *event[], unsigned int num_of_events, myEvent *event_buf[], unsigned int *num_of_remained_events, double *assignment_values_from_trigger_time[], double dt, double time, int cycle, double *reverse_time, myResult* res, int print_interval, int* err_zero_flag, sbmlsim_context *ctx);
 
 /* numerical integration by explicit method(Runge Kutta and Adams-Bashforth) */
-myResult* simulate_explicit(Model_t *m, myResult *result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int order, int print_amount, allocated_memory *mem);
+myResult* simulate_explicit(Model_t *m, myResult *result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int order, int print_amount, allocated_memory *mem, sbmlsim_context *ctx);
 
-myResult* simulate_explicitf(Model_t *m, myResult* result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int order, int print_amount, allocated_memory *mem, double atol, double rtol, double facmax, copied_AST *cp_AST, int* err_zero_flag);
+myResult* simulate_explicitf(Model_t *m, myResult* result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int order, int print_amount, allocated_memory *mem, sbmlsim_context *ctx, double atol, double rtol, double facmax, copied_AST *cp_AST, int* err_zero_flag);
+
+/* numerical integration by Dormand-Prince 5(4) with dense output [for variable stepsize] */
+myResult* simulate_dopri(Model_t *m, myResult *result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int print_amount, allocated_memory *mem, sbmlsim_context *ctx, double atol, double rtol, double facmax);
+
+/* one Dormand-Prince step from (t, y) with k[0] = f(t, y), k must have 7 vectors.
+ * ynew <- y(t+h), k[6] <- f(t+h, ynew), returns the error norm, or -1 if f can not be evaluated */
+double dopri_step(ode_system *sys, double t, double h, const double *y, double **k, double *ynew, double *ystage, double *yerr, double atol, double rtol);
+/* coefficients r[0..4] of continuous extension for the accepted step */
+void dopri_dense_output(unsigned int n, double h, const double *y, const double *ynew, double **k, double **r);
+void dopri_interpolate(double **r, unsigned int n, double theta, double *y);
+/* y(t) of the continuous extension, data is dopri_dense (ode_interpolant for ode_system_locate_event()) */
+void dopri_dense_interpolate(void *data, double t, double *y);
+/* h*|lambda| of the dominant eigenvalue estimated from the last stages (Hairer and Wanner, IV.2) */
+double dopri_stiffness(unsigned int n, double h, double **k, const double *ynew, const double *ystage);
 
 /* count the number of ODE [for variable stepsize] */
 int count_ode(mySpecies* sp[], unsigned int num_of_species, int* ode_check, Species_t* s);
@@ -167,15 +191,29 @@ int lu_decomposition(double **A, int *p, int N);
 int lu_solve(double **A, int *p, int N, double *b);
 
 /* numerical integration by implicit method(Adams-Moulton and Backward-Difference) */
-myResult* simulate_implicit(Model_t *m, myResult *result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int order, int use_lazy_method, int print_amount, allocated_memory *mem);
+double calc_implicit_formula(int order, double x1, double x2, double x3, double x4, double x5, double k1, double k2, double k3, double k4, double dt);
+myResult* simulate_implicit(Model_t *m, myResult *result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int order, int use_lazy_method, int print_amount, allocated_memory *mem, sbmlsim_context *ctx);
+
+/* numerical integration by variable-step, variable-order Backward-Difference (BDF 1-5) */
+myResult* simulate_bdf(Model_t *m, myResult *result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int print_amount, allocated_memory *mem, sbmlsim_context *ctx, double atol, double rtol);
+
+/* numerical integration by linearly implicit Rosenbrock method (RODAS3 and RODAS4) */
+myResult* simulate_rosenbrock(Model_t *m, myResult *result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int order, int print_amount, allocated_memory *mem, sbmlsim_context *ctx, double atol, double rtol, double facmax);
+
+/* one Rosenbrock step from (t, y), f0, jacobian and dfdt must be evaluated at (t, y),
+ * u must have MAX_ROSENBROCK_STAGES vectors. returns the error norm, or -1 if the matrix is singular
+ * or f can not be evaluated */
+double rosenbrock_step(ode_system *sys, int order, double t, double h, const double *y, const double *f0, double **jacobian, const double *dfdt, double **ros_matrix, int *p, double **u, double *ytmp, double *fs, double *ynew, double *yerr, double atol, double rtol);
+/* dfdt <- df/dt at (t, y) by numerical differentiation, f0 must be f(t, y) (returns 0 on failure) */
+int rosenbrock_time_derivative(ode_system *sys, double t, const double *y, const double *f0, double *dfdt);
+
+/* numerical integration with automatic switching between Dormand-Prince and RODAS4 */
+myResult* simulate_auto(Model_t *m, myResult *result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int print_amount, allocated_memory *mem, sbmlsim_context *ctx, double atol, double rtol, double facmax);
 
 /** util.c **/
 /* get end_cycle */
 int get_end_cycle(double sim_time, double dt);
 
-/* set seed for random */
-void set_seed(void);
-
 /* my_time function. We created this function because we can't use time() and variable time in the same file. Argh... */
 time_t my_time(time_t* tloc);
 
@@ -202,6 +240,39 @@ SBMLSIM_EXPORT const char *myResult_getErrorMessage(myResult *result);
 SBMLSIM_EXPORT void free_myResult(myResult *res);
 SBMLSIM_EXPORT void __free_myResult(myResult *res);
 
+/* points of a parameter sweep (see mySweep.h) */
+SBMLSIM_EXPORT mySweepPoints *create_mySweepPoints(void);
+SBMLSIM_EXPORT void free_mySweepPoints(mySweepPoints *points);
+/* add (or find) the column of id, returns its index */
+SBMLSIM_EXPORT int mySweepPoints_addId(mySweepPoints *points, const char *id);
+/* add a point which keeps all values in the model, returns its index */
+SBMLSIM_EXPORT int mySweepPoints_addPoint(mySweepPoints *points);
+/* return 0 if point or index is out of range */
+SBMLSIM_EXPORT int mySweepPoints_setValue(mySweepPoints *points, int point, int index, double value);
+SBMLSIM_EXPORT double mySweepPoints_getValue(mySweepPoints *points, int point, int index);
+/* cost hint of point for the scheduler, return 0 if point is out of range */
+SBMLSIM_EXPORT int mySweepPoints_setCost(mySweepPoints *points, int point, double cost);
+/* seed of the random numbers of the sweep */
+SBMLSIM_EXPORT void mySweepPoints_setSeed(mySweepPoints *points, unsigned int seed);
+/* use point_times of a previous sweep over the same points as cost hints */
+SBMLSIM_EXPORT int mySweepPoints_setCostsFromResult(mySweepPoints *points, mySweepResult *result);
+
+/* create mySweepResult object, names, time and layout are taken from first */
+mySweepResult *create_mySweepResult(myResult *first, int num_of_points);
+mySweepResult *create_mySweepResult_with_error(LibsbmlsimErrorCode code, const char *message);
+mySweepResult *create_mySweepResult_with_errorCode(LibsbmlsimErrorCode code);
+/* copy the values of res to the rows of point */
+void mySweepResult_store(mySweepResult *result, int point, myResult *res);
+
+/* return 1 if error (i.e. all points failed) */
+SBMLSIM_EXPORT int mySweepResult_isError(mySweepResult *result);
+SBMLSIM_EXPORT const char *mySweepResult_getErrorMessage(mySweepResult *result);
+/* copy the result of point to a new myResult (e.g. for write_csv) */
+SBMLSIM_EXPORT myResult *mySweepResult_getResult(mySweepResult *result, int point);
+/* busy time of worker / elapsed time of the sweep */
+SBMLSIM_EXPORT double mySweepResult_getWorkerUtilization(mySweepResult *result, int worker);
+SBMLSIM_EXPORT void free_mySweepResult(mySweepResult *result);
+
 /* create my SBML obejects for efficient simulations */
 void create_mySBML_objects(boolean is_variable_step,
     Model_t *m, mySpecies *mySp[], myParameter *myParam[],
@@ -218,13 +289,6 @@ void create_mySBML_objectsf(boolean is_variable_step, Model_t *m, mySpecies
     timeVariantAssignments **timeVarAssign, double sim_time, double dt,
     double *time, allocated_memory *mem, copied_AST *cp_AST, int print_interval);
 
-void create_mySBML_objects_forBA(Model_t *m, mySpecies *mySp[], myParameter *myParam[],
-    myCompartment *myComp[], myReaction *myRe[], myRule *myRu[], myEvent *myEv[],
-    myInitialAssignment *myInitAssign[], myAlgebraicEquations **myAlgEq,
-    timeVariantAssignments **timeVarAssign,
-    double sim_time, double dt, double *time, allocated_memory *mem,
-    copied_AST *cp_AST, char* bif_param_id, double bif_param_value);
-
 /* free time_variant_target_id */
 void free_time_variant_target_id(char** time_variant_target_id);
 
@@ -252,12 +316,18 @@ FILE* my_fopen(FILE* fp, const char* file, char* mode);
 SBMLSIM_EXPORT void print_result(myResult* result);
 SBMLSIM_EXPORT void write_result(myResult* result, const char* file);
 SBMLSIM_EXPORT void write_csv(myResult* result, const char* file);
+SBMLSIM_EXPORT void write_tsv(myResult* result, const char* file);
+/* column-major float64 (or float32) values, to be mapped in memory */
+SBMLSIM_EXPORT void write_binary(myResult* result, const char* file, int use_float32);
+SBMLSIM_EXPORT myResult* read_binary(const char* file);
+/* parameter value, local maximum and local minimum of each point */
+SBMLSIM_EXPORT void write_bifurcation_csv(myBifurcationResult* result, const char* file);
 void print_result_to_file(myResult* result, const char* file, char delimiter);
 void output_result(myResult* result, FILE* fp, char delimiter);
 SBMLSIM_EXPORT void write_separate_result(myResult* result, const char* file_s, const char* file_p, const char* file_c); 
 
 /* calc k(gradient or value of algebraic or assignment rule) */
-void calc_k(mySpecies *sp[], unsigned int sp_num, myParameter *param[], unsigned int param_num, myCompartment *comp[], unsigned int comp_num, mySpeciesReference *spr[], unsigned int spr_num, myReaction *re[], unsigned int re_num, myRule *rule[], unsigned int rule_num, int cycle, double dt, double *reverse_time, int use_rk, int call_first_time_in_cycle);
+void calc_k(mySpecies *sp[], unsigned int sp_num, myParameter *param[], unsigned int param_num, myCompartment *comp[], unsigned int comp_num, mySpeciesReference *spr[], unsigned int spr_num, myReaction *re[], unsigned int re_num, myRule *rule[], unsigned int rule_num, int cycle, double dt, double *reverse_time, int use_rk, int call_first_time_in_cycle, sbmlsim_context *ctx);
 
 void calc_kf(mySpecies *sp[], unsigned int sp_num, myParameter *param[], unsigned int param_num, myCompartment *comp[], unsigned int comp_num, mySpeciesReference *spr[], unsigned int spr_num, myReaction *re[], unsigned int re_num, myRule *rule[], unsigned int rule_num, int cycle, double dt, double *reverse_time, int use_rk, int call_first_time_in_cycle, double* time, myResult* res, myAlgebraicEquations *algEq, int print_interval, int* err_zero_flag, int order);
 
@@ -293,6 +363,7 @@ boolean str_is_number(const char *str);
 void chomp(char *str);
 
 /* Alter the AST structure for calculation */
+Species_t *find_species_of_name(Model_t *m, const char *name);
 void alter_tree_structure(Model_t *m, ASTNode_t **node_p, ASTNode_t *parent, int child_order, copied_AST *cp_AST);
 
 /* Checker for reverse polish notation */
@@ -366,28 +437,40 @@ void prg_printf(const char *fmt, ...);
 /* Run Simulation from SBML Model */
 SBMLSIM_EXPORT myResult* simulateSBMLModel(Model_t *m, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method, double atol, double rtol, double facmax);
 
+/* Run Simulation from SBML Model in the given context (see sbmlsim_context.h) */
+SBMLSIM_EXPORT myResult* simulateSBMLModelWithContext(sbmlsim_context *ctx, Model_t *m, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method, double atol, double rtol, double facmax);
+
+/* map the first error of the document to LibsbmlsimErrorCode */
+LibsbmlsimErrorCode get_SBMLDocument_errorCode(SBMLDocument_t *d);
+
+/* Run Simulation of every point of the sweep from SBML Model with
+ * num_of_threads threads (0: number of processors) */
+SBMLSIM_EXPORT mySweepResult* simulateSBMLModelSweep(Model_t *m, mySweepPoints *points, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method, double atol, double rtol, double facmax, int num_of_threads);
+
+/* Run Simulation of every point of the sweep from SBML string */
+SBMLSIM_EXPORT mySweepResult* simulateSBMLFromStringSweep(const char* str, mySweepPoints *points, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method, int num_of_threads);
+
+/* Run Simulation of every point of the sweep from SBML file */
+SBMLSIM_EXPORT mySweepResult* simulateSBMLFromFileSweep(const char* file, mySweepPoints *points, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method, int num_of_threads);
+
 /* Run Simulation from SBML string */
 SBMLSIM_EXPORT myResult* simulateSBMLFromString(const char* str, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method);
 
 /* Run Simulation from SBML file */
 SBMLSIM_EXPORT myResult* simulateSBMLFromFile(const char* file, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method);
 
-/* Bifurcation Analysis mode */
-myResult* bifurcation_analysis(Model_t *m, double sim_time, double dt,
-    int print_interval, double time, int order, int print_amount,
-    int use_lazy_method, int is_explicit,
-    unsigned int num_of_species, unsigned int num_of_parameters,
-    unsigned int num_of_compartments, unsigned int num_of_reactions,
-    unsigned int num_of_rules, unsigned int num_of_events,
-    unsigned int num_of_initialAssignments,
-    mySpecies* mySp[], myParameter* myParam[], myCompartment* myComp[],
-    myReaction* myRe[], myRule* myRu[], myEvent* myEv[],
-    myInitialAssignment* myInitAssign[], myAlgebraicEquations* myAlgEq,
-    timeVariantAssignments* timeVarAssign,
-    allocated_memory* mem, copied_AST* cp_AST,
-    myResult* result, myResult* rtn, boolean bif_param_is_local, char* sta_var_id,
-    char* bif_param_id, double bif_param_min, double bif_param_max,
-    double bif_param_stepsize, double transition_time);
+/* Bifurcation Analysis: local maximum and minimum of the species sta_var_id
+ * after transition_time for bif_param_min, bif_param_min + bif_param_stepsize,
+ * ..., bif_param_max of the (global or local) parameter bif_param_id, with
+ * num_of_threads threads (0: number of processors) */
+SBMLSIM_EXPORT myBifurcationResult* analyzeBifurcationSBMLModel(Model_t *m, const char *sta_var_id, const char *bif_param_id, double bif_param_min, double bif_param_max, double bif_param_stepsize, double transition_time, double sim_time, double dt, int print_interval, int method, int use_lazy_method, int num_of_threads);
+SBMLSIM_EXPORT myBifurcationResult* analyzeBifurcationSBMLFromString(const char *str, const char *sta_var_id, const char *bif_param_id, double bif_param_min, double bif_param_max, double bif_param_stepsize, double transition_time, double sim_time, double dt, int print_interval, int method, int use_lazy_method, int num_of_threads);
+SBMLSIM_EXPORT myBifurcationResult* analyzeBifurcationSBMLFromFile(const char *file, const char *sta_var_id, const char *bif_param_id, double bif_param_min, double bif_param_max, double bif_param_stepsize, double transition_time, double sim_time, double dt, int print_interval, int method, int use_lazy_method, int num_of_threads);
+
+/* return 1 if error */
+SBMLSIM_EXPORT int myBifurcationResult_isError(myBifurcationResult *result);
+SBMLSIM_EXPORT const char *myBifurcationResult_getErrorMessage(myBifurcationResult *result);
+SBMLSIM_EXPORT void free_myBifurcationResult(myBifurcationResult *result);
 
 /*for variable step-size integration */
 /* calculate the solution in the past by linear approximation */
@@ -412,6 +495,7 @@ double my_asinh(double x);
 double my_acosh(double x);
 double my_atanh(double x);
 int my_isnan(double x);
+double my_nan(void);
 #if defined(_MSC_VER) || defined(__STRICT_ANSI__)
 double s_log1p(double x);
 double __ieee754_acosh(double x);
@@ -27,6 +27,7 @@
 #define MTHD_RUNGE_KUTTA 41
 #define MTHD_RUNGE_KUTTA_FEHLBERG_5 51
 #define MTHD_CASH_KARP 61
+#define MTHD_DORMAND_PRINCE 71
 
 
 /* Implicit methods */
@@ -38,6 +39,12 @@
 #define MTHD_BACKWARD_DIFFERENCE_2 40
 #define MTHD_BACKWARD_DIFFERENCE_3 50
 #define MTHD_BACKWARD_DIFFERENCE_4 60
+#define MTHD_ADAPTIVE_BACKWARD_DIFFERENCE 70
+#define MTHD_ROSENBROCK_3 80
+#define MTHD_ROSENBROCK_4 90
+
+/* Automatic switching between explicit and implicit methods */
+#define MTHD_AUTO_SWITCHING 81
 
 /* Name for explicit methods */
 #define MTHD_NAME_EULER "Euler"
@@ -48,6 +55,7 @@
 #define MTHD_NAME_RUNGE_KUTTA "4th order Runge-Kutta"
 #define MTHD_NAME_RUNGE_KUTTA_FEHLBERG_5 "5th order Runge-Kutta-Fehlberg"
 #define MTHD_NAME_CASH_KARP "5th order Cash-Karp"
+#define MTHD_NAME_DORMAND_PRINCE "5th order Dormand-Prince"
 
 /* Name for implicit methods */
 #define MTHD_NAME_BACKWARD_EULER "Backward-Euler"
@@ -58,5 +66,11 @@
 #define MTHD_NAME_BACKWARD_DIFFERENCE_2 "2nd order Backward Difference"
 #define MTHD_NAME_BACKWARD_DIFFERENCE_3 "3rd order Backward Difference"
 #define MTHD_NAME_BACKWARD_DIFFERENCE_4 "4th order Backward Difference"
+#define MTHD_NAME_ADAPTIVE_BACKWARD_DIFFERENCE "Variable-order Backward Difference"
+#define MTHD_NAME_ROSENBROCK_3 "3rd order Rosenbrock"
+#define MTHD_NAME_ROSENBROCK_4 "4th order Rosenbrock"
+
+/* Name for automatic switching methods */
+#define MTHD_NAME_AUTO_SWITCHING "Auto-switching Dormand-Prince/Rosenbrock"
 
 #endif  /* LibSBMLSim_Methods_h */
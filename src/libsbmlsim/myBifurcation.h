@@ -0,0 +1,39 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#ifndef LibSBMLSim_MyBifurcation_h
+#define LibSBMLSim_MyBifurcation_h
+
+#include "errorcodes.h"
+
+/* Result of bifurcation analysis. For each value of the bifurcation
+ * parameter, the local maximum and minimum of the state variable
+ * (a species) after the transition time. The values of a failed point
+ * are NaN. */
+typedef struct myBifurcationResult {
+  LibsbmlsimErrorCode error_code;
+  const char *error_message;
+  const char *variable_id;
+  const char *parameter_id;
+  int num_of_points;
+  double *parameter_values;
+  double *local_max;
+  double *local_min;
+  /* NoError, or the error of each point */
+  LibsbmlsimErrorCode *point_error_codes;
+  /* number of threads and seconds of the analysis */
+  int num_of_threads;
+  double elapsed_time;
+} myBifurcationResult;
+
+#endif /* LibSBMLSim_MyBifurcation_h */
@@ -36,12 +36,7 @@ myEventAssignment *myEventAssignment_create();
 void myEventAssignment_initWithEvent(myEventAssignment *assign, Event_t *event, int index);
 void myEventAssignment_free(myEventAssignment *assign);
 
-void myEventAssignment_initTarget(
-    myEventAssignment *assign,
-    mySpecies **species, unsigned int num_of_species,
-    myParameter **parameters, unsigned int num_of_parameters,
-    myCompartment **compartments, unsigned int num_of_compartments,
-    myReaction **reactions, unsigned int num_of_reactions);
+void myEventAssignment_initTarget(myEventAssignment *assign, mySymbolTable *symbols);
 
 EventAssignment_t *myEventAssignment_getOrigin(myEventAssignment *assign);
 void myEventAssignment_setTargetSpecies(myEventAssignment *assign, mySpecies *species);
@@ -36,14 +36,7 @@ struct _myInitialAssignment {
 myInitialAssignment *myInitialAssignment_create();
 void myInitialAssignment_initWithModel(myInitialAssignment *assign, Model_t *model, int index);
 void myInitialAssignment_free(myInitialAssignment *assign);
-void myInitialAssignment_initTarget(
-    myInitialAssignment *assign,
-    mySpecies **species, unsigned int num_of_species,
-    myParameter **parameters, unsigned int num_of_parameters,
-    myCompartment **compartments, unsigned int num_of_compartments);
-void myInitialAssignment_initTargetSpeciesReference(
-    myInitialAssignment *assign,
-    myReaction **reactions, unsigned int num_of_reactions);
+void myInitialAssignment_initTarget(myInitialAssignment *assign, mySymbolTable *symbols);
 
 InitialAssignment_t *myInitialAssignment_getOrigin(myInitialAssignment *assign);
 void myInitialAssignment_setTargetSpecies(myInitialAssignment *assign, mySpecies *species);
@@ -39,8 +39,8 @@ char traverse(const ASTNode_t *node, Reaction_t* r, char flag);
 boolean Reaction_getReversibleFromMath(Reaction_t *r);
 void myReaction_free(myReaction *reaction);
 
-void myReaction_initProducts(myReaction *reaction, mySpecies **species, unsigned int num_of_species);
-void myReaction_initReactants(myReaction *reaction, mySpecies **species, unsigned int num_of_species);
+void myReaction_initProducts(myReaction *reaction, mySymbolTable *symbols);
+void myReaction_initReactants(myReaction *reaction, mySymbolTable *symbols);
 
 Reaction_t *myReaction_getOrigin(myReaction *reaction);
 void myReaction_addProduct(myReaction *reaction, mySpeciesReference *product);
@@ -34,6 +34,19 @@ typedef struct myResult{
 	/* new code*/
   double* values_time_fordelay;
   int num_of_delay_rows;
+  /* statistics of the adaptive step size integrators */
+  int num_of_steps;
+  int num_of_rejected_steps;
+  int num_of_rhs_evaluations;
+  int num_of_jacobian_evaluations;
+  int num_of_lu_decompositions;
+  int num_of_stiff_steps;
+  int num_of_method_switches;
+  /* wall time (seconds) spent reading the SBML, preparing the objects
+   * (or restoring their state, for a prepared model) and simulating */
+  double read_time;
+  double prepare_time;
+  double simulation_time;
 } myResult;
 
 #endif /* LibSBMLSim_MyResult_h */
@@ -40,12 +40,7 @@ myRule *myRule_create();
 void myRule_initWithModel(myRule *rule, Model_t *model, int index);
 void myRule_free(myRule *rule);
 
-void myRule_initTarget(
-    myRule *rule,
-    mySpecies **species, unsigned int num_of_species,
-    myParameter **parameters, unsigned int num_of_parameters,
-    myCompartment **compartments, unsigned int num_of_compartments,
-    myReaction **reactions, unsigned int num_of_reactions);
+void myRule_initTarget(myRule *rule, mySymbolTable *symbols);
 
 Rule_t *myRule_getOrigin(myRule *rule);
 void myRule_setTargetSpecies(myRule *rule, mySpecies *species);
@@ -0,0 +1,70 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#ifndef LibSBMLSim_MySweep_h
+#define LibSBMLSim_MySweep_h
+
+#include "errorcodes.h"
+#include "myResult.h"
+#include "sbmlsim_scheduler.h"
+
+/* Points of a parameter sweep. Each point overrides the value of global
+ * parameters, the size of compartments and the initial value (amount or
+ * concentration, whichever is set in the model) of species given by ids.
+ * NaN keeps the value in the model. */
+typedef struct mySweepPoints {
+  int num_of_ids;
+  char **ids;
+  int num_of_points;
+  double *values; /* num_of_points x num_of_ids */
+  int capacity; /* number of points allocated for values */
+  /* relative costs of the points for the scheduler (e.g. point_times
+   * of a previous sweep), NULL if unknown */
+  double *costs;
+  /* seed of the random numbers, point p uses the stream p of the seed
+   * (see sbmlsim_context_seed_stream()), 0 by default */
+  unsigned int seed;
+} mySweepPoints;
+
+/* Results of all points of a parameter sweep in one block. All points
+ * share the time column, values of point p at row r are
+ * values[(p * num_of_rows + r) * num_of_columns + c], where the columns
+ * are species, parameters and compartments (in this order). */
+typedef struct mySweepResult {
+  LibsbmlsimErrorCode error_code;
+  const char *error_message;
+  int num_of_points;
+  int num_of_rows;
+  int num_of_columns;
+  int num_of_columns_sp;
+  int num_of_columns_param;
+  int num_of_columns_comp;
+  const char *column_name_time;
+  const char **column_name_sp;
+  const char **column_name_param;
+  const char **column_name_comp;
+  double *values_time;
+  double *values;
+  /* NoError, or the error of each point (whose values are NaN) */
+  LibsbmlsimErrorCode *point_error_codes;
+  /* number of threads (workers) of the sweep */
+  int num_of_threads;
+  /* seconds spent in each point */
+  double *point_times;
+  /* seconds of the whole sweep, and statistics of each worker
+   * (busy_time / elapsed_time is the utilisation of the worker) */
+  double elapsed_time;
+  sbmlsim_worker_stats *worker_stats;
+} mySweepResult;
+
+#endif /* LibSBMLSim_MySweep_h */
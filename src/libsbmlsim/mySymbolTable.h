@@ -0,0 +1,61 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#ifndef LibSBMLSim_MySymbolTable_h
+#define LibSBMLSim_MySymbolTable_h
+
+#include "typedefs.h"
+
+/* An id of the model and the object it names; only one of the objects
+ * is set. index is the position of the object in its array (of the
+ * species, parameters or compartments), or of its reaction */
+struct _mySymbol {
+  const char *id;
+  unsigned int index;
+  mySpecies *species;
+  myParameter *parameter;
+  myCompartment *compartment;
+  mySpeciesReference *species_reference;
+};
+
+/* Hash table of the ids of the species, parameters, compartments and
+ * species references of a model, so that the preparation of the model
+ * resolves a name in constant time instead of comparing it with every
+ * id. If an id is added twice, the first object is kept (an id is
+ * looked up in the species first, as get_equation() always did). */
+struct _mySymbolTable {
+  mySymbol *symbols;
+  unsigned int capacity; /* power of 2 */
+  unsigned int num_of_symbols;
+};
+
+mySymbolTable *mySymbolTable_create(void);
+void mySymbolTable_free(mySymbolTable *table);
+
+void mySymbolTable_addSpecies(mySymbolTable *table, mySpecies **species, unsigned int num_of_species);
+void mySymbolTable_addParameters(mySymbolTable *table, myParameter **parameters, unsigned int num_of_parameters);
+void mySymbolTable_addCompartments(mySymbolTable *table, myCompartment **compartments, unsigned int num_of_compartments);
+/* the species references with an id */
+void mySymbolTable_addSpeciesReferences(mySymbolTable *table, myReaction **reactions, unsigned int num_of_reactions);
+
+/* the symbol of id, or NULL */
+mySymbol *mySymbolTable_find(mySymbolTable *table, const char *id);
+
+/* get_equation() and connect_delayval_with_eq() resolve names with the
+ * table attached to the calling thread by the preparation
+ * (create_mySBML_objects(), realloc_mySBML_objects()). attach returns
+ * the table which was attached before, to be restored at the end */
+mySymbolTable *mySymbolTable_attach(mySymbolTable *table);
+mySymbolTable *mySymbolTable_current(void);
+
+#endif /* LibSBMLSim_MySymbolTable_h */
@@ -0,0 +1,161 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#ifndef LibSBMLSim_OdeSystem_h
+#define LibSBMLSim_OdeSystem_h
+
+#include "typedefs.h"
+#include "boolean.h"
+#include "myResult.h"
+#include <sbml/SBMLTypes.h>
+
+/* View of the mySBML objects as a flat ODE system y' = f(t, y), used by
+ * the adaptive step size integrators (BDF, Dormand-Prince, Rosenbrock).
+ * The state vector y is the list of variables which are NOT changed by
+ * assignment nor algebraic rule (var_sp, var_param, var_comp, var_spr,
+ * in this order), and f is evaluated with calc_k(). */
+struct _ode_system {
+  Model_t *m;
+  /* all SBML objects */
+  mySpecies **sp;
+  myParameter **param;
+  myCompartment **comp;
+  myReaction **re;
+  myRule **rule;
+  myEvent **event;
+  myAlgebraicEquations *algEq;
+  /* random numbers and work area of calc_event() */
+  sbmlsim_context *ctx;
+  unsigned int num_of_species;
+  unsigned int num_of_parameters;
+  unsigned int num_of_compartments;
+  unsigned int num_of_reactions;
+  unsigned int num_of_rules;
+  unsigned int num_of_events;
+  /* all variables (whose quantity is not a constant) */
+  mySpecies **all_var_sp;
+  myParameter **all_var_param;
+  myCompartment **all_var_comp;
+  mySpeciesReference **all_var_spr;
+  unsigned int num_of_all_var_species;
+  unsigned int num_of_all_var_parameters;
+  unsigned int num_of_all_var_compartments;
+  unsigned int num_of_all_var_species_reference;
+  /* variables (which is NOT changed by assignment nor algebraic rule) */
+  mySpecies **var_sp;
+  myParameter **var_param;
+  myCompartment **var_comp;
+  mySpeciesReference **var_spr;
+  unsigned int num_of_var_species;
+  unsigned int num_of_var_parameters;
+  unsigned int num_of_var_compartments;
+  unsigned int num_of_var_species_reference;
+  unsigned int num_of_vars; /* dimension of y */
+  /* y holds the amount (not the concentration) of var_sp[i] whose
+   * compartment size is not a constant */
+  boolean *is_scaled_species;
+  /* time and arguments for calc() */
+  double *time;
+  double reverse_time;
+  double dt;
+  int cycle;
+  /* work area */
+  double **coefficient_matrix;
+  double *constant_vector;
+  int *alg_pivot;
+  double *work_y;
+  double *work_f;
+  double *snapshot;
+  /* value of event triggers after the last ode_system_calc_discontinuity() */
+  boolean *trigger_values;
+  /* statistics */
+  unsigned int num_of_steps;
+  unsigned int num_of_rejected_steps;
+  unsigned int num_of_rhs_evaluations;
+  unsigned int num_of_jacobian_evaluations;
+  unsigned int num_of_lu_decompositions;
+  unsigned int num_of_stiff_steps; /* steps taken by the implicit method in auto-switching mode */
+  unsigned int num_of_method_switches;
+};
+
+/* return true if the model refers to past values by delay() */
+boolean has_delay_val(mySpecies *sp[], unsigned int num_of_species, myParameter *param[], unsigned int num_of_parameters, myCompartment *comp[], unsigned int num_of_compartments, myReaction *re[], unsigned int num_of_reactions);
+
+ode_system *ode_system_create(Model_t *m, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myAlgebraicEquations *algEq, double *time, double dt, sbmlsim_context *ctx);
+void ode_system_free(ode_system *sys);
+
+/* initial values, initial assignments and rules at t = 0 (returns 0 on failure) */
+int ode_system_initialize(ode_system *sys, myInitialAssignment *initAssign[], timeVariantAssignments *timeVarAssign, double sim_time, allocated_memory *mem);
+
+/* y <- value of variables */
+void ode_system_get_state(ode_system *sys, double *y);
+
+/* temp_value <- y, and evaluate assignment and algebraic rules at t (returns 0 on failure) */
+int ode_system_set_state(ode_system *sys, double t, const double *y);
+
+/* f <- f(t, y) (returns 0 if the state can not be set) */
+int ode_system_rhs(ode_system *sys, double t, const double *y, double *f);
+
+/* jac <- df/dy at (t, y) by numerical differentiation, f must be f(t, y) (returns 0 on failure) */
+int ode_system_jacobian(ode_system *sys, double t, const double *y, const double *f, const double *ewt, double **jac);
+
+/* accept y as the solution at t (value <- temp_value, returns 0 if the state can not be set) */
+int ode_system_commit(ode_system *sys, double t, const double *y);
+
+/* fast reactions and events at the current time, returns true if any variable is changed */
+boolean ode_system_calc_discontinuity(ode_system *sys);
+
+/* y <- y(t) inside the last step, used to locate events */
+typedef void (*ode_interpolant)(void *data, double t, double *y);
+
+/* cubic Hermite interpolation on [t0, t0 + h] from the values and the
+ * derivatives at both ends of the step (data of ode_hermite_interpolate()) */
+typedef struct _ode_hermite {
+  unsigned int n;
+  double t0;
+  double h;
+  const double *y0;
+  const double *f0;
+  const double *y1;
+  const double *f1;
+} ode_hermite;
+void ode_hermite_interpolate(void *data, double t, double *y);
+
+/* continuous extension of a Dormand-Prince step on [t0, t0 + h] whose
+ * coefficients r are given by dopri_dense_output()
+ * (data of dopri_dense_interpolate()) */
+typedef struct _dopri_dense {
+  unsigned int n;
+  double t0;
+  double h;
+  double **r;
+} dopri_dense;
+
+/* find the first event in the step (t0, t1] which is not committed yet,
+ * i.e. a change of a trigger value or a delayed event which is due.
+ * y(t) of the step is given by interpolant. returns 1 and stores the
+ * time and the state of the event to te and ye if it is found, 0 if it
+ * is not found, or -1 if the state can not be set inside the step */
+int ode_system_locate_event(ode_system *sys, double t0, double t1, ode_interpolant interpolant, void *data, double *te, double *ye);
+
+/* store temp_value of species, parameters and compartments to the row-th row of result */
+void ode_system_print_result(ode_system *sys, myResult *result, int row, int print_amount);
+
+/* copy the statistics above to result */
+void ode_system_store_statistics(ode_system *sys, myResult *result);
+
+/* error weights and weighted root-mean-square norm for local error control */
+void ode_system_error_weights(unsigned int n, const double *y, double atol, double rtol, double *ewt);
+double ode_system_wrms_norm(unsigned int n, const double *v, const double *ewt);
+
+#endif /* LibSBMLSim_OdeSystem_h */
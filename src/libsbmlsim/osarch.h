@@ -53,4 +53,13 @@ typedef unsigned __int64 uint64_t;
 #define SBMLSIM_EXPORT
 #endif
 
+/* thread local storage (C11 _Thread_local is not available in C89) */
+#if defined(_MSC_VER)
+#define SBMLSIM_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define SBMLSIM_THREAD_LOCAL _Thread_local
+#else
+#define SBMLSIM_THREAD_LOCAL __thread
+#endif
+
 #endif  /* LibSBMLSim_OsArch_h */
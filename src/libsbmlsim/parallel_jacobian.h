@@ -0,0 +1,85 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#ifndef LibSBMLSim_ParallelJacobian_h
+#define LibSBMLSim_ParallelJacobian_h
+
+#include "typedefs.h"
+#include "allocated_memory.h"
+#include "copied_AST.h"
+#include "sbmlsim_thread.h"
+#include <sbml/SBMLTypes.h>
+
+/* The simulation objects of a model prepared once more, from the same
+ * Model_t in a context of their own, so that a thread may evaluate
+ * calc_k() on them while the simulation goes on with the originals.
+ * The replicas are kept by the sbmlsim_model of the simulation, see
+ * sbmlsim_model_replicas(). */
+typedef struct {
+  sbmlsim_context *ctx;
+  allocated_memory *mem;
+  copied_AST *cp_AST;
+  mySpecies **sp;
+  myParameter **param;
+  myCompartment **comp;
+  myReaction **re;
+  myRule **rule;
+  myEvent **event;
+  myInitialAssignment **initAssign;
+  myAlgebraicEquations *algEq;
+  timeVariantAssignments *timeVarAssign;
+  double time;
+  double reverse_time;
+  /* view of the objects as the lists of variables */
+  ode_system *sys;
+} model_replica;
+
+/* Jacobian of the implicit methods (simulate_implicit()) by numerical
+ * differentiation, with its columns split among a team of threads. Each
+ * member copies the state of the simulation into its own replica, and
+ * perturbs one variable of it at a time. Columns are evaluated exactly
+ * as by a single thread, so the result does not depend on the number
+ * of threads. */
+struct _parallel_jacobian {
+  sbmlsim_team *team;
+  /* view of the objects of the simulation */
+  ode_system *master;
+  model_replica *replicas; /* one for each member of the team, of the model */
+  /* arguments of the jacobian being evaluated */
+  int order;
+  double dt;
+  int cycle;
+  double reverse_time;
+  double delta;
+  const double *b;
+  const double *k_t;
+  double **jacobian;
+};
+
+/* prepare the objects of m into rep, as create_mySBML_objects() */
+void model_replica_init(model_replica *rep, Model_t *m, double sim_time, double dt, int print_interval);
+void model_replica_free(model_replica *rep);
+
+/* returns NULL if the jacobian should be evaluated by the calling thread:
+ * the context has no team or is not simulating an sbmlsim_model, the
+ * model has less variables than the threshold of the context, or refers
+ * to past values by delay() */
+parallel_jacobian *parallel_jacobian_create(sbmlsim_context *ctx, Model_t *m, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], double *time, double dt);
+/* the replicas are not freed, they are kept by the model */
+void parallel_jacobian_free(parallel_jacobian *jac);
+
+/* jacobian[i][j] = (f_i(x + delta e_j) - b[i]) / delta, where f is
+ * calc_implicit_formula() of the variables with k = calc_k() */
+void parallel_jacobian_calc(parallel_jacobian *jac, int order, double dt, int cycle, double reverse_time, double delta, const double *b, const double *k_t, double **jacobian);
+
+#endif /* LibSBMLSim_ParallelJacobian_h */
@@ -0,0 +1,64 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#ifndef LibSBMLSim_ParallelRhs_h
+#define LibSBMLSim_ParallelRhs_h
+
+#include "typedefs.h"
+#include "boolean.h"
+#include "sbmlsim_thread.h"
+
+/* Evaluation of the reaction part of calc_k() by a team of threads, for
+ * models with many reactions. The rates and the rate x stoichiometry
+ * terms are computed by reactions, split into blocks of similar amount
+ * of math, and then each thread adds up the terms of its own block of
+ * species, so no two threads update the same k. The terms of a species
+ * are added in the order of the serial code, hence the result does not
+ * depend on the number of threads. */
+struct _parallel_rhs {
+  /* reactions of the simulation, which the plan was made for */
+  myReaction **re;
+  unsigned int re_num;
+  sbmlsim_team *team;
+  /* reactions which are not fast */
+  unsigned int num_of_reactions;
+  myReaction **reactions;
+  /* terms of reactions[i] are first_term[i] .. first_term[i + 1] - 1,
+   * one for each product and reactant which is not a boundary species */
+  unsigned int *first_term;
+  mySpeciesReference **term_refs;
+  boolean *term_is_reactant;
+  double *terms;
+  /* species receiving the terms, incidences of species[i] are
+   * first_incidence[i] .. first_incidence[i + 1] - 1 */
+  unsigned int num_of_species;
+  mySpecies **species;
+  unsigned int *first_incidence;
+  unsigned int *incidences;
+  /* blocks of reactions and species of each member (size + 1) */
+  unsigned int *reaction_blocks;
+  unsigned int *species_blocks;
+  /* arguments of the stage being evaluated */
+  double dt;
+  int cycle;
+  double *reverse_time;
+  int step;
+};
+
+parallel_rhs *parallel_rhs_create(myReaction *re[], unsigned int re_num, sbmlsim_team *team);
+void parallel_rhs_free(parallel_rhs *rhs);
+
+/* k[step] of the species += reaction terms, same as the reaction loop of calc_k() */
+void parallel_rhs_calc_reactions(parallel_rhs *rhs, double dt, int cycle, double *reverse_time, int step);
+
+#endif /* LibSBMLSim_ParallelRhs_h */
@@ -0,0 +1,102 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#ifndef LibSBMLSim_SbmlsimContext_h
+#define LibSBMLSim_SbmlsimContext_h
+
+#include "typedefs.h"
+#include "common.h"
+#include "osarch.h"
+#include "ast_memory_manager.h"
+#include "sbmlsim_thread.h"
+#ifndef DSFMT_MEXP
+#define DSFMT_MEXP 19937
+#endif
+#include "dSFMT.h"
+
+/* State of simulations which is not a part of the model nor the result.
+ * libSBMLSim has no other mutable global state, so simulations of
+ * distinct models in distinct contexts may run concurrently on separate
+ * threads. A context may be reused for any number of simulations, but
+ * must not be used by two threads at the same time. */
+struct _sbmlsim_context {
+  /* random numbers (firing order of simultaneous events with the same
+   * priority, initial values of bifurcation analysis) */
+  dsfmt_t rng;
+  /* ASTs created while preparing the model, freed by free_mySBML_objects() */
+  ast_memory_node_t *ast_memory_root_node;
+  ast_memory_node_t *ast_memory_last_node;
+  /* work area of calc_event() (MAX_IDENTICAL_EVENTS x MAX_EVENTASSIGNMENTS),
+   * allocated on first use */
+  double *event_assignment_values;
+  double *event_assignment_rows[MAX_IDENTICAL_EVENTS];
+  /* threads evaluating one simulation (reactions in calc_k(), columns of
+   * the jacobian), see sbmlsim_context_set_num_of_threads(). The team is
+   * kept for the life of the context, the plan for one simulation */
+  int num_of_threads;
+  unsigned int rhs_min_reactions;
+  unsigned int jacobian_min_variables;
+  sbmlsim_team *team;
+  parallel_rhs *rhs;
+  /* model being simulated, which keeps the replicas of its objects for
+   * the jacobian, or NULL */
+  sbmlsim_model *model;
+};
+
+SBMLSIM_EXPORT sbmlsim_context *sbmlsim_context_create(unsigned int seed);
+SBMLSIM_EXPORT void sbmlsim_context_free(sbmlsim_context *ctx);
+
+/* restart the random number sequence */
+SBMLSIM_EXPORT void sbmlsim_context_seed(sbmlsim_context *ctx, unsigned int seed);
+/* restart with the sequence number stream of seed. The generator is
+ * initialized by the key {seed, stream}, so distinct streams of the same
+ * seed are independent sequences: parallel workers (e.g. one stream per
+ * point of a sweep) get reproducible random numbers which do not depend
+ * on the number of workers */
+SBMLSIM_EXPORT void sbmlsim_context_seed_stream(sbmlsim_context *ctx, unsigned int seed, unsigned int stream);
+
+/* Let a simulation use num_of_threads threads (0: number of processors,
+ * 1: no threads, the default is 0) to evaluate the reactions of models
+ * with at least min_reactions reactions, and the columns of the jacobian
+ * of the implicit methods for models with at least min_variables
+ * variables (PARALLEL_RHS_MIN_REACTIONS, PARALLEL_JACOBIAN_MIN_VARIABLES
+ * by default). The results are the same as the ones of a single thread. */
+SBMLSIM_EXPORT void sbmlsim_context_set_num_of_threads(sbmlsim_context *ctx, int num_of_threads);
+SBMLSIM_EXPORT void sbmlsim_context_set_parallel_thresholds(sbmlsim_context *ctx, unsigned int min_reactions, unsigned int min_variables);
+
+/* team of the threads of a simulation, or NULL for the calling thread only */
+sbmlsim_team *sbmlsim_context_team(sbmlsim_context *ctx);
+
+/* plan of the parallel evaluation of the reactions re, or NULL if they
+ * are evaluated by the calling thread. Models with delay() are evaluated
+ * by the calling thread, because the explicit delay equations share
+ * reverse_time */
+parallel_rhs *sbmlsim_context_parallel_rhs(sbmlsim_context *ctx, mySpecies *sp[], unsigned int sp_num, myParameter *param[], unsigned int param_num, myCompartment *comp[], unsigned int comp_num, myReaction *re[], unsigned int re_num);
+/* forget the plan at the end of a simulation */
+void sbmlsim_context_release_rhs(sbmlsim_context *ctx);
+
+/* uniform random integer in [0, n) */
+int sbmlsim_context_random_index(sbmlsim_context *ctx, int n);
+/* uniform random number in [0, 1) */
+double sbmlsim_context_random(sbmlsim_context *ctx);
+
+/* rows of the work area of calc_event() */
+double **sbmlsim_context_event_buffer(sbmlsim_context *ctx);
+
+/* The model preparation (create_mySBML_objects() and below) registers ASTs
+ * to the context attached to the calling thread. attach returns the
+ * context which was attached before, to be restored after the simulation */
+sbmlsim_context *sbmlsim_context_attach(sbmlsim_context *ctx);
+sbmlsim_context *sbmlsim_context_current(void);
+
+#endif /* LibSBMLSim_SbmlsimContext_h */
@@ -11,10 +11,16 @@
  * the Free Software Foundation.  A copy of the license agreement is provided
  * in the file named "LICENSE.txt" included with this software distribution.
  * ---------------------------------------------------------------------- -->*/
-#include <stdlib.h>
-#include <time.h>
+#ifndef LibSBMLSim_SbmlsimDtoa_h
+#define LibSBMLSim_SbmlsimDtoa_h
 
-void set_seed(void){
-  srand((unsigned)time(NULL));
-}
+/* enough for any double written by sbmlsim_format_double() */
+#define SBMLSIM_DOUBLE_BUFFER_SIZE 32
 
+/* Write the shortest representation of value which reads back to the
+ * same double into buf (not terminated), in the style of %.16g (which
+ * it prints when %.16g is also the shortest one), whatever the locale.
+ * Returns the number of characters written */
+int sbmlsim_format_double(double value, char *buf);
+
+#endif /* LibSBMLSim_SbmlsimDtoa_h */
@@ -0,0 +1,203 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#ifndef LibSBMLSim_SbmlsimModel_h
+#define LibSBMLSim_SbmlsimModel_h
+
+#include "typedefs.h"
+#include "common.h"
+#include "osarch.h"
+#include "errorcodes.h"
+#include "boolean.h"
+#include "myResult.h"
+#include "allocated_memory.h"
+#include "copied_AST.h"
+#include "parallel_jacobian.h"
+#include <sbml/SBMLTypes.h>
+
+/* value of a variable when the objects were prepared */
+typedef struct {
+  double value;
+  double temp_value;
+  double k[6];
+  double prev_val[3];
+  double prev_k[3];
+} sbmlsim_model_value;
+
+/* state of an event when the objects were prepared */
+typedef struct {
+  boolean is_able_to_fire;
+  unsigned int num_of_delayed_events_que;
+  int next_firing_index;
+  double *firing_times; /* NULL if the event has no delay */
+} sbmlsim_model_event;
+
+/* kinds of sbmlsim_model_override */
+#define SBMLSIM_OVERRIDE_SPECIES_AMOUNT 0
+#define SBMLSIM_OVERRIDE_SPECIES_CONCENTRATION 1
+#define SBMLSIM_OVERRIDE_PARAMETER 2
+#define SBMLSIM_OVERRIDE_COMPARTMENT 3
+#define SBMLSIM_OVERRIDE_LOCAL_PARAMETER 4
+
+/* a value set by sbmlsim_model_set_*() instead of the one of the model */
+typedef struct {
+  int kind;
+  unsigned int index; /* of the species, parameter, compartment or reaction */
+  Parameter_t *local_parameter;
+  double value;
+} sbmlsim_model_override;
+
+/* A model prepared for simulation. The simulation objects (mySpecies,
+ * myReaction, ... and their equations) are created by the first
+ * simulation and kept, with their state at that time. The following
+ * simulations restore the state and run again, whatever the end time,
+ * the step size or the method, without preparing the model again. The
+ * objects are prepared again only when they do not fit the simulation:
+ * - for a model with delay() or delayed events, whose buffers are sized
+ *   by sim_time / dt, when sim_time, dt or print_interval changes
+ * - for the variable step methods (-m 13, 14), which rewrite the
+ *   equations while they run, for every simulation
+ * A model must not be simulated by two threads at the same time. */
+struct _sbmlsim_model {
+  SBMLDocument_t *d; /* read by sbmlsim_model_create_from_file() or _string(), or NULL */
+  Model_t *m;
+  LibsbmlsimErrorCode error_code;
+  /* the ASTs of the objects are registered to this context, which is
+   * also the one of sbmlsim_model_simulate() */
+  sbmlsim_context *ctx;
+  /* the objects and what they were prepared for */
+  boolean is_prepared;
+  boolean is_variable_step;
+  boolean depends_on_grid;
+  double sim_time;
+  double dt;
+  int print_interval;
+  unsigned int num_of_species;
+  unsigned int num_of_parameters;
+  unsigned int num_of_compartments;
+  unsigned int num_of_reactions;
+  unsigned int num_of_rules;
+  unsigned int num_of_events;
+  unsigned int num_of_initialAssignments;
+  mySpecies **sp;
+  myParameter **param;
+  myCompartment **comp;
+  myReaction **re;
+  myRule **rule;
+  myEvent **event;
+  myInitialAssignment **initAssign;
+  myAlgebraicEquations *algEq;
+  timeVariantAssignments *timeVarAssign;
+  allocated_memory *mem;
+  copied_AST *cp_AST;
+  double time;
+  /* state after the preparation (fixed step size only): the values of
+   * the species, parameters, compartments and species references, the
+   * events, the operands of the initial assignments and of the time
+   * variant assignments (the solvers replace them by their initial
+   * values), and the memory allocated until then */
+  sbmlsim_model_value *initial_values;
+  sbmlsim_model_event *initial_events;
+  unsigned int num_of_firing_times;
+  double ***initial_operands;
+  unsigned int num_of_initial_operands;
+  unsigned int num_of_prepared_memory;
+  /* the objects prepared once more for each thread of the parallel
+   * jacobian, kept until the objects are prepared again */
+  model_replica *replicas;
+  int num_of_replicas;
+  /* values set instead of the ones of the model. The initial values are
+   * written into the objects before each simulation, the local
+   * parameters (folded into the equations) when they are prepared */
+  sbmlsim_model_override *overrides;
+  unsigned int num_of_overrides;
+  unsigned int override_capacity;
+  /* the SBML of a model of an sbmlsim_model_cache, or NULL */
+  char *source;
+  size_t source_length;
+  unsigned int source_hash;
+  /* wall time (seconds) spent reading the SBML file or string */
+  double read_time;
+  /* threads of the contexts of sbmlsim_model_simulate() */
+  int num_of_threads;
+};
+
+/* m must not be freed while the model is used, nor modified unless the
+ * model is told by sbmlsim_model_update(). The model of a file or a
+ * string is freed with the prepared model */
+SBMLSIM_EXPORT sbmlsim_model *sbmlsim_model_create(Model_t *m);
+SBMLSIM_EXPORT sbmlsim_model *sbmlsim_model_create_from_file(const char *file);
+SBMLSIM_EXPORT sbmlsim_model *sbmlsim_model_create_from_string(const char *str);
+/* d is freed with the prepared model. Its errors are not checked: d has
+ * been read and validated by the caller */
+SBMLSIM_EXPORT sbmlsim_model *sbmlsim_model_create_from_document(SBMLDocument_t *d);
+SBMLSIM_EXPORT void sbmlsim_model_free(sbmlsim_model *model);
+
+/* Wall time (seconds) spent by sbmlsim_model_create_from_file() or
+ * _from_string() reading the SBML, 0 for the other models. The results
+ * of the simulations hold the time of the other phases */
+SBMLSIM_EXPORT double sbmlsim_model_get_read_time(sbmlsim_model *model);
+
+/* The arguments are the same as simulateSBMLModel(), and the result of
+ * a simulation which failed is an error (never NULL). The context of
+ * sbmlsim_model_simulate() is seeded by the current time, as the one of
+ * simulateSBMLModel() */
+SBMLSIM_EXPORT myResult *sbmlsim_model_simulate(sbmlsim_model *model, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method, double atol, double rtol, double facmax);
+/* Let the simulations of sbmlsim_model_simulate() use num_of_threads
+ * threads, as sbmlsim_context_set_num_of_threads() (0: number of
+ * processors, the default). Callers which simulate several models
+ * concurrently set 1 */
+SBMLSIM_EXPORT void sbmlsim_model_set_num_of_threads(sbmlsim_model *model, int num_of_threads);
+SBMLSIM_EXPORT myResult *sbmlsim_model_simulate_with_context(sbmlsim_model *model, sbmlsim_context *ctx, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method, double atol, double rtol, double facmax);
+
+/* Set the initial value of a species (in the unit of its declaration,
+ * amount or concentration), the value of a global parameter or the size
+ * of a compartment, for the following simulations, without modifying
+ * the model. The initial assignments are evaluated with the values set.
+ * The species of a compartment whose size is set keep the amount or the
+ * concentration they declare, and the other one follows the new size.
+ * Returns 0 if there is no such id */
+SBMLSIM_EXPORT int sbmlsim_model_set_value(sbmlsim_model *model, const char *id, double value);
+/* Set the initial amount or concentration of a species, converted by the
+ * size of its compartment if it is declared in the other unit */
+SBMLSIM_EXPORT int sbmlsim_model_set_initial_amount(sbmlsim_model *model, const char *id, double value);
+SBMLSIM_EXPORT int sbmlsim_model_set_initial_concentration(sbmlsim_model *model, const char *id, double value);
+/* Set the value of a local parameter of the kinetic law of a reaction.
+ * The equation of the kinetic law is prepared again with the value,
+ * keeping the rest of the prepared objects, as sbmlsim_model_update()
+ * (the whole model is prepared again for a fast reaction or a kinetic
+ * law with delay()) */
+SBMLSIM_EXPORT int sbmlsim_model_set_local_parameter(sbmlsim_model *model, const char *reaction_id, const char *id, double value);
+/* Simulate with the values of the model again (the kinetic laws whose
+ * local parameters were set are prepared again) */
+SBMLSIM_EXPORT void sbmlsim_model_reset_values(sbmlsim_model *model);
+
+/* Tell the model that the elements of m with the num_of_ids ids were
+ * modified, or any element if ids is NULL. Elements must not be added
+ * to m nor removed from it. The initial values of the species,
+ * parameters and compartments are read again and the equations of the
+ * kinetic laws of the reactions are prepared again, keeping the rest
+ * of the prepared objects (the order of the rules and the structure of
+ * the jacobian are found by each simulation). Other modifications
+ * prepare the whole model again for the next simulation. Returns 1 if
+ * the prepared objects were updated, 0 if they will be prepared again */
+SBMLSIM_EXPORT int sbmlsim_model_update(sbmlsim_model *model, const char **ids, int num_of_ids);
+
+/* num_of_replicas replicas of the prepared objects, with the values set
+ * to the local parameters, for the parallel jacobian of a simulation */
+model_replica *sbmlsim_model_replicas(sbmlsim_model *model, int num_of_replicas);
+
+/* simulation of the model in ctx, returns NULL if it failed */
+myResult *sbmlsim_model_run(sbmlsim_model *model, sbmlsim_context *ctx, double sim_time, double dt, int print_interval, int print_amount, int method, int use_lazy_method, double atol, double rtol, double facmax);
+
+#endif /* LibSBMLSim_SbmlsimModel_h */
@@ -0,0 +1,46 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#ifndef LibSBMLSim_SbmlsimModelCache_h
+#define LibSBMLSim_SbmlsimModelCache_h
+
+#include "typedefs.h"
+#include "osarch.h"
+
+/* A cache of prepared models, for a process which simulates the same
+ * SBML models again and again (a simulation service). The models are
+ * keyed by a hash of their SBML text, and compared byte by byte on a
+ * hit, so a hit skips both the parsing by libSBML and the preparation.
+ * A model taken from the cache belongs to the caller, and to no other
+ * thread, until it is put back, so the cache may hold several models
+ * of the same SBML for concurrent callers. When the cache is full, the
+ * least recently put model is freed. */
+
+/* capacity is the maximum number of models kept (at least 1) */
+SBMLSIM_EXPORT sbmlsim_model_cache *sbmlsim_model_cache_create(int capacity);
+SBMLSIM_EXPORT void sbmlsim_model_cache_free(sbmlsim_model_cache *cache);
+
+/* a prepared model of the SBML string or file, from the cache or
+ * created; never NULL (the error of an invalid SBML is reported by its
+ * simulations, see sbmlsim_model_simulate) */
+SBMLSIM_EXPORT sbmlsim_model *sbmlsim_model_cache_get_string(sbmlsim_model_cache *cache, const char *str);
+SBMLSIM_EXPORT sbmlsim_model *sbmlsim_model_cache_get_file(sbmlsim_model_cache *cache, const char *file);
+/* give a model of sbmlsim_model_cache_get_*() back, its values are
+ * reset. Other models (and models with errors, or whose SBML model was
+ * modified, see sbmlsim_model_update) are freed */
+SBMLSIM_EXPORT void sbmlsim_model_cache_put(sbmlsim_model_cache *cache, sbmlsim_model *model);
+/* 0 for a NULL cache */
+SBMLSIM_EXPORT int sbmlsim_model_cache_get_num_of_hits(sbmlsim_model_cache *cache);
+SBMLSIM_EXPORT int sbmlsim_model_cache_get_num_of_misses(sbmlsim_model_cache *cache);
+
+#endif /* LibSBMLSim_SbmlsimModelCache_h */
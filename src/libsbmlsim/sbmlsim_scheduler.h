@@ -0,0 +1,47 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#ifndef LibSBMLSim_SbmlsimScheduler_h
+#define LibSBMLSim_SbmlsimScheduler_h
+
+/* Work-stealing scheduler for a fixed set of independent tasks
+ * (e.g. the points of a parameter sweep), whose cost may differ by
+ * orders of magnitude.
+ * Each worker owns a deque of task indices. The owner takes tasks from
+ * the head, and an idle worker steals half of the remaining tasks of
+ * another worker from the tail, so that the tail of the run keeps all
+ * workers busy. With cost hints the tasks are dealt to the workers by
+ * the longest-processing-time rule, most expensive first. */
+
+/* run task on worker (0 <= worker < num_of_workers) */
+typedef void (*sbmlsim_task_func)(void *arg, int task, int worker);
+
+/* statistics of one worker */
+typedef struct sbmlsim_worker_stats {
+  int num_of_tasks; /* tasks run by the worker */
+  int num_of_steals; /* successful steals */
+  int num_of_stolen_tasks; /* tasks taken by the steals */
+  double busy_time; /* seconds spent in tasks */
+  double wall_time; /* seconds from the start of the run to the end of the worker */
+} sbmlsim_worker_stats;
+
+/* run tasks 0 .. num_of_tasks-1 on num_of_workers workers, worker 0 is
+ * the calling thread. cost_hints (may be NULL) are relative costs of the
+ * tasks, stats (may be NULL) must have num_of_workers elements.
+ * Returns the number of workers which actually ran (workers whose
+ * thread could not be created are skipped, their tasks are stolen). */
+int sbmlsim_run_tasks(int num_of_tasks, const double *cost_hints,
+    int num_of_workers, sbmlsim_task_func func, void *arg,
+    sbmlsim_worker_stats *stats);
+
+#endif /* LibSBMLSim_SbmlsimScheduler_h */
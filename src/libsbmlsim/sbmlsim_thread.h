@@ -0,0 +1,59 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#ifndef LibSBMLSim_SbmlsimThread_h
+#define LibSBMLSim_SbmlsimThread_h
+
+/* Minimal portable threads (POSIX threads or Win32 threads) used by the
+ * parallel APIs. Objects are opaque so that this header does not pull
+ * in pthread.h or windows.h. */
+typedef struct _sbmlsim_thread sbmlsim_thread;
+typedef struct _sbmlsim_mutex sbmlsim_mutex;
+typedef struct _sbmlsim_team sbmlsim_team;
+typedef void (*sbmlsim_thread_func)(void *arg);
+typedef void (*sbmlsim_team_func)(void *arg, int member, int num_of_members);
+
+/* start func(arg) on a new thread, returns NULL on failure */
+sbmlsim_thread *sbmlsim_thread_create(sbmlsim_thread_func func, void *arg);
+/* wait for the thread and free it */
+void sbmlsim_thread_join(sbmlsim_thread *thread);
+
+sbmlsim_mutex *sbmlsim_mutex_create(void);
+void sbmlsim_mutex_free(sbmlsim_mutex *mutex);
+void sbmlsim_mutex_lock(sbmlsim_mutex *mutex);
+void sbmlsim_mutex_unlock(sbmlsim_mutex *mutex);
+
+/* A team of threads which is kept alive between parallel regions, so
+ * that work which is too small to pay for thread creation (one stage of
+ * an ODE step) can still be split. Member 0 is the calling thread, so a
+ * team of n members starts n - 1 threads. sbmlsim_team_create returns
+ * a team of fewer members if threads could not be started. */
+sbmlsim_team *sbmlsim_team_create(int num_of_members);
+void sbmlsim_team_free(sbmlsim_team *team);
+int sbmlsim_team_size(sbmlsim_team *team);
+/* call func(arg, member, num_of_members) on every member and wait
+ * until all of them return */
+void sbmlsim_team_run(sbmlsim_team *team, sbmlsim_team_func func, void *arg);
+
+/* number of online processors (at least 1) */
+int sbmlsim_num_of_processors(void);
+
+/* num_of_threads if it is positive, otherwise the number of processors,
+ * and never more than num_of_tasks (but at least 1) */
+int sbmlsim_num_of_workers(int num_of_threads, int num_of_tasks);
+
+/* seconds from an arbitrary origin (monotonic where available),
+ * for measuring elapsed time */
+double sbmlsim_wall_time(void);
+
+#endif /* LibSBMLSim_SbmlsimThread_h */
@@ -27,6 +27,14 @@ typedef struct _myDelay myDelay;
 typedef struct _myInitialAssignment myInitialAssignment;
 typedef struct _allocated_memory allocated_memory;
 typedef struct _copied_AST copied_AST;
+typedef struct _ode_system ode_system;
+typedef struct _sbmlsim_context sbmlsim_context;
+typedef struct _sbmlsim_model sbmlsim_model;
+typedef struct _sbmlsim_model_cache sbmlsim_model_cache;
+typedef struct _parallel_rhs parallel_rhs;
+typedef struct _parallel_jacobian parallel_jacobian;
+typedef struct _mySymbol mySymbol;
+typedef struct _mySymbolTable mySymbolTable;
 
 /* no header files yet */
 typedef struct _timeVariantAssignments timeVariantAssignments;
@@ -26,14 +26,20 @@ void usage(char *str) {
   printf(" -d #    : specify simulation delta (ex. -d 0.01 [default:1/4096])\n");
   printf("           dt is calculated in (delta)*(time)/(step)\n");
   printf(" -a      : print Species Value in Amount\n");
-  printf(" -o file : specify result file (ex. -o output.csv )\n");
+  printf(" -o file : specify result file (ex. -o output.csv, a .tsv file is separated by tabs,\n");
+  printf("           a .bin file is written in the binary format of write_binary())\n");
   printf(" -l      : use lazy method for integration\n");
   printf(" -n      : do not use lazy method\n");
   printf(" -v      : prints version info\n");
   printf(" -A #    : specify absolute tolerance for variable stepsize (ex. -A 1e-03 [default:1e-09])\n");
   printf(" -R #    : specify relative tolerance for variable stepsize (ex. -R 0.1   [default:1e-06])\n");
   printf(" -M #    : specify the max change rate of stepsize (ex. -M 1.5 [default:2.0])\n");
-  printf(" -B      : use bifurcation analysis\n");
+  printf(" -B spec : bifurcation analysis, spec is species:parameter:min:max:step:transition_time\n");
+  printf("           (ex. -B S1:k1:0.1:2.0:0.01:50 [default result file:bifurcation_analysis.csv])\n");
+  printf(" -S #    : specify the seed of the random numbers of the simulation\n");
+  printf("           (ex. -S 5489 [default:current time])\n");
+  printf(" -j #    : specify the number of threads for bifurcation analysis and for models\n");
+  printf("           with many reactions (ex. -j 8 [default:all processors])\n");
   printf(" -m #    : specify numerical integration algorithm (ex. -m 3 )\n");
   printf("        1: Runge-Kutta\n");
   printf("        2: AM1 & BD1 (implicit Euler)\n");
@@ -49,6 +55,11 @@ void usage(char *str) {
   printf("       12: AB4\n");
   printf("       13: Runge-Kutta-Fehlberg\n");
   printf("       14: Cash-Karp\n");
+  printf("       15: Variable-order BDF (adaptive stepsize)\n");
+  printf("       16: Dormand-Prince (adaptive stepsize)\n");
+  printf("       17: 3rd order Rosenbrock (adaptive stepsize)\n");
+  printf("       18: 4th order Rosenbrock (adaptive stepsize)\n");
+  printf("       19: Auto-switching Dormand-Prince/Rosenbrock (adaptive stepsize)\n");
   exit(1);
 }
 
@@ -84,6 +95,13 @@ int main(int argc, char *argv[]){
 
   /*for bifurcation analysis*/
   boolean use_bifurcation_analysis = false;
+  char sta_var_id[256], bif_param_id[256];
+  double bif_param_min = 0, bif_param_max = 0, bif_param_stepsize = 0;
+  double transition_time = 0;
+  int num_of_threads = 0;
+  unsigned int seed = (unsigned int)my_time(NULL);
+  myBifurcationResult *bif;
+  sbmlsim_context *ctx;
 
   /*for variable step-size numerical integration*/
   boolean use_variable_stepsize = false;
@@ -92,7 +110,7 @@ int main(int argc, char *argv[]){
   myResult *rtn;
 
   myname = argv[0];
-  while ((ch = getopt(argc, argv, "t:s:d:m:A:R:M:o:lnaBv")) != -1){
+  while ((ch = getopt(argc, argv, "t:s:d:m:A:R:M:o:B:S:j:lnav")) != -1){
     switch (ch) {
       case 't':
         sim_time = atof(optarg);
@@ -126,6 +144,16 @@ int main(int argc, char *argv[]){
         break;
       case 'B':
         use_bifurcation_analysis = 1;
+        if (sscanf(optarg, "%255[^:]:%255[^:]:%lf:%lf:%lf:%lf", sta_var_id, bif_param_id,
+              &bif_param_min, &bif_param_max, &bif_param_stepsize, &transition_time) != 6) {
+          usage(myname);
+        }
+        break;
+      case 'S':
+        seed = (unsigned int)strtoul(optarg, NULL, 10);
+        break;
+      case 'j':
+        num_of_threads = atoi(optarg);
         break;
       case 'M':
         facmax = atof(optarg);
@@ -138,7 +166,7 @@ int main(int argc, char *argv[]){
     }
   }
   if (outfile == NULL) {
-    outfile = "out.csv";
+    outfile = use_bifurcation_analysis ? "bifurcation_analysis.csv" : "out.csv";
   }
   argc -= optind;
   argv += optind;
@@ -208,9 +236,14 @@ int main(int argc, char *argv[]){
       printf("AB4 : press \"12\"\n");
 	  printf("RKF : press \"13\"\n");
 	  printf("CK  : press \"14\"\n");
+	  printf("BDF : press \"15\"\n");
+	  printf("DP  : press \"16\"\n");
+	  printf("RO3 : press \"17\"\n");
+	  printf("RO4 : press \"18\"\n");
+	  printf("AUTO: press \"19\"\n");
       tmp = fgets(buf2, 256, stdin);
       method_key = atoi(buf2);
-      if (method_key < 1 || method_key > 14) {
+      if (method_key < 1 || method_key > 19) {
         printf("Invalid Input!\nSelect and input the number \"1~12\"");
       } else {
         break;
@@ -276,6 +309,41 @@ int main(int argc, char *argv[]){
       method_name = MTHD_NAME_CASH_KARP;
       use_variable_stepsize = 1;
       break;
+    case 15: /*  Variable-order Backward-Difference */
+      method = MTHD_ADAPTIVE_BACKWARD_DIFFERENCE;
+      method_name = MTHD_NAME_ADAPTIVE_BACKWARD_DIFFERENCE;
+      /* step size is controlled by -A and -R, dt is the output grid */
+      if (use_lazy_method == 2) {
+        use_lazy_method = false;
+      }
+      break;
+    case 16: /*  Dormand-Prince */
+      method = MTHD_DORMAND_PRINCE;
+      method_name = MTHD_NAME_DORMAND_PRINCE;
+      break;
+    case 17: /*  Rosenbrock (RODAS3) */
+      method = MTHD_ROSENBROCK_3;
+      method_name = MTHD_NAME_ROSENBROCK_3;
+      /* one LU decomposition per step, no Newton iteration */
+      if (use_lazy_method == 2) {
+        use_lazy_method = false;
+      }
+      break;
+    case 18: /*  Rosenbrock (RODAS4) */
+      method = MTHD_ROSENBROCK_4;
+      method_name = MTHD_NAME_ROSENBROCK_4;
+      if (use_lazy_method == 2) {
+        use_lazy_method = false;
+      }
+      break;
+    case 19: /*  Dormand-Prince / Rosenbrock (RODAS4) */
+      method = MTHD_AUTO_SWITCHING;
+      method_name = MTHD_NAME_AUTO_SWITCHING;
+      /* stiffness is detected while integrating */
+      if (use_lazy_method == 2) {
+        use_lazy_method = false;
+      }
+      break;
     default:
       method = MTHD_RUNGE_KUTTA;
       method_name = MTHD_NAME_RUNGE_KUTTA;
@@ -315,7 +383,25 @@ int main(int argc, char *argv[]){
   }
   print_interval = (int)(1/delta);
   printf("  time:%g step:%d dt:%f\n", sim_time, step, dt);
-  rtn = simulateSBMLModel(m, sim_time, dt, print_interval, print_amount, method, use_lazy_method, atol, rtol, facmax);
+  if (use_bifurcation_analysis) {
+    bif = analyzeBifurcationSBMLModel(m, sta_var_id, bif_param_id, bif_param_min,
+        bif_param_max, bif_param_stepsize, transition_time, sim_time, dt,
+        print_interval, method, use_lazy_method, num_of_threads);
+    if (myBifurcationResult_isError(bif)) {
+      printf("%s\n", myBifurcationResult_getErrorMessage(bif));
+    } else {
+      printf("  %d points with %d threads in %g seconds\n", bif->num_of_points,
+          bif->num_of_threads, bif->elapsed_time);
+      write_bifurcation_csv(bif, outfile);
+    }
+    free_myBifurcationResult(bif);
+    SBMLDocument_free(d);
+    return 0;
+  }
+  ctx = sbmlsim_context_create(seed);
+  sbmlsim_context_set_num_of_threads(ctx, num_of_threads);
+  rtn = simulateSBMLModelWithContext(ctx, m, sim_time, dt, print_interval, print_amount, method, use_lazy_method, atol, rtol, facmax);
+  sbmlsim_context_free(ctx);
 
   /* display allocated memory */
   /* MEM_TRACE(); */
@@ -324,7 +410,12 @@ int main(int argc, char *argv[]){
   if (rtn == NULL) {
     printf("Returned result is NULL\n");
   } else {
-    write_csv(rtn, outfile); /*  for SBML test suite */
+    if (strlen(outfile) > 4 && strcmp(outfile + strlen(outfile) - 4, ".tsv") == 0)
+      write_tsv(rtn, outfile);
+    else if (strlen(outfile) > 4 && strcmp(outfile + strlen(outfile) - 4, ".bin") == 0)
+      write_binary(rtn, outfile, 0);
+    else
+      write_csv(rtn, outfile); /*  for SBML test suite */
     /* to be more generic simulator
        write_separate_result(rtn,
        "./simulation_results/species_result.dat",
@@ -20,3 +20,12 @@ int my_isnan(double x) {
   return isnan(x);
 #endif
 }
+
+double my_nan(void) {
+#if defined(NAN)
+  return NAN;
+#else
+  double zero = 0.0;
+  return zero / zero;
+#endif
+}
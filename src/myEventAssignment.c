@@ -12,6 +12,7 @@
  * in the file named "LICENSE.txt" included with this software distribution.
  * ---------------------------------------------------------------------- -->*/
 #include "libsbmlsim/myEventAssignment.h"
+#include "libsbmlsim/mySymbolTable.h"
 #include <stdlib.h>
 #include <string.h>
 #include <sbml/SBMLTypes.h>
@@ -45,68 +46,24 @@ void myEventAssignment_free(myEventAssignment *assign) {
   free(assign);
 }
 
-void myEventAssignment_initTarget(
-    myEventAssignment *assign,
-    mySpecies **species, unsigned int num_of_species,
-    myParameter **parameters, unsigned int num_of_parameters,
-    myCompartment **compartments, unsigned int num_of_compartments,
-    myReaction **reactions, unsigned int num_of_reactions) {
-  unsigned int i, j;
+void myEventAssignment_initTarget(myEventAssignment *assign, mySymbolTable *symbols) {
   EventAssignment_t *origin;
-  const char *origin_var;
-  mySpecies *sp;
-  myParameter *param;
-  myCompartment *comp;
-  myReaction *re;
-  mySpeciesReference *product, *reactant;
+  mySymbol *symbol;
 
   origin = myEventAssignment_getOrigin(assign);
-  origin_var = EventAssignment_getVariable(origin);
-
-  for (i = 0; i < num_of_species; i++) {
-    sp = species[i];
-    if (strcmp(origin_var, Species_getId(sp->origin)) == 0) {
-      myEventAssignment_setTargetSpecies(assign, sp);
-      return;
-    }
-  }
-
-  for (i = 0; i < num_of_parameters; i++) {
-    param = parameters[i];
-    if (strcmp(origin_var, Parameter_getId(param->origin)) == 0) {
-      myEventAssignment_setTargetParameter(assign, param);
-      return;
-    }
-  }
-
-  for (i = 0; i < num_of_compartments; i++) {
-    comp = compartments[i];
-    if (strcmp(origin_var, Compartment_getId(comp->origin)) == 0) {
-      myEventAssignment_setTargetCompartment(assign, comp);
-      return;
-    }
+  symbol = mySymbolTable_find(symbols, EventAssignment_getVariable(origin));
+  if (symbol == NULL) {
+    return;
   }
 
-  for (i = 0; i < num_of_reactions; i++) {
-    re = reactions[i];
-
-    for (j = 0; j < re->num_of_products; j++) {
-      product = re->products[j];
-      if (SpeciesReference_isSetId(product->origin)
-          && strcmp(origin_var, SpeciesReference_getId(product->origin)) == 0) {
-        myEventAssignment_setTargetSpeciesReference(assign, product);
-        return;
-      }
-    }
-
-    for (j = 0; j < re->num_of_reactants; j++) {
-      reactant = re->reactants[j];
-      if (SpeciesReference_isSetId(reactant->origin)
-          && strcmp(origin_var, SpeciesReference_getId(reactant->origin)) == 0) {
-        myEventAssignment_setTargetSpeciesReference(assign, reactant);
-        return;
-      }
-    }
+  if (symbol->species != NULL) {
+    myEventAssignment_setTargetSpecies(assign, symbol->species);
+  } else if (symbol->parameter != NULL) {
+    myEventAssignment_setTargetParameter(assign, symbol->parameter);
+  } else if (symbol->compartment != NULL) {
+    myEventAssignment_setTargetCompartment(assign, symbol->compartment);
+  } else {
+    myEventAssignment_setTargetSpeciesReference(assign, symbol->species_reference);
   }
 }
 
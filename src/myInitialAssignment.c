@@ -12,6 +12,7 @@
  * in the file named "LICENSE.txt" included with this software distribution.
  * ---------------------------------------------------------------------- -->*/
 #include "libsbmlsim/myInitialAssignment.h"
+#include "libsbmlsim/mySymbolTable.h"
 #include <stdlib.h>
 #include <string.h>
 #include <sbml/SBMLTypes.h>
@@ -45,72 +46,24 @@ void myInitialAssignment_free(myInitialAssignment *assign) {
   free(assign);
 }
 
-void myInitialAssignment_initTarget(
-    myInitialAssignment *assign,
-    mySpecies **species, unsigned int num_of_species,
-    myParameter **parameters, unsigned int num_of_parameters,
-    myCompartment **compartments, unsigned int num_of_compartments) {
-  unsigned int i;
+void myInitialAssignment_initTarget(myInitialAssignment *assign, mySymbolTable *symbols) {
   InitialAssignment_t *origin;
-  const char *origin_symbol;
+  mySymbol *symbol;
 
   origin = myInitialAssignment_getOrigin(assign);
-  origin_symbol = InitialAssignment_getSymbol(origin);
-
-  for (i = 0; i < num_of_species; i++) {
-    if (strcmp(origin_symbol, Species_getId(species[i]->origin)) == 0) {
-      myInitialAssignment_setTargetSpecies(assign, species[i]);
-      return;
-    }
-  }
-
-  for (i = 0; i < num_of_parameters; i++) {
-    if (strcmp(origin_symbol, Parameter_getId(parameters[i]->origin)) == 0) {
-      myInitialAssignment_setTargetParameter(assign, parameters[i]);
-      return;
-    }
-  }
-
-  for (i = 0; i < num_of_compartments; i++) {
-    if (strcmp(origin_symbol, Compartment_getId(compartments[i]->origin)) == 0) {
-      myInitialAssignment_setTargetCompartment(assign, compartments[i]);
-      return;
-    }
+  symbol = mySymbolTable_find(symbols, InitialAssignment_getSymbol(origin));
+  if (symbol == NULL) {
+    return;
   }
-}
-
-void myInitialAssignment_initTargetSpeciesReference(
-    myInitialAssignment *assign,
-    myReaction **reactions, unsigned int num_of_reactions) {
-  unsigned int i, j;
-  InitialAssignment_t *origin;
-  myReaction *re;
-  mySpeciesReference *product, *reactant;
-  const char *origin_symbol;
-
-  origin = myInitialAssignment_getOrigin(assign);
-  origin_symbol = InitialAssignment_getSymbol(origin);
-
-  for (i = 0; i < num_of_reactions; i++) {
-    re = reactions[i];
-
-    for (j = 0; j < re->num_of_products; j++) {
-      product = re->products[j];
-      if (SpeciesReference_isSetId(product->origin)
-          && strcmp(origin_symbol, SpeciesReference_getId(product->origin)) == 0) {
-        myInitialAssignment_setTargetSpeciesReference(assign, product);
-        return;
-      }
-    }
 
-    for (j = 0; j < re->num_of_reactants; j++) {
-      reactant = re->reactants[j];
-      if (SpeciesReference_isSetId(reactant->origin)
-          && strcmp(origin_symbol, SpeciesReference_getId(reactant->origin)) == 0) {
-        myInitialAssignment_setTargetSpeciesReference(assign, reactant);
-        return;
-      }
-    }
+  if (symbol->species != NULL) {
+    myInitialAssignment_setTargetSpecies(assign, symbol->species);
+  } else if (symbol->parameter != NULL) {
+    myInitialAssignment_setTargetParameter(assign, symbol->parameter);
+  } else if (symbol->compartment != NULL) {
+    myInitialAssignment_setTargetCompartment(assign, symbol->compartment);
+  } else {
+    myInitialAssignment_setTargetSpeciesReference(assign, symbol->species_reference);
   }
 }
 
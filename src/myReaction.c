@@ -12,6 +12,7 @@
  * in the file named "LICENSE.txt" included with this software distribution.
  * ---------------------------------------------------------------------- -->*/
 #include "libsbmlsim/myReaction.h"
+#include "libsbmlsim/mySymbolTable.h"
 #include <stdlib.h>
 #include <string.h>
 #include <sbml/SBMLTypes.h>
@@ -108,48 +109,44 @@ void myReaction_free(myReaction *reaction) {
   free(reaction);
 }
 
-void myReaction_initProducts(myReaction *reaction, mySpecies **species, unsigned int num_of_species) {
-  unsigned int i, j;
+void myReaction_initProducts(myReaction *reaction, mySymbolTable *symbols) {
+  unsigned int i;
   unsigned int num_of_products;
   Reaction_t *origin;
-  const char *product_id;
+  mySymbol *symbol;
   mySpeciesReference *ref;
 
   origin = myReaction_getOrigin(reaction);
   num_of_products = Reaction_getNumProducts(origin);
 
   for (i = 0; i < num_of_products; i++) {
-    product_id = SpeciesReference_getSpecies(Reaction_getProduct(origin, i));
-    for (j = 0; j < num_of_species; j++) {
-      if (strcmp(product_id, Species_getId(species[j]->origin)) == 0) {
-        ref = mySpeciesReference_create();
-        mySpeciesReference_initAsProduct(ref, reaction, i);
-        mySpeciesReference_setSpecies(ref, species[j]);
-        myReaction_addProduct(reaction, ref);
-      }
+    symbol = mySymbolTable_find(symbols, SpeciesReference_getSpecies(Reaction_getProduct(origin, i)));
+    if (symbol != NULL && symbol->species != NULL) {
+      ref = mySpeciesReference_create();
+      mySpeciesReference_initAsProduct(ref, reaction, i);
+      mySpeciesReference_setSpecies(ref, symbol->species);
+      myReaction_addProduct(reaction, ref);
     }
   }
 }
 
-void myReaction_initReactants(myReaction *reaction, mySpecies **species, unsigned int num_of_species) {
-  unsigned int i, j;
+void myReaction_initReactants(myReaction *reaction, mySymbolTable *symbols) {
+  unsigned int i;
   unsigned int num_of_reactants;
   Reaction_t *origin;
-  const char *reactant_id;
+  mySymbol *symbol;
   mySpeciesReference *ref;
 
   origin = myReaction_getOrigin(reaction);
   num_of_reactants = Reaction_getNumReactants(origin);
 
   for (i = 0; i < num_of_reactants; i++) {
-    reactant_id = SpeciesReference_getSpecies(Reaction_getReactant(origin, i));
-    for (j = 0; j < num_of_species; j++) {
-      if (strcmp(reactant_id, Species_getId(species[j]->origin)) == 0) {
-        ref = mySpeciesReference_create();
-        mySpeciesReference_initAsReactant(ref, reaction, i);
-        mySpeciesReference_setSpecies(ref, species[j]);
-        myReaction_addReactant(reaction, ref);
-      }
+    symbol = mySymbolTable_find(symbols, SpeciesReference_getSpecies(Reaction_getReactant(origin, i)));
+    if (symbol != NULL && symbol->species != NULL) {
+      ref = mySpeciesReference_create();
+      mySpeciesReference_initAsReactant(ref, reaction, i);
+      mySpeciesReference_setSpecies(ref, symbol->species);
+      myReaction_addReactant(reaction, ref);
     }
   }
 }
@@ -13,6 +13,20 @@
  * ---------------------------------------------------------------------- -->*/
 #include "libsbmlsim/libsbmlsim.h"
 
+/* clear the statistics and timings of myResult object */
+static void init_statistics(myResult *result) {
+  result->num_of_steps = 0;
+  result->num_of_rejected_steps = 0;
+  result->num_of_rhs_evaluations = 0;
+  result->num_of_jacobian_evaluations = 0;
+  result->num_of_lu_decompositions = 0;
+  result->num_of_stiff_steps = 0;
+  result->num_of_method_switches = 0;
+  result->read_time = 0;
+  result->prepare_time = 0;
+  result->simulation_time = 0;
+}
+
 /* create contents of myResult object */
 myResult *create_myResult(Model_t *m, mySpecies *mySp[], myParameter *myParam[], myCompartment *myComp[], double sim_time, double dt, int print_interval) {
   int i;
@@ -46,6 +60,7 @@ myResult *create_myResult(Model_t *m, mySpecies *mySp[], myParameter *myParam[],
   for(i=0; i<num_of_compartments; i++){
     result->column_name_comp[i] = dupstr(Compartment_getId(myComp[i]->origin));
   }
+  init_statistics(result);
   return result;
 }
 
@@ -85,6 +100,7 @@ myResult *create_myResultf(Model_t *m, mySpecies *mySp[], myParameter *myParam[]
   for(i=0; i<num_of_compartments; i++){
     result->column_name_comp[i] = dupstr(Compartment_getId(myComp[i]->origin));
   }
+  init_statistics(result);
   return result;
 }
 
@@ -109,6 +125,7 @@ myResult *create_myResult_with_error(LibsbmlsimErrorCode code, const char *messa
   result->values_sp = NULL;
   result->values_param = NULL;
   result->values_comp = NULL;
+  init_statistics(result);
 
   return result;
 }
@@ -129,6 +146,8 @@ myResult *create_myResult_with_errorCode(LibsbmlsimErrorCode code)
       return create_myResult_with_error(code, "Internal SBML Parser Error");
     case SimulationFailed:
       return create_myResult_with_error(code, "Simulation Failed");
+    case InvalidArgument:
+      return create_myResult_with_error(code, "Invalid Argument");
     default:
       break;
   }
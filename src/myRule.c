@@ -12,6 +12,7 @@
  * in the file named "LICENSE.txt" included with this software distribution.
  * ---------------------------------------------------------------------- -->*/
 #include "libsbmlsim/myRule.h"
+#include "libsbmlsim/mySymbolTable.h"
 #include <stdlib.h>
 #include <sbml/SBMLTypes.h>
 
@@ -55,73 +56,28 @@ void myRule_free(myRule *rule) {
   free(rule);
 }
 
-void myRule_initTarget(
-    myRule *rule,
-    mySpecies **species, unsigned int num_of_species,
-    myParameter **parameters, unsigned int num_of_parameters,
-    myCompartment **compartments, unsigned int num_of_compartments,
-    myReaction **reactions, unsigned int num_of_reactions) {
-  unsigned int i, j;
+void myRule_initTarget(myRule *rule, mySymbolTable *symbols) {
   Rule_t *origin;
-  const char *origin_var;
-  mySpecies *sp;
-  myParameter *param;
-  myCompartment *comp;
-  myReaction *re;
-  mySpeciesReference *product, *reactant;
+  mySymbol *symbol;
 
   origin = myRule_getOrigin(rule);
-  origin_var = Rule_getVariable(origin);
-
-  for (i = 0; i < num_of_species; i++) {
-    sp = species[i];
-    if (strcmp(origin_var, Species_getId(sp->origin)) == 0) {
-      myRule_setTargetSpecies(rule, sp);
-      mySpecies_setDependingRule(sp, rule);
-      return;
-    }
-  }
-
-  for (i = 0; i < num_of_parameters; i++) {
-    param = parameters[i];
-    if (strcmp(origin_var, Parameter_getId(param->origin)) == 0) {
-      myRule_setTargetParameter(rule, param);
-      myParameter_setDependingRule(param, rule);
-      return;
-    }
-  }
-
-  for (i = 0; i < num_of_compartments; i++) {
-    comp = compartments[i];
-    if (strcmp(origin_var, Compartment_getId(comp->origin)) == 0) {
-      myRule_setTargetCompartment(rule, comp);
-      myCompartment_setDependingRule(comp, rule);
-      return;
-    }
+  symbol = mySymbolTable_find(symbols, Rule_getVariable(origin));
+  if (symbol == NULL) {
+    return;
   }
 
-  for (i=0; i < num_of_reactions; i++) {
-    re = reactions[i];
-
-    for (j = 0; j < re->num_of_products; j++) {
-      product = re->products[j];
-      if (SpeciesReference_isSetId(product->origin)
-          && strcmp(origin_var, SpeciesReference_getId(product->origin)) == 0) {
-        myRule_setTargetSpeciesReference(rule, product);
-        mySpeciesReference_setDependingRule(product, rule);
-        return;
-      }
-    }
-
-    for (j = 0; j < re->num_of_reactants; j++) {
-      reactant = re->reactants[j];
-      if (SpeciesReference_isSetId(reactant->origin)
-          && strcmp(origin_var, SpeciesReference_getId(reactant->origin)) == 0) {
-        myRule_setTargetSpeciesReference(rule, reactant);
-        mySpeciesReference_setDependingRule(reactant, rule);
-        return;
-      }
-    }
+  if (symbol->species != NULL) {
+    myRule_setTargetSpecies(rule, symbol->species);
+    mySpecies_setDependingRule(symbol->species, rule);
+  } else if (symbol->parameter != NULL) {
+    myRule_setTargetParameter(rule, symbol->parameter);
+    myParameter_setDependingRule(symbol->parameter, rule);
+  } else if (symbol->compartment != NULL) {
+    myRule_setTargetCompartment(rule, symbol->compartment);
+    myCompartment_setDependingRule(symbol->compartment, rule);
+  } else {
+    myRule_setTargetSpeciesReference(rule, symbol->species_reference);
+    mySpeciesReference_setDependingRule(symbol->species_reference, rule);
   }
 }
 
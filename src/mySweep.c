@@ -0,0 +1,350 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "libsbmlsim/libsbmlsim.h"
+
+#define SWEEP_INITIAL_CAPACITY 16
+
+SBMLSIM_EXPORT mySweepPoints *create_mySweepPoints(void) {
+  mySweepPoints *points = (mySweepPoints *)malloc(sizeof(mySweepPoints));
+  points->num_of_ids = 0;
+  points->ids = NULL;
+  points->num_of_points = 0;
+  points->values = NULL;
+  points->capacity = 0;
+  points->costs = NULL;
+  points->seed = 0;
+  return points;
+}
+
+SBMLSIM_EXPORT void free_mySweepPoints(mySweepPoints *points) {
+  int i;
+
+  if (points == NULL) {
+    return;
+  }
+  for (i = 0; i < points->num_of_ids; i++) {
+    free(points->ids[i]);
+  }
+  free(points->ids);
+  free(points->values);
+  free(points->costs);
+  free(points);
+}
+
+SBMLSIM_EXPORT int mySweepPoints_addId(mySweepPoints *points, const char *id) {
+  int i, j;
+  int n = points->num_of_ids;
+  double *values;
+
+  for (i = 0; i < n; i++) {
+    if (strcmp(points->ids[i], id) == 0) {
+      return i;
+    }
+  }
+  points->ids = (char **)realloc(points->ids, sizeof(char *) * (n + 1));
+  points->ids[n] = dupstr(id);
+  /* widen the rows, the new column keeps the value in the model */
+  if (points->capacity > 0) {
+    values = (double *)malloc(sizeof(double) * points->capacity * (n + 1));
+    for (i = 0; i < points->num_of_points; i++) {
+      for (j = 0; j < n; j++) {
+        values[i * (n + 1) + j] = points->values[i * n + j];
+      }
+      values[i * (n + 1) + n] = my_nan();
+    }
+    free(points->values);
+    points->values = values;
+  }
+  points->num_of_ids = n + 1;
+  return n;
+}
+
+SBMLSIM_EXPORT int mySweepPoints_addPoint(mySweepPoints *points) {
+  int i;
+  int p = points->num_of_points;
+
+  if (p == points->capacity) {
+    points->capacity = (points->capacity == 0) ? SWEEP_INITIAL_CAPACITY : points->capacity * 2;
+    points->values = (double *)realloc(points->values, sizeof(double) * points->capacity * (points->num_of_ids > 0 ? points->num_of_ids : 1));
+    if (points->costs != NULL) {
+      points->costs = (double *)realloc(points->costs, sizeof(double) * points->capacity);
+    }
+  }
+  if (points->costs != NULL) {
+    points->costs[p] = 0;
+  }
+  for (i = 0; i < points->num_of_ids; i++) {
+    points->values[p * points->num_of_ids + i] = my_nan();
+  }
+  points->num_of_points = p + 1;
+  return p;
+}
+
+SBMLSIM_EXPORT int mySweepPoints_setValue(mySweepPoints *points, int point, int index, double value) {
+  if (point < 0 || point >= points->num_of_points || index < 0 || index >= points->num_of_ids) {
+    return 0;
+  }
+  points->values[point * points->num_of_ids + index] = value;
+  return 1;
+}
+
+SBMLSIM_EXPORT double mySweepPoints_getValue(mySweepPoints *points, int point, int index) {
+  if (point < 0 || point >= points->num_of_points || index < 0 || index >= points->num_of_ids) {
+    return my_nan();
+  }
+  return points->values[point * points->num_of_ids + index];
+}
+
+SBMLSIM_EXPORT void mySweepPoints_setSeed(mySweepPoints *points, unsigned int seed) {
+  points->seed = seed;
+}
+
+SBMLSIM_EXPORT int mySweepPoints_setCost(mySweepPoints *points, int point, double cost) {
+  int i;
+
+  if (point < 0 || point >= points->num_of_points) {
+    return 0;
+  }
+  if (points->costs == NULL) {
+    /* 0 is unknown */
+    points->costs = (double *)malloc(sizeof(double) * points->capacity);
+    for (i = 0; i < points->capacity; i++) {
+      points->costs[i] = 0;
+    }
+  }
+  points->costs[point] = cost;
+  return 1;
+}
+
+SBMLSIM_EXPORT int mySweepPoints_setCostsFromResult(mySweepPoints *points, mySweepResult *result) {
+  int i;
+
+  if (result->point_times == NULL || result->num_of_points != points->num_of_points) {
+    return 0;
+  }
+  for (i = 0; i < points->num_of_points; i++) {
+    mySweepPoints_setCost(points, i, result->point_times[i]);
+  }
+  return 1;
+}
+
+mySweepResult *create_mySweepResult(myResult *first, int num_of_points) {
+  int i;
+  long k, n;
+  mySweepResult *result = (mySweepResult *)malloc(sizeof(mySweepResult));
+
+  result->error_code = NoError;
+  result->error_message = NULL;
+  result->num_of_points = num_of_points;
+  result->num_of_rows = first->num_of_rows;
+  result->num_of_columns_sp = first->num_of_columns_sp;
+  result->num_of_columns_param = first->num_of_columns_param;
+  result->num_of_columns_comp = first->num_of_columns_comp;
+  result->num_of_columns = first->num_of_columns_sp + first->num_of_columns_param + first->num_of_columns_comp;
+  result->column_name_time = dupstr(first->column_name_time);
+  result->column_name_sp = (const char **)malloc(sizeof(char *) * first->num_of_columns_sp);
+  result->column_name_param = (const char **)malloc(sizeof(char *) * first->num_of_columns_param);
+  result->column_name_comp = (const char **)malloc(sizeof(char *) * first->num_of_columns_comp);
+  for (i = 0; i < first->num_of_columns_sp; i++) {
+    result->column_name_sp[i] = dupstr(first->column_name_sp[i]);
+  }
+  for (i = 0; i < first->num_of_columns_param; i++) {
+    result->column_name_param[i] = dupstr(first->column_name_param[i]);
+  }
+  for (i = 0; i < first->num_of_columns_comp; i++) {
+    result->column_name_comp[i] = dupstr(first->column_name_comp[i]);
+  }
+  result->values_time = (double *)malloc(sizeof(double) * first->num_of_rows);
+  memcpy(result->values_time, first->values_time, sizeof(double) * first->num_of_rows);
+  n = (long)num_of_points * result->num_of_rows * result->num_of_columns;
+  result->values = (double *)malloc(sizeof(double) * (n > 0 ? n : 1));
+  for (k = 0; k < n; k++) {
+    result->values[k] = my_nan();
+  }
+  result->point_error_codes = (LibsbmlsimErrorCode *)malloc(sizeof(LibsbmlsimErrorCode) * (num_of_points > 0 ? num_of_points : 1));
+  for (i = 0; i < num_of_points; i++) {
+    result->point_error_codes[i] = NoError;
+  }
+  result->num_of_threads = 0;
+  result->point_times = NULL;
+  result->elapsed_time = 0;
+  result->worker_stats = NULL;
+  return result;
+}
+
+mySweepResult *create_mySweepResult_with_error(LibsbmlsimErrorCode code, const char *message) {
+  mySweepResult *result = (mySweepResult *)malloc(sizeof(mySweepResult));
+
+  result->error_code = code;
+  result->error_message = dupstr(message);
+  result->num_of_points = 0;
+  result->num_of_rows = 0;
+  result->num_of_columns = 0;
+  result->num_of_columns_sp = 0;
+  result->num_of_columns_param = 0;
+  result->num_of_columns_comp = 0;
+  result->column_name_time = NULL;
+  result->column_name_sp = NULL;
+  result->column_name_param = NULL;
+  result->column_name_comp = NULL;
+  result->values_time = NULL;
+  result->values = NULL;
+  result->point_error_codes = NULL;
+  result->num_of_threads = 0;
+  result->point_times = NULL;
+  result->elapsed_time = 0;
+  result->worker_stats = NULL;
+  return result;
+}
+
+mySweepResult *create_mySweepResult_with_errorCode(LibsbmlsimErrorCode code) {
+  /* share the default error messages with myResult */
+  myResult *res = create_myResult_with_errorCode(code);
+  mySweepResult *result = create_mySweepResult_with_error(code, res->error_message);
+
+  free_myResult(res);
+  return result;
+}
+
+void mySweepResult_store(mySweepResult *result, int point, myResult *res) {
+  int r, c;
+  double *row;
+
+  for (r = 0; r < result->num_of_rows; r++) {
+    row = result->values + ((long)point * result->num_of_rows + r) * result->num_of_columns;
+    for (c = 0; c < result->num_of_columns_sp; c++) {
+      *row++ = res->values_sp[r * res->num_of_columns_sp + c];
+    }
+    for (c = 0; c < result->num_of_columns_param; c++) {
+      *row++ = res->values_param[r * res->num_of_columns_param + c];
+    }
+    for (c = 0; c < result->num_of_columns_comp; c++) {
+      *row++ = res->values_comp[r * res->num_of_columns_comp + c];
+    }
+  }
+}
+
+SBMLSIM_EXPORT int mySweepResult_isError(mySweepResult *result) {
+  if (result->error_code == NoError)
+    return 0;
+  return 1;
+}
+
+SBMLSIM_EXPORT const char *mySweepResult_getErrorMessage(mySweepResult *result) {
+  return result->error_message;
+}
+
+SBMLSIM_EXPORT double mySweepResult_getWorkerUtilization(mySweepResult *result, int worker) {
+  if (worker < 0 || worker >= result->num_of_threads || result->worker_stats == NULL
+      || result->elapsed_time <= 0) {
+    return 0;
+  }
+  return result->worker_stats[worker].busy_time / result->elapsed_time;
+}
+
+SBMLSIM_EXPORT myResult *mySweepResult_getResult(mySweepResult *result, int point) {
+  int i, r, c;
+  myResult *res;
+  const double *row;
+
+  if (point < 0 || point >= result->num_of_points || result->error_code != NoError) {
+    return create_myResult_with_errorCode(InvalidArgument);
+  }
+  if (result->point_error_codes[point] != NoError) {
+    return create_myResult_with_errorCode(result->point_error_codes[point]);
+  }
+  res = (myResult *)malloc(sizeof(myResult));
+  res->error_code = NoError;
+  res->error_message = NULL;
+  res->num_of_rows = result->num_of_rows;
+  res->num_of_columns_sp = result->num_of_columns_sp;
+  res->num_of_columns_param = result->num_of_columns_param;
+  res->num_of_columns_comp = result->num_of_columns_comp;
+  res->column_name_time = dupstr(result->column_name_time);
+  res->column_name_sp = (const char **)malloc(sizeof(char *) * result->num_of_columns_sp);
+  res->column_name_param = (const char **)malloc(sizeof(char *) * result->num_of_columns_param);
+  res->column_name_comp = (const char **)malloc(sizeof(char *) * result->num_of_columns_comp);
+  for (i = 0; i < result->num_of_columns_sp; i++) {
+    res->column_name_sp[i] = dupstr(result->column_name_sp[i]);
+  }
+  for (i = 0; i < result->num_of_columns_param; i++) {
+    res->column_name_param[i] = dupstr(result->column_name_param[i]);
+  }
+  for (i = 0; i < result->num_of_columns_comp; i++) {
+    res->column_name_comp[i] = dupstr(result->column_name_comp[i]);
+  }
+  res->values_time = (double *)malloc(sizeof(double) * result->num_of_rows);
+  res->values_sp = (double *)malloc(sizeof(double) * result->num_of_rows * result->num_of_columns_sp);
+  res->values_param = (double *)malloc(sizeof(double) * result->num_of_rows * result->num_of_columns_param);
+  res->values_comp = (double *)malloc(sizeof(double) * result->num_of_rows * result->num_of_columns_comp);
+  memcpy(res->values_time, result->values_time, sizeof(double) * result->num_of_rows);
+  for (r = 0; r < result->num_of_rows; r++) {
+    row = result->values + ((long)point * result->num_of_rows + r) * result->num_of_columns;
+    for (c = 0; c < result->num_of_columns_sp; c++) {
+      res->values_sp[r * result->num_of_columns_sp + c] = *row++;
+    }
+    for (c = 0; c < result->num_of_columns_param; c++) {
+      res->values_param[r * result->num_of_columns_param + c] = *row++;
+    }
+    for (c = 0; c < result->num_of_columns_comp; c++) {
+      res->values_comp[r * result->num_of_columns_comp + c] = *row++;
+    }
+  }
+  res->values_time_fordelay = NULL;
+  res->num_of_delay_rows = 0;
+  res->num_of_steps = 0;
+  res->num_of_rejected_steps = 0;
+  res->num_of_rhs_evaluations = 0;
+  res->num_of_jacobian_evaluations = 0;
+  res->num_of_lu_decompositions = 0;
+  res->num_of_stiff_steps = 0;
+  res->num_of_method_switches = 0;
+  res->read_time = 0;
+  res->prepare_time = 0;
+  res->simulation_time = 0;
+  return res;
+}
+
+SBMLSIM_EXPORT void free_mySweepResult(mySweepResult *result) {
+  int i;
+
+  if (result == NULL) {
+    return;
+  }
+  if (result->column_name_time != NULL)
+    free((void *)result->column_name_time);
+  if (result->column_name_sp != NULL) {
+    for (i = 0; i < result->num_of_columns_sp; i++)
+      free((void *)result->column_name_sp[i]);
+    free(result->column_name_sp);
+  }
+  if (result->column_name_param != NULL) {
+    for (i = 0; i < result->num_of_columns_param; i++)
+      free((void *)result->column_name_param[i]);
+    free(result->column_name_param);
+  }
+  if (result->column_name_comp != NULL) {
+    for (i = 0; i < result->num_of_columns_comp; i++)
+      free((void *)result->column_name_comp[i]);
+    free(result->column_name_comp);
+  }
+  free(result->values_time);
+  free(result->values);
+  free(result->point_error_codes);
+  free(result->point_times);
+  free(result->worker_stats);
+  if (result->error_message != NULL)
+    free((void *)result->error_message);
+  free(result);
+}
@@ -0,0 +1,173 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "libsbmlsim/libsbmlsim.h"
+
+#define SYMBOL_TABLE_INITIAL_CAPACITY 64
+
+static SBMLSIM_THREAD_LOCAL mySymbolTable *current_table = NULL;
+
+/* FNV-1a */
+static unsigned int hash_of(const char *id) {
+  unsigned int hash = 2166136261U;
+  for (; *id != '\0'; id++) {
+    hash ^= (unsigned char)*id;
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+/* the slot of id, or the empty slot where it is to be added */
+static mySymbol *find_slot(mySymbol *symbols, unsigned int capacity, const char *id) {
+  unsigned int i = hash_of(id) & (capacity - 1);
+  while (symbols[i].id != NULL && strcmp(symbols[i].id, id) != 0) {
+    i = (i + 1) & (capacity - 1);
+  }
+  return &symbols[i];
+}
+
+static void grow(mySymbolTable *table) {
+  unsigned int i;
+  unsigned int capacity = table->capacity * 2;
+  mySymbol *symbols = (mySymbol *)calloc(capacity, sizeof(mySymbol));
+
+  for (i = 0; i < table->capacity; i++) {
+    if (table->symbols[i].id != NULL) {
+      *find_slot(symbols, capacity, table->symbols[i].id) = table->symbols[i];
+    }
+  }
+  free(table->symbols);
+  table->symbols = symbols;
+  table->capacity = capacity;
+}
+
+/* the new symbol of id, or NULL if id is already in the table */
+static mySymbol *add(mySymbolTable *table, const char *id, unsigned int index) {
+  mySymbol *symbol;
+
+  if (id == NULL) {
+    return NULL;
+  }
+  /* keep the load factor at most 1/2 */
+  if ((table->num_of_symbols + 1) * 2 > table->capacity) {
+    grow(table);
+  }
+  symbol = find_slot(table->symbols, table->capacity, id);
+  if (symbol->id != NULL) {
+    return NULL;
+  }
+  symbol->id = id;
+  symbol->index = index;
+  table->num_of_symbols++;
+  return symbol;
+}
+
+mySymbolTable *mySymbolTable_create(void) {
+  mySymbolTable *table = (mySymbolTable *)malloc(sizeof(mySymbolTable));
+  table->capacity = SYMBOL_TABLE_INITIAL_CAPACITY;
+  table->symbols = (mySymbol *)calloc(table->capacity, sizeof(mySymbol));
+  table->num_of_symbols = 0;
+  return table;
+}
+
+void mySymbolTable_free(mySymbolTable *table) {
+  if (table == NULL) {
+    return;
+  }
+  if (current_table == table) {
+    current_table = NULL;
+  }
+  free(table->symbols);
+  free(table);
+}
+
+void mySymbolTable_addSpecies(mySymbolTable *table, mySpecies **species, unsigned int num_of_species) {
+  unsigned int i;
+  mySymbol *symbol;
+  for (i = 0; i < num_of_species; i++) {
+    symbol = add(table, Species_getId(species[i]->origin), i);
+    if (symbol != NULL) {
+      symbol->species = species[i];
+    }
+  }
+}
+
+void mySymbolTable_addParameters(mySymbolTable *table, myParameter **parameters, unsigned int num_of_parameters) {
+  unsigned int i;
+  mySymbol *symbol;
+  for (i = 0; i < num_of_parameters; i++) {
+    symbol = add(table, Parameter_getId(parameters[i]->origin), i);
+    if (symbol != NULL) {
+      symbol->parameter = parameters[i];
+    }
+  }
+}
+
+void mySymbolTable_addCompartments(mySymbolTable *table, myCompartment **compartments, unsigned int num_of_compartments) {
+  unsigned int i;
+  mySymbol *symbol;
+  for (i = 0; i < num_of_compartments; i++) {
+    symbol = add(table, Compartment_getId(compartments[i]->origin), i);
+    if (symbol != NULL) {
+      symbol->compartment = compartments[i];
+    }
+  }
+}
+
+void mySymbolTable_addSpeciesReferences(mySymbolTable *table, myReaction **reactions, unsigned int num_of_reactions) {
+  unsigned int i, j;
+  mySymbol *symbol;
+  mySpeciesReference *ref;
+  for (i = 0; i < num_of_reactions; i++) {
+    for (j = 0; j < reactions[i]->num_of_products; j++) {
+      ref = reactions[i]->products[j];
+      if (SpeciesReference_isSetId(ref->origin)) {
+        symbol = add(table, SpeciesReference_getId(ref->origin), i);
+        if (symbol != NULL) {
+          symbol->species_reference = ref;
+        }
+      }
+    }
+    for (j = 0; j < reactions[i]->num_of_reactants; j++) {
+      ref = reactions[i]->reactants[j];
+      if (SpeciesReference_isSetId(ref->origin)) {
+        symbol = add(table, SpeciesReference_getId(ref->origin), i);
+        if (symbol != NULL) {
+          symbol->species_reference = ref;
+        }
+      }
+    }
+  }
+}
+
+mySymbol *mySymbolTable_find(mySymbolTable *table, const char *id) {
+  mySymbol *symbol;
+  if (table == NULL || id == NULL) {
+    return NULL;
+  }
+  symbol = find_slot(table->symbols, table->capacity, id);
+  if (symbol->id == NULL) {
+    return NULL;
+  }
+  return symbol;
+}
+
+mySymbolTable *mySymbolTable_attach(mySymbolTable *table) {
+  mySymbolTable *prev = current_table;
+  current_table = table;
+  return prev;
+}
+
+mySymbolTable *mySymbolTable_current(void) {
+  return current_table;
+}
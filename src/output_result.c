@@ -14,6 +14,85 @@
 #include <errno.h> 
 #include "libsbmlsim/libsbmlsim.h"
 
+/* size of the buffer of the writers, flushed by one fwrite() */
+#define OUTPUT_BUFFER_SIZE 65536
+
+typedef struct {
+  FILE *fp;
+  size_t length;
+  char *data;
+} output_buffer;
+
+static output_buffer *output_buffer_create(FILE *fp) {
+  output_buffer *out = (output_buffer *)malloc(sizeof(output_buffer));
+  out->fp = fp;
+  out->length = 0;
+  out->data = (char *)malloc(OUTPUT_BUFFER_SIZE);
+  return out;
+}
+
+static void output_flush(output_buffer *out) {
+  if (out->length > 0)
+    fwrite(out->data, 1, out->length, out->fp);
+  out->length = 0;
+}
+
+static void output_buffer_free(output_buffer *out) {
+  output_flush(out);
+  free(out->data);
+  free(out);
+}
+
+static void output_char(output_buffer *out, char c) {
+  if (out->length == OUTPUT_BUFFER_SIZE)
+    output_flush(out);
+  out->data[out->length++] = c;
+}
+
+static void output_string(output_buffer *out, const char *s) {
+  size_t length = strlen(s);
+  size_t n;
+
+  while (length > 0) {
+    if (out->length == OUTPUT_BUFFER_SIZE)
+      output_flush(out);
+    n = OUTPUT_BUFFER_SIZE - out->length;
+    if (n > length)
+      n = length;
+    memcpy(out->data + out->length, s, n);
+    out->length += n;
+    s += n;
+    length -= n;
+  }
+}
+
+/* the shortest representation of value which reads back to it, as
+ * printed by %.16g when that one does */
+static void output_double(output_buffer *out, double value) {
+  if (out->length + SBMLSIM_DOUBLE_BUFFER_SIZE > OUTPUT_BUFFER_SIZE)
+    output_flush(out);
+  out->length += sbmlsim_format_double(value, out->data + out->length);
+}
+
+/* num_of_columns values, each after a delimiter */
+static void output_values(output_buffer *out, const double *values,
+    int num_of_columns, char delimiter) {
+  int i;
+
+  for (i = 0; i < num_of_columns; i++) {
+    output_char(out, delimiter);
+    output_double(out, values[i]);
+  }
+}
+
+/* a line of time and num_of_columns values */
+static void output_row(output_buffer *out, double time, const double *values,
+    int num_of_columns, char delimiter) {
+  output_double(out, time);
+  output_values(out, values, num_of_columns, delimiter);
+  output_char(out, '\n');
+}
+
 SBMLSIM_EXPORT void print_result(myResult* result){
   output_result(result, stdout, ' ');
 }
@@ -28,6 +107,36 @@ SBMLSIM_EXPORT void write_csv(myResult* result, const char* file) {
   print_result_to_file(result, file, delimiter);
 }
 
+SBMLSIM_EXPORT void write_tsv(myResult* result, const char* file) {
+  char delimiter = '\t';
+  print_result_to_file(result, file, delimiter);
+}
+
+SBMLSIM_EXPORT void write_bifurcation_csv(myBifurcationResult* result, const char* file) {
+  FILE *fp = NULL;
+  output_buffer *out;
+  int i;
+  if ((fp = my_fopen(fp, file, "w")) != NULL) {
+    out = output_buffer_create(fp);
+    output_string(out, result->parameter_id);
+    output_char(out, ',');
+    output_string(out, result->variable_id);
+    output_char(out, ',');
+    output_string(out, result->variable_id);
+    output_char(out, '\n');
+    for (i = 0; i < result->num_of_points; i++) {
+      output_double(out, result->parameter_values[i]);
+      output_char(out, ',');
+      output_double(out, result->local_max[i]);
+      output_char(out, ',');
+      output_double(out, result->local_min[i]);
+      output_char(out, '\n');
+    }
+    output_buffer_free(out);
+    fclose(fp);
+  }
+}
+
 FILE* my_fopen(FILE* fp, const char* file, char* mode) {
 #ifdef _MSC_VER
   errno_t error;
@@ -54,60 +163,46 @@ void print_result_to_file(myResult* result, const char* file, char delimiter){
 }
 
 void output_result(myResult* result, FILE* fp, char delimiter){
-  int i, j;
-  double *value_time_p  = result->values_time;
-  double *value_sp_p    = result->values_sp;
-  double *value_param_p = result->values_param;
-  double *value_comp_p  = result->values_comp;
+  int i;
+  output_buffer *out = output_buffer_create(fp);
 
   /*  Column name (time) */
-  fprintf(fp, "%s", result->column_name_time);
+  output_string(out, result->column_name_time);
   /*  Column name (Species) */
   for (i = 0; i < result->num_of_columns_sp; i++) {
-    fprintf(fp, "%c%s", delimiter, result->column_name_sp[i]);
+    output_char(out, delimiter);
+    output_string(out, result->column_name_sp[i]);
   }
   /*  Column name (Parameters) */
   for (i = 0; i < result->num_of_columns_param; i++) {
-    fprintf(fp, "%c%s", delimiter, result->column_name_param[i]);
+    output_char(out, delimiter);
+    output_string(out, result->column_name_param[i]);
   }
   /*  Column name (Compartments) */
   for (i = 0; i < result->num_of_columns_comp; i++) {
-    fprintf(fp, "%c%s", delimiter, result->column_name_comp[i]);
+    output_char(out, delimiter);
+    output_string(out, result->column_name_comp[i]);
   }
-  fprintf(fp, "\n");
+  output_char(out, '\n');
 
   for (i = 0; i < result->num_of_rows; i++) {
-    fprintf(fp, "%.16g", *(value_time_p));
-    value_time_p++;
-    /*  Species */
-    for (j = 0; j < result->num_of_columns_sp; j++) {
-      fprintf(fp, "%c%.16g", delimiter, *(value_sp_p));
-      value_sp_p++;
-    }
-    /*  Parameters */
-    for (j = 0; j < result->num_of_columns_param; j++) {
-      fprintf(fp, "%c%.16g", delimiter, *(value_param_p));
-      value_param_p++;
-    }
-    /*  Compartments */
-    for (j = 0; j < result->num_of_columns_comp; j++) {
-      fprintf(fp, "%c%.16g", delimiter, *(value_comp_p));
-      value_comp_p++;
-    }
-    fprintf(fp, "\n");
+    output_double(out, result->values_time[i]);
+    /*  Species, Parameters and Compartments */
+    output_values(out, result->values_sp + (size_t)i * result->num_of_columns_sp, result->num_of_columns_sp, delimiter);
+    output_values(out, result->values_param + (size_t)i * result->num_of_columns_param, result->num_of_columns_param, delimiter);
+    output_values(out, result->values_comp + (size_t)i * result->num_of_columns_comp, result->num_of_columns_comp, delimiter);
+    output_char(out, '\n');
   }
+  output_buffer_free(out);
 }
 
 SBMLSIM_EXPORT void write_separate_result(myResult* result, const char* file_s, const char* file_p, const char* file_c) {
   FILE *fp_s = NULL;
   FILE *fp_p = NULL;
   FILE *fp_c = NULL;
-  int i, j;
+  output_buffer *out;
+  int i;
   char delimiter = ' ';
-  double *value_time_p  = result->values_time;
-  double *value_sp_p    = result->values_sp;
-  double *value_param_p = result->values_param;
-  double *value_comp_p  = result->values_comp;
 
   if ((fp_s = my_fopen(fp_s, file_s, "w")) == NULL) {
     return;
@@ -120,37 +215,23 @@ SBMLSIM_EXPORT void write_separate_result(myResult* result, const char* file_s,
   }
 
   /*  Species */
+  out = output_buffer_create(fp_s);
   for (i = 0; i < result->num_of_rows; i++) {
-    fprintf(fp_s, "%.16g", *(value_time_p));
-    value_time_p++;
-    for (j = 0; j < result->num_of_columns_sp; j++) {
-      fprintf(fp_s, "%c%.16g", delimiter, *(value_sp_p));
-      value_sp_p++;
-    }
-    fprintf(fp_s, "\n");
+    output_row(out, result->values_time[i], result->values_sp + (size_t)i * result->num_of_columns_sp, result->num_of_columns_sp, delimiter);
   }
+  output_buffer_free(out);
   /*  Parameters */
-  value_time_p  = result->values_time;
+  out = output_buffer_create(fp_p);
   for (i = 0; i < result->num_of_rows; i++) {
-    fprintf(fp_p, "%.16g", *(value_time_p));
-    value_time_p++;
-    for (j = 0; j < result->num_of_columns_param; j++) {
-      fprintf(fp_p, "%c%.16g", delimiter, *(value_param_p));
-      value_param_p++;
-    }
-    fprintf(fp_p, "\n");
+    output_row(out, result->values_time[i], result->values_param + (size_t)i * result->num_of_columns_param, result->num_of_columns_param, delimiter);
   }
+  output_buffer_free(out);
   /*  Compartments */
-  value_time_p  = result->values_time;
+  out = output_buffer_create(fp_c);
   for (i = 0; i < result->num_of_rows; i++) {
-    fprintf(fp_c, "%.16g", *(value_time_p));
-    value_time_p++;
-    for (j = 0; j < result->num_of_columns_comp; j++) {
-      fprintf(fp_c, "%c%.16g", delimiter, *(value_comp_p));
-      value_comp_p++;
-    }
-    fprintf(fp_c, "\n");
+    output_row(out, result->values_time[i], result->values_comp + (size_t)i * result->num_of_columns_comp, result->num_of_columns_comp, delimiter);
   }
+  output_buffer_free(out);
   fclose(fp_s);
   fclose(fp_p);
   fclose(fp_c);
@@ -209,28 +209,34 @@ void prepare_algebraic(boolean is_variable_step, Model_t *m, mySpecies *sp[],
   myASTNode *myNode = NULL;
   myASTNode *copied_myAST[MAX_COPIED_AST];
   unsigned int num_of_copied_myAST = 0;
+  mySymbolTable *symbols = mySymbolTable_current();
+  mySymbol *symbol;
+  boolean *in_reaction;
   /* find constant in calculation algebraic rule */
   /* reaction target(reactants and products) */
   TRACE(("Reaction\n"));
-  for(i=0; i<Model_getNumSpecies(m); i++){
-    flag = 0;
-    local_sp = (Species_t*)ListOf_get(Model_getListOfSpecies(m), i);
-    for(j=0; j<Model_getNumReactions(m); j++){
-      for(k=0; k<re[j]->num_of_products; k++){
-        if(strcmp(Species_getId(re[j]->products[k]->mySp->origin), Species_getId(local_sp)) == 0){
-          flag = 1;
-        }
+  in_reaction = (boolean*)calloc(Model_getNumSpecies(m) + 1, sizeof(boolean));
+  for(j=0; j<Model_getNumReactions(m); j++){
+    for(k=0; k<re[j]->num_of_products; k++){
+      symbol = mySymbolTable_find(symbols, Species_getId(re[j]->products[k]->mySp->origin));
+      if(symbol != NULL && symbol->species != NULL){
+        in_reaction[symbol->index] = true;
       }
-      for(k=0; k<re[j]->num_of_reactants; k++){
-        if(strcmp(Species_getId(re[j]->reactants[k]->mySp->origin), Species_getId(local_sp)) == 0){
-          flag = 1;
-        }
+    }
+    for(k=0; k<re[j]->num_of_reactants; k++){
+      symbol = mySymbolTable_find(symbols, Species_getId(re[j]->reactants[k]->mySp->origin));
+      if(symbol != NULL && symbol->species != NULL){
+        in_reaction[symbol->index] = true;
       }
     }
-    if(flag){
+  }
+  for(i=0; i<Model_getNumSpecies(m); i++){
+    if(in_reaction[i]){
+      local_sp = (Species_t*)ListOf_get(Model_getListOfSpecies(m), i);
       constants_in_alg[num_of_constants_in_alg++] = (char*)Species_getId(local_sp);
     }
   }
+  free(in_reaction);
   /* rule target */
   TRACE(("Rule\n"));
   for(i=0; i<Model_getNumRules(m); i++){
@@ -0,0 +1,158 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "libsbmlsim/libsbmlsim.h"
+#include <limits.h>
+
+static SBMLSIM_THREAD_LOCAL sbmlsim_context *current_context = NULL;
+
+sbmlsim_context *sbmlsim_context_create(unsigned int seed) {
+  unsigned int i;
+  sbmlsim_context *ctx = (sbmlsim_context *)malloc(sizeof(sbmlsim_context));
+  dsfmt_init_gen_rand(&ctx->rng, seed);
+  ctx->ast_memory_root_node = NULL;
+  ctx->ast_memory_last_node = NULL;
+  ctx->event_assignment_values = NULL;
+  for (i = 0; i < MAX_IDENTICAL_EVENTS; i++) {
+    ctx->event_assignment_rows[i] = NULL;
+  }
+  ctx->num_of_threads = 0;
+  ctx->rhs_min_reactions = PARALLEL_RHS_MIN_REACTIONS;
+  ctx->jacobian_min_variables = PARALLEL_JACOBIAN_MIN_VARIABLES;
+  ctx->team = NULL;
+  ctx->rhs = NULL;
+  ctx->model = NULL;
+  return ctx;
+}
+
+void sbmlsim_context_free(sbmlsim_context *ctx) {
+  ast_memory_node_t *node, *next;
+
+  if (ctx == NULL) {
+    return;
+  }
+  if (current_context == ctx) {
+    current_context = NULL;
+  }
+  /* ASTs of a model whose objects were not freed (bifurcation analysis) */
+  for (node = ctx->ast_memory_root_node; node != NULL; node = next) {
+    next = node->next;
+    ASTNode_free(node->ast);
+    free(node);
+  }
+  free(ctx->event_assignment_values);
+  parallel_rhs_free(ctx->rhs);
+  sbmlsim_team_free(ctx->team);
+  free(ctx);
+}
+
+void sbmlsim_context_seed(sbmlsim_context *ctx, unsigned int seed) {
+  dsfmt_init_gen_rand(&ctx->rng, seed);
+}
+
+void sbmlsim_context_seed_stream(sbmlsim_context *ctx, unsigned int seed, unsigned int stream) {
+  uint32_t key[2];
+
+  key[0] = seed;
+  key[1] = stream;
+  dsfmt_init_by_array(&ctx->rng, key, 2);
+}
+
+void sbmlsim_context_set_num_of_threads(sbmlsim_context *ctx, int num_of_threads) {
+  if (num_of_threads != ctx->num_of_threads) {
+    sbmlsim_context_release_rhs(ctx);
+    sbmlsim_team_free(ctx->team);
+    ctx->team = NULL;
+  }
+  ctx->num_of_threads = num_of_threads;
+}
+
+void sbmlsim_context_set_parallel_thresholds(sbmlsim_context *ctx, unsigned int min_reactions, unsigned int min_variables) {
+  ctx->rhs_min_reactions = min_reactions;
+  ctx->jacobian_min_variables = min_variables;
+}
+
+sbmlsim_team *sbmlsim_context_team(sbmlsim_context *ctx) {
+  if (ctx == NULL || ctx->num_of_threads == 1) {
+    return NULL;
+  }
+  if (ctx->team == NULL) {
+    /* started on first use, and kept for the following simulations */
+    ctx->team = sbmlsim_team_create(sbmlsim_num_of_workers(ctx->num_of_threads, INT_MAX));
+  }
+  return (sbmlsim_team_size(ctx->team) > 1) ? ctx->team : NULL;
+}
+
+parallel_rhs *sbmlsim_context_parallel_rhs(sbmlsim_context *ctx, mySpecies *sp[], unsigned int sp_num, myParameter *param[], unsigned int param_num, myCompartment *comp[], unsigned int comp_num, myReaction *re[], unsigned int re_num) {
+  sbmlsim_team *team;
+
+  if (ctx == NULL) {
+    return NULL;
+  }
+  if (ctx->rhs != NULL && ctx->rhs->re == re && ctx->rhs->re_num == re_num) {
+    return ctx->rhs;
+  }
+  if (re_num < 2 || re_num < ctx->rhs_min_reactions
+      || has_delay_val(sp, sp_num, param, param_num, comp, comp_num, re, re_num)) {
+    return NULL;
+  }
+  team = sbmlsim_context_team(ctx);
+  if (team == NULL) {
+    return NULL;
+  }
+  parallel_rhs_free(ctx->rhs);
+  ctx->rhs = parallel_rhs_create(re, re_num, team);
+  return ctx->rhs;
+}
+
+void sbmlsim_context_release_rhs(sbmlsim_context *ctx) {
+  parallel_rhs_free(ctx->rhs);
+  ctx->rhs = NULL;
+}
+
+int sbmlsim_context_random_index(sbmlsim_context *ctx, int n) {
+  int index;
+
+  if (n <= 1) {
+    return 0;
+  }
+  index = (int)(dsfmt_genrand_close_open(&ctx->rng) * n);
+  return (index < n) ? index : n - 1;
+}
+
+double sbmlsim_context_random(sbmlsim_context *ctx) {
+  return dsfmt_genrand_close_open(&ctx->rng);
+}
+
+double **sbmlsim_context_event_buffer(sbmlsim_context *ctx) {
+  unsigned int i;
+
+  if (ctx->event_assignment_values == NULL) {
+    ctx->event_assignment_values = (double *)malloc(sizeof(double) * MAX_IDENTICAL_EVENTS * MAX_EVENTASSIGNMENTS);
+    for (i = 0; i < MAX_IDENTICAL_EVENTS; i++) {
+      ctx->event_assignment_rows[i] = ctx->event_assignment_values + i * MAX_EVENTASSIGNMENTS;
+    }
+  }
+  /* calc_event() swaps the rows, they are always a permutation of the work area */
+  return ctx->event_assignment_rows;
+}
+
+sbmlsim_context *sbmlsim_context_attach(sbmlsim_context *ctx) {
+  sbmlsim_context *prev = current_context;
+  current_context = ctx;
+  return prev;
+}
+
+sbmlsim_context *sbmlsim_context_current(void) {
+  return current_context;
+}
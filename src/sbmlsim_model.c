@@ -0,0 +1,960 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "libsbmlsim/libsbmlsim.h"
+
+#define COPY_VALUE(dst, src) do { \
+  (dst)->value = (src)->value; \
+  (dst)->temp_value = (src)->temp_value; \
+  memcpy((dst)->k, (src)->k, sizeof((dst)->k)); \
+  memcpy((dst)->prev_val, (src)->prev_val, sizeof((dst)->prev_val)); \
+  memcpy((dst)->prev_k, (src)->prev_k, sizeof((dst)->prev_k)); \
+} while (0)
+
+/* the initial value, as set by my*_initWithModel() */
+#define SET_INITIAL_VALUE(obj, v) do { \
+  (obj)->value = (v); \
+  (obj)->temp_value = (v); \
+  (obj)->prev_val[0] = (v); \
+  (obj)->prev_val[1] = (v); \
+  (obj)->prev_val[2] = (v); \
+} while (0)
+
+#define OVERRIDE_INITIAL_CAPACITY 8
+
+static sbmlsim_model *create_model(SBMLDocument_t *d, Model_t *m, LibsbmlsimErrorCode error_code) {
+  sbmlsim_model *model = (sbmlsim_model *)malloc(sizeof(sbmlsim_model));
+
+  model->d = d;
+  model->m = m;
+  model->error_code = error_code;
+  model->ctx = sbmlsim_context_create((unsigned int)my_time(NULL));
+  model->is_prepared = false;
+  model->is_variable_step = false;
+  model->depends_on_grid = false;
+  model->sim_time = 0;
+  model->dt = 0;
+  model->print_interval = 0;
+  model->num_of_species = 0;
+  model->num_of_parameters = 0;
+  model->num_of_compartments = 0;
+  model->num_of_reactions = 0;
+  model->num_of_rules = 0;
+  model->num_of_events = 0;
+  model->num_of_initialAssignments = 0;
+  if (m != NULL) {
+    model->num_of_species = Model_getNumSpecies(m);
+    model->num_of_parameters = Model_getNumParameters(m);
+    model->num_of_compartments = Model_getNumCompartments(m);
+    model->num_of_reactions = Model_getNumReactions(m);
+    model->num_of_rules = Model_getNumRules(m);
+    model->num_of_events = Model_getNumEvents(m);
+    model->num_of_initialAssignments = Model_getNumInitialAssignments(m);
+  }
+  model->sp = NULL;
+  model->param = NULL;
+  model->comp = NULL;
+  model->re = NULL;
+  model->rule = NULL;
+  model->event = NULL;
+  model->initAssign = NULL;
+  model->algEq = NULL;
+  model->timeVarAssign = NULL;
+  model->mem = NULL;
+  model->cp_AST = NULL;
+  model->time = 0;
+  model->initial_values = NULL;
+  model->initial_events = NULL;
+  model->num_of_firing_times = 0;
+  model->initial_operands = NULL;
+  model->num_of_initial_operands = 0;
+  model->num_of_prepared_memory = 0;
+  model->replicas = NULL;
+  model->num_of_replicas = 0;
+  model->overrides = NULL;
+  model->num_of_overrides = 0;
+  model->override_capacity = 0;
+  model->source = NULL;
+  model->source_length = 0;
+  model->source_hash = 0;
+  model->read_time = 0;
+  model->num_of_threads = 0;
+  return model;
+}
+
+static sbmlsim_model *create_model_from_document(SBMLDocument_t *d) {
+  LibsbmlsimErrorCode error_code;
+
+  if (d == NULL)
+    return create_model(NULL, NULL, Unknown);
+  error_code = get_SBMLDocument_errorCode(d);
+  if (error_code != NoError)
+    return create_model(d, NULL, error_code);
+  return create_model(d, SBMLDocument_getModel(d), NoError);
+}
+
+SBMLSIM_EXPORT sbmlsim_model *sbmlsim_model_create(Model_t *m) {
+  return create_model(NULL, m, (m == NULL) ? InvalidArgument : NoError);
+}
+
+SBMLSIM_EXPORT sbmlsim_model *sbmlsim_model_create_from_file(const char *file) {
+  sbmlsim_model *model;
+  double start = sbmlsim_wall_time();
+
+  model = create_model_from_document(readSBMLFromFile(file));
+  model->read_time = sbmlsim_wall_time() - start;
+  return model;
+}
+
+SBMLSIM_EXPORT sbmlsim_model *sbmlsim_model_create_from_string(const char *str) {
+  sbmlsim_model *model;
+  double start = sbmlsim_wall_time();
+
+  model = create_model_from_document(readSBMLFromString(str));
+  model->read_time = sbmlsim_wall_time() - start;
+  return model;
+}
+
+SBMLSIM_EXPORT sbmlsim_model *sbmlsim_model_create_from_document(SBMLDocument_t *d) {
+  if (d == NULL || SBMLDocument_getModel(d) == NULL)
+    return create_model(d, NULL, InvalidArgument);
+  return create_model(d, SBMLDocument_getModel(d), NoError);
+}
+
+SBMLSIM_EXPORT double sbmlsim_model_get_read_time(sbmlsim_model *model) {
+  return (model == NULL) ? 0 : model->read_time;
+}
+
+/* operand i of the initial assignments, then of the time variant
+ * assignments */
+static equation *assignment_equation(sbmlsim_model *model, unsigned int i) {
+  if (i < model->num_of_initialAssignments)
+    return model->initAssign[i]->eq;
+  return model->timeVarAssign->eq[i - model->num_of_initialAssignments];
+}
+
+/* save the state of the objects into the model (save), or restore it */
+static void copy_state(sbmlsim_model *model, boolean save) {
+  sbmlsim_model_value *v = model->initial_values;
+  sbmlsim_model_event *e;
+  myEvent *ev;
+  equation *eq;
+  unsigned int i, j;
+
+  for (i = 0; i < model->num_of_species; i++, v++) {
+    if (save) COPY_VALUE(v, model->sp[i]); else COPY_VALUE(model->sp[i], v);
+  }
+  for (i = 0; i < model->num_of_parameters; i++, v++) {
+    if (save) COPY_VALUE(v, model->param[i]); else COPY_VALUE(model->param[i], v);
+  }
+  for (i = 0; i < model->num_of_compartments; i++, v++) {
+    if (save) COPY_VALUE(v, model->comp[i]); else COPY_VALUE(model->comp[i], v);
+  }
+  for (i = 0; i < model->num_of_reactions; i++) {
+    for (j = 0; j < model->re[i]->num_of_products; j++, v++) {
+      if (save) COPY_VALUE(v, model->re[i]->products[j]); else COPY_VALUE(model->re[i]->products[j], v);
+    }
+    for (j = 0; j < model->re[i]->num_of_reactants; j++, v++) {
+      if (save) COPY_VALUE(v, model->re[i]->reactants[j]); else COPY_VALUE(model->re[i]->reactants[j], v);
+    }
+  }
+  for (i = 0; i < model->num_of_events; i++) {
+    ev = model->event[i];
+    e = &model->initial_events[i];
+    if (save) {
+      e->is_able_to_fire = ev->is_able_to_fire;
+      e->num_of_delayed_events_que = ev->num_of_delayed_events_que;
+      e->next_firing_index = ev->next_firing_index;
+      e->firing_times = NULL;
+      if (ev->firing_times != NULL) {
+        e->firing_times = (double *)malloc(sizeof(double) * model->num_of_firing_times);
+        memcpy(e->firing_times, ev->firing_times, sizeof(double) * model->num_of_firing_times);
+      }
+    } else {
+      ev->is_able_to_fire = e->is_able_to_fire;
+      ev->num_of_delayed_events_que = e->num_of_delayed_events_que;
+      ev->next_firing_index = e->next_firing_index;
+      if (ev->firing_times != NULL) {
+        memcpy(ev->firing_times, e->firing_times, sizeof(double) * model->num_of_firing_times);
+      }
+    }
+  }
+  for (i = 0; i < model->num_of_initial_operands; i++) {
+    eq = assignment_equation(model, i);
+    if (save) {
+      model->initial_operands[i] = (double **)malloc(sizeof(double *) * (eq->math_length + 1));
+      memcpy(model->initial_operands[i], eq->number, sizeof(double *) * eq->math_length);
+    } else {
+      memcpy(eq->number, model->initial_operands[i], sizeof(double *) * eq->math_length);
+    }
+  }
+  if (save) {
+    model->num_of_prepared_memory = model->mem->num_of_allocated_memory;
+  } else {
+    /* the initial values of the operands allocated by the last simulation */
+    for (i = model->num_of_prepared_memory; i < model->mem->num_of_allocated_memory; i++) {
+      free(model->mem->memory[i]);
+    }
+    model->mem->num_of_allocated_memory = model->num_of_prepared_memory;
+  }
+  model->time = 0;
+}
+
+static void save_state(sbmlsim_model *model) {
+  unsigned int i, num_of_values;
+
+  num_of_values = model->num_of_species + model->num_of_parameters + model->num_of_compartments;
+  for (i = 0; i < model->num_of_reactions; i++) {
+    num_of_values += model->re[i]->num_of_products + model->re[i]->num_of_reactants;
+  }
+  model->initial_values = (sbmlsim_model_value *)malloc(sizeof(sbmlsim_model_value) * (num_of_values + 1));
+  model->initial_events = (sbmlsim_model_event *)malloc(sizeof(sbmlsim_model_event) * (model->num_of_events + 1));
+  /* as create_mySBML_objects() */
+  model->num_of_firing_times = (model->dt > 0 && model->sim_time > 0) ? (unsigned int)(model->sim_time / model->dt) : 0;
+  model->num_of_initial_operands = model->num_of_initialAssignments + model->timeVarAssign->num_of_time_variant_assignments;
+  model->initial_operands = (double ***)malloc(sizeof(double **) * (model->num_of_initial_operands + 1));
+  copy_state(model, true);
+}
+
+static void free_replicas(sbmlsim_model *model) {
+  int i;
+
+  for (i = 0; i < model->num_of_replicas; i++) {
+    model_replica_free(&model->replicas[i]);
+  }
+  free(model->replicas);
+  model->replicas = NULL;
+  model->num_of_replicas = 0;
+}
+
+static void free_objects(sbmlsim_model *model) {
+  sbmlsim_context *prev_ctx;
+  unsigned int i;
+
+  free_replicas(model);
+  if (!model->is_prepared)
+    return;
+  if (model->initial_values != NULL) {
+    for (i = 0; i < model->num_of_events; i++) {
+      free(model->initial_events[i].firing_times);
+    }
+    for (i = 0; i < model->num_of_initial_operands; i++) {
+      free(model->initial_operands[i]);
+    }
+    free(model->initial_values);
+    free(model->initial_events);
+    free(model->initial_operands);
+    model->initial_values = NULL;
+    model->initial_events = NULL;
+    model->initial_operands = NULL;
+    model->num_of_initial_operands = 0;
+  }
+  /* the ASTs of the objects are the ones of the context of the model */
+  prev_ctx = sbmlsim_context_attach(model->ctx);
+  free_mySBML_objects(model->m, model->sp, model->param, model->comp,
+      model->re, model->rule, model->event, model->initAssign, model->algEq,
+      model->timeVarAssign, model->mem, model->cp_AST);
+  sbmlsim_context_attach(prev_ctx);
+  model->algEq = NULL;
+  model->timeVarAssign = NULL;
+  model->mem = NULL;
+  model->cp_AST = NULL;
+  model->is_prepared = false;
+}
+
+/* write the values of the local parameters set by
+ * sbmlsim_model_set_local_parameter() into the model while its equations
+ * are prepared (the local parameters are folded into the equations as
+ * numbers), keeping the values of the model in values and is_set; and
+ * write these back (set is false) */
+static void swap_local_parameters(sbmlsim_model *model, double *values,
+    boolean *is_set, boolean set) {
+  sbmlsim_model_override *o;
+  unsigned int i;
+
+  for (i = 0; i < model->num_of_overrides; i++) {
+    o = &model->overrides[i];
+    if (o->kind != SBMLSIM_OVERRIDE_LOCAL_PARAMETER)
+      continue;
+    if (set) {
+      values[i] = Parameter_getValue(o->local_parameter);
+      is_set[i] = Parameter_isSetValue(o->local_parameter);
+      Parameter_setValue(o->local_parameter, o->value);
+    } else if (is_set[i]) {
+      Parameter_setValue(o->local_parameter, values[i]);
+    } else {
+      Parameter_unsetValue(o->local_parameter);
+    }
+  }
+}
+
+static void prepare_objects(sbmlsim_model *model, boolean is_variable_step,
+    double sim_time, double dt, int print_interval) {
+  sbmlsim_context *prev_ctx;
+  double *local_values;
+  boolean *local_is_set;
+  unsigned int i;
+
+  free_objects(model);
+  prev_ctx = sbmlsim_context_attach(model->ctx);
+  model->mem = allocated_memory_create();
+  model->cp_AST = copied_AST_create();
+  model->sp = (mySpecies **)malloc(sizeof(mySpecies *) * model->num_of_species);
+  model->param = (myParameter **)malloc(sizeof(myParameter *) * model->num_of_parameters);
+  model->comp = (myCompartment **)malloc(sizeof(myCompartment *) * model->num_of_compartments);
+  model->re = (myReaction **)malloc(sizeof(myReaction *) * model->num_of_reactions);
+  model->rule = (myRule **)malloc(sizeof(myRule *) * model->num_of_rules);
+  model->event = (myEvent **)malloc(sizeof(myEvent *) * model->num_of_events);
+  model->initAssign = (myInitialAssignment **)malloc(sizeof(myInitialAssignment *) * model->num_of_initialAssignments);
+  model->algEq = NULL;
+  model->timeVarAssign = NULL;
+  model->time = 0;
+  local_values = (double *)malloc(sizeof(double) * (model->num_of_overrides + 1));
+  local_is_set = (boolean *)malloc(sizeof(boolean) * (model->num_of_overrides + 1));
+  swap_local_parameters(model, local_values, local_is_set, true);
+  create_mySBML_objects(is_variable_step, model->m, model->sp, model->param,
+      model->comp, model->re, model->rule, model->event, model->initAssign,
+      &model->algEq, &model->timeVarAssign, sim_time, dt, &model->time,
+      model->mem, model->cp_AST, print_interval);
+  swap_local_parameters(model, local_values, local_is_set, false);
+  free(local_values);
+  free(local_is_set);
+  sbmlsim_context_attach(prev_ctx);
+  model->is_prepared = true;
+  model->is_variable_step = is_variable_step;
+  model->sim_time = sim_time;
+  model->dt = dt;
+  model->print_interval = print_interval;
+  /* buffers of delay() and queues of delayed events are sized by sim_time / dt */
+  model->depends_on_grid = has_delay_val(model->sp, model->num_of_species,
+      model->param, model->num_of_parameters, model->comp,
+      model->num_of_compartments, model->re, model->num_of_reactions);
+  for (i = 0; i < model->num_of_events; i++) {
+    if (model->event[i]->event_delay != NULL)
+      model->depends_on_grid = true;
+  }
+  if (!is_variable_step) {
+    save_state(model);
+  }
+}
+
+static boolean is_species_override(int kind) {
+  return kind == SBMLSIM_OVERRIDE_SPECIES_AMOUNT || kind == SBMLSIM_OVERRIDE_SPECIES_CONCENTRATION;
+}
+
+/* write the initial values set by sbmlsim_model_set_*() into the
+ * objects, the compartments before the species converted by their size.
+ * The value of a species is the amount or the concentration which it
+ * declares, the other one is found from the size of its compartment by
+ * the simulation: the species of a compartment whose size is set keep
+ * the quantity they declare and the other one follows the new size, as
+ * when the size is set in the model */
+static void apply_overrides(sbmlsim_model *model) {
+  sbmlsim_model_override *o;
+  mySpecies *sp;
+  double value;
+  unsigned int i;
+
+  for (i = 0; i < model->num_of_overrides; i++) {
+    o = &model->overrides[i];
+    if (o->kind == SBMLSIM_OVERRIDE_PARAMETER) {
+      SET_INITIAL_VALUE(model->param[o->index], o->value);
+    } else if (o->kind == SBMLSIM_OVERRIDE_COMPARTMENT) {
+      SET_INITIAL_VALUE(model->comp[o->index], o->value);
+    }
+  }
+  for (i = 0; i < model->num_of_overrides; i++) {
+    o = &model->overrides[i];
+    if (!is_species_override(o->kind))
+      continue;
+    sp = model->sp[o->index];
+    value = o->value;
+    if (sp->locating_compartment != NULL) {
+      if (o->kind == SBMLSIM_OVERRIDE_SPECIES_AMOUNT && sp->is_concentration)
+        value /= sp->locating_compartment->value;
+      else if (o->kind == SBMLSIM_OVERRIDE_SPECIES_CONCENTRATION && sp->is_amount)
+        value *= sp->locating_compartment->value;
+    }
+    SET_INITIAL_VALUE(sp, value);
+  }
+}
+
+/* index of id in list, or -1 */
+static int find_id(ListOf_t *list, const char *id) {
+  unsigned int i;
+  const char *sid;
+
+  for (i = 0; i < ListOf_size(list); i++) {
+    sid = SBase_getId(ListOf_get(list, i));
+    if (sid != NULL && strcmp(sid, id) == 0)
+      return (int)i;
+  }
+  return -1;
+}
+
+/* add the value of a target, or replace the one already set */
+static void add_override(sbmlsim_model *model, int kind, unsigned int index,
+    Parameter_t *local_parameter, double value) {
+  sbmlsim_model_override *o;
+  unsigned int i;
+
+  for (i = 0; i < model->num_of_overrides; i++) {
+    o = &model->overrides[i];
+    if ((o->kind == kind || (is_species_override(o->kind) && is_species_override(kind)))
+        && o->index == index && o->local_parameter == local_parameter) {
+      break;
+    }
+  }
+  if (i == model->num_of_overrides) {
+    if (i == model->override_capacity) {
+      model->override_capacity = (model->override_capacity == 0) ? OVERRIDE_INITIAL_CAPACITY : model->override_capacity * 2;
+      model->overrides = (sbmlsim_model_override *)realloc(model->overrides, sizeof(sbmlsim_model_override) * model->override_capacity);
+    }
+    model->num_of_overrides++;
+  }
+  o = &model->overrides[i];
+  o->kind = kind;
+  o->index = index;
+  o->local_parameter = local_parameter;
+  o->value = value;
+}
+
+SBMLSIM_EXPORT int sbmlsim_model_set_value(sbmlsim_model *model, const char *id, double value) {
+  int index;
+
+  if (model == NULL || model->m == NULL || id == NULL)
+    return 0;
+  if ((index = find_id(Model_getListOfSpecies(model->m), id)) >= 0) {
+    /* as the parameter sweep */
+    add_override(model, Species_isSetInitialAmount(Model_getSpecies(model->m, index)) ?
+        SBMLSIM_OVERRIDE_SPECIES_AMOUNT : SBMLSIM_OVERRIDE_SPECIES_CONCENTRATION,
+        (unsigned int)index, NULL, value);
+  } else if ((index = find_id(Model_getListOfParameters(model->m), id)) >= 0) {
+    add_override(model, SBMLSIM_OVERRIDE_PARAMETER, (unsigned int)index, NULL, value);
+  } else if ((index = find_id(Model_getListOfCompartments(model->m), id)) >= 0) {
+    add_override(model, SBMLSIM_OVERRIDE_COMPARTMENT, (unsigned int)index, NULL, value);
+  } else {
+    return 0;
+  }
+  return 1;
+}
+
+static int set_species_value(sbmlsim_model *model, int kind, const char *id, double value) {
+  int index;
+
+  if (model == NULL || model->m == NULL || id == NULL)
+    return 0;
+  if ((index = find_id(Model_getListOfSpecies(model->m), id)) < 0)
+    return 0;
+  add_override(model, kind, (unsigned int)index, NULL, value);
+  return 1;
+}
+
+SBMLSIM_EXPORT int sbmlsim_model_set_initial_amount(sbmlsim_model *model, const char *id, double value) {
+  return set_species_value(model, SBMLSIM_OVERRIDE_SPECIES_AMOUNT, id, value);
+}
+
+SBMLSIM_EXPORT int sbmlsim_model_set_initial_concentration(sbmlsim_model *model, const char *id, double value) {
+  return set_species_value(model, SBMLSIM_OVERRIDE_SPECIES_CONCENTRATION, id, value);
+}
+
+static boolean has_delay(const ASTNode_t *node) {
+  unsigned int i;
+
+  if (ASTNode_getType(node) == AST_FUNCTION_DELAY)
+    return true;
+  for (i = 0; i < ASTNode_getNumChildren(node); i++) {
+    if (has_delay(ASTNode_getChild(node, i)))
+      return true;
+  }
+  return false;
+}
+
+model_replica *sbmlsim_model_replicas(sbmlsim_model *model, int num_of_replicas) {
+  double *local_values;
+  boolean *local_is_set;
+  int i;
+
+  if (model->replicas != NULL && model->num_of_replicas == num_of_replicas)
+    return model->replicas;
+  free_replicas(model);
+  model->replicas = (model_replica *)malloc(sizeof(model_replica) * num_of_replicas);
+  local_values = (double *)malloc(sizeof(double) * (model->num_of_overrides + 1));
+  local_is_set = (boolean *)malloc(sizeof(boolean) * (model->num_of_overrides + 1));
+  swap_local_parameters(model, local_values, local_is_set, true);
+  for (i = 0; i < num_of_replicas; i++) {
+    model_replica_init(&model->replicas[i], model->m, model->sim_time,
+        model->dt, model->print_interval);
+  }
+  swap_local_parameters(model, local_values, local_is_set, false);
+  free(local_values);
+  free(local_is_set);
+  model->num_of_replicas = num_of_replicas;
+  return model->replicas;
+}
+
+/* prepare the equation of the kinetic law of reaction i again, as
+ * create_mySBML_objects(). Returns false if the reaction can not be
+ * prepared alone: a fast reaction, whose equilibrium is solved with the
+ * other ones, or a kinetic law with delay(), whose buffers are created
+ * with the other objects */
+static boolean update_kinetic_law(sbmlsim_model *model, unsigned int i) {
+  myReaction *re = model->re[i];
+  KineticLaw_t *kl = Reaction_getKineticLaw(re->origin);
+  ASTNode_t *node;
+  mySymbolTable *symbols, *prev_symbols;
+  sbmlsim_context *prev_ctx;
+  double *local_values;
+  boolean *local_is_set;
+
+  if (re->is_fast || kl == NULL || KineticLaw_getMath(kl) == NULL)
+    return false;
+  node = ASTNode_deepCopy(KineticLaw_getMath(kl));
+  prev_ctx = sbmlsim_context_attach(model->ctx);
+  symbols = mySymbolTable_create();
+  mySymbolTable_addSpecies(symbols, model->sp, model->num_of_species);
+  mySymbolTable_addParameters(symbols, model->param, model->num_of_parameters);
+  mySymbolTable_addCompartments(symbols, model->comp, model->num_of_compartments);
+  mySymbolTable_addSpeciesReferences(symbols, model->re, model->num_of_reactions);
+  prev_symbols = mySymbolTable_attach(symbols);
+  alter_tree_structure(model->m, &node, NULL, 0, model->cp_AST);
+  if (has_delay(node)) {
+    ASTNode_free(node);
+    mySymbolTable_attach(prev_symbols);
+    mySymbolTable_free(symbols);
+    sbmlsim_context_attach(prev_ctx);
+    return false;
+  }
+  local_values = (double *)malloc(sizeof(double) * (model->num_of_overrides + 1));
+  local_is_set = (boolean *)malloc(sizeof(boolean) * (model->num_of_overrides + 1));
+  swap_local_parameters(model, local_values, local_is_set, true);
+  set_local_para_as_value(node, kl);
+  swap_local_parameters(model, local_values, local_is_set, false);
+  free(local_values);
+  free(local_is_set);
+  re->eq->math_length = get_equation(model->is_variable_step, model->m,
+      re->eq, model->sp, model->param, model->comp, model->re, node, 0,
+      model->sim_time, model->dt, &model->time, NULL, NULL, 0, NULL,
+      model->mem, model->print_interval);
+  mySymbolTable_attach(prev_symbols);
+  mySymbolTable_free(symbols);
+  add_ast_memory_node(node, __FILE__, __LINE__);
+  sbmlsim_context_attach(prev_ctx);
+  return true;
+}
+
+/* prepare the kinetic law of reaction i again with the values set to
+ * its local parameters, or the whole model for the next simulation */
+static void update_local_parameters(sbmlsim_model *model, unsigned int i) {
+  /* the objects of the variable step methods are prepared by each simulation */
+  if (!model->is_prepared || model->is_variable_step)
+    return;
+  copy_state(model, false);
+  free_replicas(model);
+  if (!update_kinetic_law(model, i)) {
+    free_objects(model);
+    return;
+  }
+  /* the constants of the new equation are kept by the next restore */
+  model->num_of_prepared_memory = model->mem->num_of_allocated_memory;
+}
+
+SBMLSIM_EXPORT int sbmlsim_model_set_local_parameter(sbmlsim_model *model, const char *reaction_id, const char *id, double value) {
+  KineticLaw_t *kl;
+  Parameter_t *p;
+  unsigned int i;
+  int index;
+
+  if (model == NULL || model->m == NULL || reaction_id == NULL || id == NULL)
+    return 0;
+  if ((index = find_id(Model_getListOfReactions(model->m), reaction_id)) < 0)
+    return 0;
+  kl = Reaction_getKineticLaw(Model_getReaction(model->m, index));
+  if (kl == NULL)
+    return 0;
+  for (i = 0; i < KineticLaw_getNumParameters(kl); i++) {
+    p = KineticLaw_getParameter(kl, i);
+    if (strcmp(id, Parameter_getId(p)) == 0) {
+      add_override(model, SBMLSIM_OVERRIDE_LOCAL_PARAMETER, (unsigned int)index, p, value);
+      update_local_parameters(model, (unsigned int)index);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+SBMLSIM_EXPORT void sbmlsim_model_reset_values(sbmlsim_model *model) {
+  sbmlsim_model_override *o;
+  unsigned int i, j, num_of_overrides;
+
+  if (model == NULL)
+    return;
+  num_of_overrides = model->num_of_overrides;
+  model->num_of_overrides = 0;
+  /* the kinetic laws with the values of the model, once for each reaction */
+  for (i = 0; i < num_of_overrides; i++) {
+    o = &model->overrides[i];
+    if (o->kind != SBMLSIM_OVERRIDE_LOCAL_PARAMETER)
+      continue;
+    for (j = 0; j < i; j++) {
+      if (model->overrides[j].kind == SBMLSIM_OVERRIDE_LOCAL_PARAMETER && model->overrides[j].index == o->index)
+        break;
+    }
+    if (j == i)
+      update_local_parameters(model, o->index);
+  }
+}
+
+SBMLSIM_EXPORT int sbmlsim_model_update(sbmlsim_model *model, const char **ids, int num_of_ids) {
+  boolean updated = true;
+  boolean is_amount;
+  mySpecies *sp;
+  Compartment_t *c;
+  int i, index;
+
+  if (model == NULL || model->m == NULL)
+    return 0;
+  /* the model no longer matches the SBML text it was cached with */
+  free(model->source);
+  model->source = NULL;
+  model->source_length = 0;
+  model->source_hash = 0;
+  /* the next simulation prepares the objects of the model as it is (the
+   * ones of the variable step methods are prepared by each simulation) */
+  if (!model->is_prepared || model->is_variable_step)
+    return 1;
+  if (ids == NULL) {
+    free_objects(model);
+    return 0;
+  }
+  /* the objects as they were prepared, whose values are read again */
+  copy_state(model, false);
+  for (i = 0; i < num_of_ids && updated; i++) {
+    if (ids[i] == NULL) {
+      updated = false;
+    } else if ((index = find_id(Model_getListOfSpecies(model->m), ids[i])) >= 0) {
+      sp = model->sp[index];
+      is_amount = sp->is_amount;
+      mySpecies_initWithModel(sp, model->m, index);
+      /* the equations were prepared for the unit of the species */
+      updated = (sp->is_amount == is_amount);
+      COPY_VALUE(&model->initial_values[index], sp);
+    } else if ((index = find_id(Model_getListOfParameters(model->m), ids[i])) >= 0) {
+      myParameter_initWithModel(model->param[index], model->m, index);
+      COPY_VALUE(&model->initial_values[model->num_of_species + index], model->param[index]);
+    } else if ((index = find_id(Model_getListOfCompartments(model->m), ids[i])) >= 0) {
+      /* as myCompartment_initWithModel(), keeping its species */
+      c = (Compartment_t *)ListOf_get(Model_getListOfCompartments(model->m), index);
+      SET_INITIAL_VALUE(model->comp[index], Compartment_isSetSize(c) ? Compartment_getSize(c) : 1.0);
+      COPY_VALUE(&model->initial_values[model->num_of_species + model->num_of_parameters + index], model->comp[index]);
+    } else if ((index = find_id(Model_getListOfReactions(model->m), ids[i])) >= 0) {
+      /* the replicas are prepared again with the new kinetic law */
+      free_replicas(model);
+      updated = update_kinetic_law(model, (unsigned int)index);
+    } else {
+      /* rules, events, ... are prepared with the whole model */
+      updated = false;
+    }
+  }
+  if (!updated) {
+    free_objects(model);
+    return 0;
+  }
+  /* the constants of the new equations are kept by the next restore */
+  model->num_of_prepared_memory = model->mem->num_of_allocated_memory;
+  return 1;
+}
+
+SBMLSIM_EXPORT void sbmlsim_model_free(sbmlsim_model *model) {
+  if (model == NULL)
+    return;
+  free_objects(model);
+  free(model->overrides);
+  free(model->source);
+  sbmlsim_context_free(model->ctx);
+  if (model->d != NULL)
+    SBMLDocument_free(model->d);
+  free(model);
+}
+
+myResult *sbmlsim_model_run(sbmlsim_model *model, sbmlsim_context *ctx,
+    double sim_time, double dt, int print_interval, int print_amount,
+    int method, int use_lazy_method, double atol, double rtol, double facmax) {
+  Model_t *m = model->m;
+  int order = 0;
+  int is_explicit = 0;
+  char *method_name;
+  /* prepare return value */
+  myResult *result, *rtn = NULL;
+  boolean is_variable_step = false;
+  boolean has_delay;
+  double start, prepared;
+
+  /* for variable stepsize */
+  int err_zero_flag = 0;
+
+  sbmlsim_context *prev_ctx;
+
+  if (m == NULL)
+    return NULL;
+
+  /* Check atol, rtol and facmax, whether it is set to 0.0 */
+  if (atol == 0.0) {
+    atol = ABSOLUTE_ERROR_TOLERANCE;
+  }
+  if (rtol == 0.0) {
+    rtol = RELATIVE_ERROR_TOLERANCE;
+  }
+  if (facmax == 0.0) {
+    facmax = DEFAULT_FACMAX;
+  }
+
+  switch(method) {
+    case MTHD_RUNGE_KUTTA: /*  Runge-Kutta */
+      method_name = MTHD_NAME_RUNGE_KUTTA;
+      break;
+    case MTHD_BACKWARD_EULER: /*  Backward-Euler */
+      method_name = MTHD_NAME_BACKWARD_EULER;
+      break;
+    case MTHD_CRANK_NICOLSON: /*  Crank-Nicolson (Adams-Moulton 2) */
+      method_name = MTHD_NAME_CRANK_NICOLSON;
+      break;
+    case MTHD_ADAMS_MOULTON_3: /*  Adams-Moulton 3 */
+      method_name = MTHD_NAME_ADAMS_MOULTON_3;
+      break;
+    case MTHD_ADAMS_MOULTON_4: /*  Adams-Moulton 4 */
+      method_name = MTHD_NAME_ADAMS_MOULTON_4;
+      break;
+    case MTHD_BACKWARD_DIFFERENCE_2: /*  Backward-Difference 2 */
+      method_name = MTHD_NAME_BACKWARD_DIFFERENCE_2;
+      break;
+    case MTHD_BACKWARD_DIFFERENCE_3: /*  Backward-Difference 3 */
+      method_name = MTHD_NAME_BACKWARD_DIFFERENCE_3;
+      break;
+    case MTHD_BACKWARD_DIFFERENCE_4: /*  Backward-Difference 4 */
+      method_name = MTHD_NAME_BACKWARD_DIFFERENCE_4;
+      break;
+    case MTHD_ADAPTIVE_BACKWARD_DIFFERENCE: /*  Variable-order Backward-Difference */
+      method_name = MTHD_NAME_ADAPTIVE_BACKWARD_DIFFERENCE;
+      break;
+    case MTHD_ROSENBROCK_3: /*  Rosenbrock (RODAS3) */
+      method_name = MTHD_NAME_ROSENBROCK_3;
+      break;
+    case MTHD_ROSENBROCK_4: /*  Rosenbrock (RODAS4) */
+      method_name = MTHD_NAME_ROSENBROCK_4;
+      break;
+    case MTHD_EULER: /*  Euler (Adams-Bashforth) */
+      method_name = MTHD_NAME_EULER;
+      break;
+    case MTHD_ADAMS_BASHFORTH_2: /*  Adams-Bashforth 2 */
+      method_name = MTHD_NAME_ADAMS_BASHFORTH_2;
+      break;
+    case MTHD_ADAMS_BASHFORTH_3: /*  Adams-Bashforth 3 */
+      method_name = MTHD_NAME_ADAMS_BASHFORTH_3;
+      break;
+    case MTHD_ADAMS_BASHFORTH_4: /*  Adams-Bashforth 4 */
+      method_name = MTHD_NAME_ADAMS_BASHFORTH_4;
+      break;
+    /* Variable Step Size */
+    case MTHD_RUNGE_KUTTA_FEHLBERG_5: /*  Runge-Kutta-Fehlberg */
+      method_name = MTHD_NAME_RUNGE_KUTTA_FEHLBERG_5;
+      is_variable_step = true;
+      break;
+    case MTHD_CASH_KARP: /*  Cash-Karp */
+      method_name = MTHD_NAME_CASH_KARP;
+      is_variable_step = true;
+      break;
+    case MTHD_DORMAND_PRINCE: /*  Dormand-Prince */
+      method_name = MTHD_NAME_DORMAND_PRINCE;
+      break;
+    case MTHD_AUTO_SWITCHING: /*  Dormand-Prince / Rosenbrock (RODAS4) */
+      method_name = MTHD_NAME_AUTO_SWITCHING;
+      break;
+    default:
+      method = MTHD_RUNGE_KUTTA;
+      method_name = MTHD_NAME_RUNGE_KUTTA;
+      break;
+  }
+  order = method / 10;
+  is_explicit = method % 10;
+  TRACE(("simulate with %s\n", method_name));
+
+  /* create myObjects, or restore the state of the prepared ones */
+  start = sbmlsim_wall_time();
+  if (is_variable_step || !model->is_prepared || model->is_variable_step
+      || (model->depends_on_grid && (sim_time != model->sim_time
+          || dt != model->dt || print_interval != model->print_interval))) {
+    prepare_objects(model, is_variable_step, sim_time, dt, print_interval);
+  } else {
+    copy_state(model, false);
+  }
+  apply_overrides(model);
+  prepared = sbmlsim_wall_time();
+
+  /* the ASTs created while simulating are registered to the context of
+   * the model, the random numbers are drawn from ctx */
+  prev_ctx = sbmlsim_context_attach(model->ctx);
+  ctx->model = model;
+
+  /* create myResult */
+  if (is_variable_step) {
+    result = create_myResultf(m, model->sp, model->param, model->comp, sim_time, dt);
+  } else {
+    result = create_myResult(m, model->sp, model->param, model->comp, sim_time, dt, print_interval);
+  }
+
+  has_delay = has_delay_val(model->sp, model->num_of_species, model->param,
+      model->num_of_parameters, model->comp, model->num_of_compartments,
+      model->re, model->num_of_reactions);
+
+  /* simulation */
+  if (is_variable_step) {
+    /* if (order == 5 || order == 6) { */
+    if (is_explicit) {
+      rtn = simulate_explicitf(m, result, model->sp, model->param, model->comp,
+          model->re, model->rule, model->event, model->initAssign, model->algEq,
+          model->timeVarAssign, sim_time, dt, print_interval, &model->time,
+          order, print_amount, model->mem, ctx, atol, rtol, facmax,
+          model->cp_AST, &err_zero_flag);
+    }
+  } else if (method == MTHD_ADAPTIVE_BACKWARD_DIFFERENCE) {
+    /* adaptive step size, printed on the fixed step grid */
+    if (has_delay) {
+      /* delay() needs the history on the fixed step grid */
+      TRACE(("delay is used, simulate with %s instead\n", MTHD_NAME_BACKWARD_DIFFERENCE_4));
+      rtn = simulate_implicit(m, result, model->sp, model->param, model->comp,
+          model->re, model->rule, model->event, model->initAssign, model->algEq,
+          model->timeVarAssign, sim_time, dt, print_interval, &model->time,
+          MTHD_BACKWARD_DIFFERENCE_4 / 10, use_lazy_method, print_amount,
+          model->mem, ctx);
+    } else {
+      rtn = simulate_bdf(m, result, model->sp, model->param, model->comp,
+          model->re, model->rule, model->event, model->initAssign, model->algEq,
+          model->timeVarAssign, sim_time, dt, print_interval, &model->time,
+          print_amount, model->mem, ctx, atol, rtol);
+    }
+  } else if (method == MTHD_ROSENBROCK_3 || method == MTHD_ROSENBROCK_4) {
+    /* adaptive step size, printed on the fixed step grid */
+    if (has_delay) {
+      /* delay() needs the history on the fixed step grid */
+      TRACE(("delay is used, simulate with %s instead\n", MTHD_NAME_BACKWARD_DIFFERENCE_4));
+      rtn = simulate_implicit(m, result, model->sp, model->param, model->comp,
+          model->re, model->rule, model->event, model->initAssign, model->algEq,
+          model->timeVarAssign, sim_time, dt, print_interval, &model->time,
+          MTHD_BACKWARD_DIFFERENCE_4 / 10, use_lazy_method, print_amount,
+          model->mem, ctx);
+    } else {
+      rtn = simulate_rosenbrock(m, result, model->sp, model->param, model->comp,
+          model->re, model->rule, model->event, model->initAssign, model->algEq,
+          model->timeVarAssign, sim_time, dt, print_interval, &model->time,
+          (method == MTHD_ROSENBROCK_3) ? 3 : 4, print_amount, model->mem, ctx,
+          atol, rtol, facmax);
+    }
+  } else if (method == MTHD_DORMAND_PRINCE) {
+    /* adaptive step size, printed on the fixed step grid */
+    if (has_delay) {
+      /* delay() needs the history on the fixed step grid */
+      TRACE(("delay is used, simulate with %s instead\n", MTHD_NAME_RUNGE_KUTTA));
+      rtn = simulate_explicit(m, result, model->sp, model->param, model->comp,
+          model->re, model->rule, model->event, model->initAssign, model->algEq,
+          model->timeVarAssign, sim_time, dt, print_interval, &model->time,
+          MTHD_RUNGE_KUTTA / 10, print_amount, model->mem, ctx);
+    } else {
+      rtn = simulate_dopri(m, result, model->sp, model->param, model->comp,
+          model->re, model->rule, model->event, model->initAssign, model->algEq,
+          model->timeVarAssign, sim_time, dt, print_interval, &model->time,
+          print_amount, model->mem, ctx, atol, rtol, facmax);
+    }
+  } else if (method == MTHD_AUTO_SWITCHING) {
+    /* adaptive step size, printed on the fixed step grid */
+    if (has_delay) {
+      /* delay() needs the history on the fixed step grid */
+      TRACE(("delay is used, simulate with %s instead\n", MTHD_NAME_BACKWARD_DIFFERENCE_4));
+      rtn = simulate_implicit(m, result, model->sp, model->param, model->comp,
+          model->re, model->rule, model->event, model->initAssign, model->algEq,
+          model->timeVarAssign, sim_time, dt, print_interval, &model->time,
+          MTHD_BACKWARD_DIFFERENCE_4 / 10, use_lazy_method, print_amount,
+          model->mem, ctx);
+    } else {
+      rtn = simulate_auto(m, result, model->sp, model->param, model->comp,
+          model->re, model->rule, model->event, model->initAssign, model->algEq,
+          model->timeVarAssign, sim_time, dt, print_interval, &model->time,
+          print_amount, model->mem, ctx, atol, rtol, facmax);
+    }
+  } else {  /* Fixed step size */
+    if (is_explicit) {
+      rtn = simulate_explicit(m, result, model->sp, model->param, model->comp,
+          model->re, model->rule, model->event, model->initAssign, model->algEq,
+          model->timeVarAssign, sim_time, dt, print_interval, &model->time,
+          order, print_amount, model->mem, ctx);
+    }else{
+      rtn = simulate_implicit(m, result, model->sp, model->param, model->comp,
+          model->re, model->rule, model->event, model->initAssign, model->algEq,
+          model->timeVarAssign, sim_time, dt, print_interval, &model->time,
+          order, use_lazy_method, print_amount, model->mem, ctx);
+    }
+  }
+
+  sbmlsim_context_release_rhs(ctx);
+  ctx->model = NULL;
+  sbmlsim_context_attach(prev_ctx);
+  /* the variable step methods leave the equations rewritten */
+  if (is_variable_step)
+    free_objects(model);
+
+  if (rtn == NULL) {
+    free_myResult(result);
+  } else {
+    rtn->prepare_time = prepared - start;
+    rtn->simulation_time = sbmlsim_wall_time() - prepared;
+  }
+  return rtn;
+}
+
+SBMLSIM_EXPORT void sbmlsim_model_set_num_of_threads(sbmlsim_model *model, int num_of_threads) {
+  if (model == NULL)
+    return;
+  model->num_of_threads = num_of_threads;
+}
+
+SBMLSIM_EXPORT myResult *sbmlsim_model_simulate_with_context(sbmlsim_model *model,
+    sbmlsim_context *ctx, double sim_time, double dt, int print_interval,
+    int print_amount, int method, int use_lazy_method,
+    double atol, double rtol, double facmax) {
+  myResult *rtn;
+
+  if (model == NULL)
+    return create_myResult_with_errorCode(InvalidArgument);
+  if (model->error_code != NoError)
+    return create_myResult_with_errorCode(model->error_code);
+  rtn = sbmlsim_model_run(model, ctx, sim_time, dt, print_interval,
+      print_amount, method, use_lazy_method, atol, rtol, facmax);
+  if (rtn == NULL)
+    return create_myResult_with_errorCode(SimulationFailed);
+  return rtn;
+}
+
+SBMLSIM_EXPORT myResult *sbmlsim_model_simulate(sbmlsim_model *model,
+    double sim_time, double dt, int print_interval, int print_amount,
+    int method, int use_lazy_method, double atol, double rtol, double facmax) {
+  sbmlsim_context *ctx;
+  myResult *rtn;
+
+  ctx = sbmlsim_context_create((unsigned int)my_time(NULL));
+  if (model != NULL)
+    sbmlsim_context_set_num_of_threads(ctx, model->num_of_threads);
+  rtn = sbmlsim_model_simulate_with_context(model, ctx, sim_time, dt,
+      print_interval, print_amount, method, use_lazy_method, atol, rtol, facmax);
+  sbmlsim_context_free(ctx);
+  return rtn;
+}
@@ -0,0 +1,176 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "libsbmlsim/libsbmlsim.h"
+
+struct _sbmlsim_model_cache {
+  sbmlsim_mutex *mutex;
+  sbmlsim_model **models; /* models put back, the least recently put first */
+  int num_of_models;
+  int capacity;
+  int num_of_hits;
+  int num_of_misses;
+};
+
+/* FNV-1a */
+static unsigned int hash_of(const char *str, size_t length) {
+  unsigned int hash = 2166136261U;
+  size_t i;
+
+  for (i = 0; i < length; i++) {
+    hash ^= (unsigned char)str[i];
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+SBMLSIM_EXPORT sbmlsim_model_cache *sbmlsim_model_cache_create(int capacity) {
+  sbmlsim_model_cache *cache = (sbmlsim_model_cache *)malloc(sizeof(sbmlsim_model_cache));
+
+  if (capacity < 1)
+    capacity = 1;
+  cache->mutex = sbmlsim_mutex_create();
+  cache->models = (sbmlsim_model **)malloc(sizeof(sbmlsim_model *) * capacity);
+  cache->num_of_models = 0;
+  cache->capacity = capacity;
+  cache->num_of_hits = 0;
+  cache->num_of_misses = 0;
+  return cache;
+}
+
+SBMLSIM_EXPORT void sbmlsim_model_cache_free(sbmlsim_model_cache *cache) {
+  int i;
+
+  if (cache == NULL)
+    return;
+  for (i = 0; i < cache->num_of_models; i++) {
+    sbmlsim_model_free(cache->models[i]);
+  }
+  free(cache->models);
+  sbmlsim_mutex_free(cache->mutex);
+  free(cache);
+}
+
+/* remove the model i, keeping the order of the others */
+static sbmlsim_model *remove_model(sbmlsim_model_cache *cache, int i) {
+  sbmlsim_model *model = cache->models[i];
+
+  memmove(&cache->models[i], &cache->models[i + 1],
+      sizeof(sbmlsim_model *) * (cache->num_of_models - i - 1));
+  cache->num_of_models--;
+  return model;
+}
+
+SBMLSIM_EXPORT sbmlsim_model *sbmlsim_model_cache_get_string(sbmlsim_model_cache *cache, const char *str) {
+  sbmlsim_model *model = NULL;
+  size_t length;
+  unsigned int hash;
+  int i;
+
+  if (cache == NULL || str == NULL)
+    return sbmlsim_model_create_from_string(str);
+  length = strlen(str);
+  hash = hash_of(str, length);
+  sbmlsim_mutex_lock(cache->mutex);
+  /* the most recently put first */
+  for (i = cache->num_of_models - 1; i >= 0; i--) {
+    if (cache->models[i]->source_hash == hash
+        && cache->models[i]->source_length == length
+        && memcmp(cache->models[i]->source, str, length) == 0) {
+      model = remove_model(cache, i);
+      break;
+    }
+  }
+  if (model != NULL)
+    cache->num_of_hits++;
+  else
+    cache->num_of_misses++;
+  sbmlsim_mutex_unlock(cache->mutex);
+  if (model != NULL)
+    return model;
+
+  model = sbmlsim_model_create_from_string(str);
+  if (model->error_code == NoError) {
+    model->source = (char *)malloc(length + 1);
+    memcpy(model->source, str, length + 1);
+    model->source_length = length;
+    model->source_hash = hash;
+  }
+  return model;
+}
+
+SBMLSIM_EXPORT sbmlsim_model *sbmlsim_model_cache_get_file(sbmlsim_model_cache *cache, const char *file) {
+  sbmlsim_model *model;
+  FILE *fp;
+  char *str;
+  long size;
+
+  if ((fp = fopen(file, "rb")) == NULL)
+    return sbmlsim_model_create_from_file(file);
+  /* the content is the key, whatever the name of the file */
+  fseek(fp, 0, SEEK_END);
+  size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  if (size < 0) {
+    fclose(fp);
+    return sbmlsim_model_create_from_file(file);
+  }
+  str = (char *)malloc((size_t)size + 1);
+  size = (long)fread(str, 1, (size_t)size, fp);
+  str[size] = '\0';
+  fclose(fp);
+  model = sbmlsim_model_cache_get_string(cache, str);
+  free(str);
+  return model;
+}
+
+SBMLSIM_EXPORT void sbmlsim_model_cache_put(sbmlsim_model_cache *cache, sbmlsim_model *model) {
+  sbmlsim_model *evicted = NULL;
+
+  if (model == NULL)
+    return;
+  if (cache == NULL || model->source == NULL) {
+    sbmlsim_model_free(model);
+    return;
+  }
+  sbmlsim_model_reset_values(model);
+  sbmlsim_mutex_lock(cache->mutex);
+  if (cache->num_of_models == cache->capacity)
+    evicted = remove_model(cache, 0);
+  cache->models[cache->num_of_models++] = model;
+  sbmlsim_mutex_unlock(cache->mutex);
+  /* outside of the lock, freeing a large model takes a while */
+  sbmlsim_model_free(evicted);
+}
+
+SBMLSIM_EXPORT int sbmlsim_model_cache_get_num_of_hits(sbmlsim_model_cache *cache) {
+  int n;
+
+  if (cache == NULL)
+    return 0;
+  sbmlsim_mutex_lock(cache->mutex);
+  n = cache->num_of_hits;
+  sbmlsim_mutex_unlock(cache->mutex);
+  return n;
+}
+
+SBMLSIM_EXPORT int sbmlsim_model_cache_get_num_of_misses(sbmlsim_model_cache *cache) {
+  int n;
+
+  if (cache == NULL)
+    return 0;
+  sbmlsim_mutex_lock(cache->mutex);
+  n = cache->num_of_misses;
+  sbmlsim_mutex_unlock(cache->mutex);
+  return n;
+}
@@ -0,0 +1,249 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "libsbmlsim/sbmlsim_scheduler.h"
+#include "libsbmlsim/sbmlsim_thread.h"
+#include <stdlib.h>
+
+typedef struct _task_deque {
+  sbmlsim_mutex *mutex;
+  int *tasks; /* capacity is the number of all tasks */
+  int head;
+  int tail;
+} task_deque;
+
+typedef struct _task_scheduler task_scheduler;
+
+typedef struct _task_worker {
+  task_scheduler *scheduler;
+  int index;
+  sbmlsim_worker_stats stats;
+} task_worker;
+
+struct _task_scheduler {
+  int num_of_tasks;
+  int num_of_workers;
+  task_deque *deques;
+  task_worker *workers;
+  sbmlsim_task_func func;
+  void *arg;
+  double start_time;
+};
+
+typedef struct _task_cost {
+  int task;
+  double cost;
+} task_cost;
+
+static int compare_task_cost(const void *a, const void *b) {
+  const task_cost *x = (const task_cost *)a;
+  const task_cost *y = (const task_cost *)b;
+
+  /* descending cost, then ascending index */
+  if (x->cost > y->cost)
+    return -1;
+  if (x->cost < y->cost)
+    return 1;
+  return x->task - y->task;
+}
+
+/* deal the tasks to the deques */
+static void distribute_tasks(task_scheduler *s, const double *cost_hints) {
+  task_cost *costs;
+  double *loads;
+  int i, w, least;
+
+  if (cost_hints == NULL) {
+    /* contiguous blocks, in the order of the tasks */
+    for (i = 0; i < s->num_of_tasks; i++) {
+      w = (int)((long)i * s->num_of_workers / s->num_of_tasks);
+      s->deques[w].tasks[s->deques[w].tail++] = i;
+    }
+    return;
+  }
+  costs = (task_cost *)malloc(sizeof(task_cost) * s->num_of_tasks);
+  loads = (double *)malloc(sizeof(double) * s->num_of_workers);
+  for (i = 0; i < s->num_of_tasks; i++) {
+    costs[i].task = i;
+    /* unknown (or invalid) costs are taken as 0 */
+    costs[i].cost = (cost_hints[i] > 0) ? cost_hints[i] : 0;
+  }
+  qsort(costs, s->num_of_tasks, sizeof(task_cost), compare_task_cost);
+  for (w = 0; w < s->num_of_workers; w++) {
+    loads[w] = 0;
+  }
+  for (i = 0; i < s->num_of_tasks; i++) {
+    least = 0;
+    for (w = 1; w < s->num_of_workers; w++) {
+      if (loads[w] < loads[least])
+        least = w;
+    }
+    /* tasks without cost are dealt round robin */
+    if (costs[i].cost == 0)
+      least = i % s->num_of_workers;
+    loads[least] += costs[i].cost;
+    s->deques[least].tasks[s->deques[least].tail++] = costs[i].task;
+  }
+  free(loads);
+  free(costs);
+}
+
+/* take the next task of the own deque, -1 if it is empty */
+static int pop_task(task_deque *d) {
+  int task = -1;
+
+  sbmlsim_mutex_lock(d->mutex);
+  if (d->head < d->tail) {
+    task = d->tasks[d->head++];
+  }
+  sbmlsim_mutex_unlock(d->mutex);
+  return task;
+}
+
+/* steal half (rounded up) of the remaining tasks of another worker into
+ * the own (empty) deque, returns the number of stolen tasks (0 if all
+ * deques are empty) */
+static int steal_tasks(task_scheduler *s, int self) {
+  task_deque *own = &s->deques[self];
+  task_deque *victim;
+  int i, k, n, v, best, best_n;
+
+  while (1) {
+    /* pick the worker with the most remaining tasks */
+    best = -1;
+    best_n = 0;
+    for (i = 1; i < s->num_of_workers; i++) {
+      v = (self + i) % s->num_of_workers;
+      sbmlsim_mutex_lock(s->deques[v].mutex);
+      n = s->deques[v].tail - s->deques[v].head;
+      sbmlsim_mutex_unlock(s->deques[v].mutex);
+      if (n > best_n) {
+        best = v;
+        best_n = n;
+      }
+    }
+    if (best < 0) {
+      return 0;
+    }
+    victim = &s->deques[best];
+    /* lock in the order of the index to avoid deadlock between thieves */
+    if (best < self) {
+      sbmlsim_mutex_lock(victim->mutex);
+      sbmlsim_mutex_lock(own->mutex);
+    } else {
+      sbmlsim_mutex_lock(own->mutex);
+      sbmlsim_mutex_lock(victim->mutex);
+    }
+    n = victim->tail - victim->head;
+    k = (n + 1) / 2;
+    victim->tail -= k;
+    for (i = 0; i < k; i++) {
+      own->tasks[i] = victim->tasks[victim->tail + i];
+    }
+    own->head = 0;
+    own->tail = k;
+    sbmlsim_mutex_unlock(victim->mutex);
+    sbmlsim_mutex_unlock(own->mutex);
+    if (k > 0) {
+      return k;
+    }
+    /* the tasks were taken by someone else, look again */
+  }
+}
+
+static void run_task_worker(void *data) {
+  task_worker *worker = (task_worker *)data;
+  task_scheduler *s = worker->scheduler;
+  double t;
+  int task, k;
+
+  while (1) {
+    task = pop_task(&s->deques[worker->index]);
+    if (task < 0) {
+      k = steal_tasks(s, worker->index);
+      if (k == 0) {
+        break;
+      }
+      worker->stats.num_of_steals++;
+      worker->stats.num_of_stolen_tasks += k;
+      continue;
+    }
+    t = sbmlsim_wall_time();
+    s->func(s->arg, task, worker->index);
+    worker->stats.busy_time += sbmlsim_wall_time() - t;
+    worker->stats.num_of_tasks++;
+  }
+  worker->stats.wall_time = sbmlsim_wall_time() - s->start_time;
+}
+
+int sbmlsim_run_tasks(int num_of_tasks, const double *cost_hints,
+    int num_of_workers, sbmlsim_task_func func, void *arg,
+    sbmlsim_worker_stats *stats) {
+  task_scheduler s;
+  sbmlsim_thread **threads;
+  int i, num_of_started;
+
+  if (num_of_workers < 1) {
+    num_of_workers = 1;
+  }
+  s.num_of_tasks = num_of_tasks;
+  s.num_of_workers = num_of_workers;
+  s.func = func;
+  s.arg = arg;
+  s.deques = (task_deque *)malloc(sizeof(task_deque) * num_of_workers);
+  s.workers = (task_worker *)malloc(sizeof(task_worker) * num_of_workers);
+  for (i = 0; i < num_of_workers; i++) {
+    s.deques[i].mutex = sbmlsim_mutex_create();
+    s.deques[i].tasks = (int *)malloc(sizeof(int) * (num_of_tasks > 0 ? num_of_tasks : 1));
+    s.deques[i].head = 0;
+    s.deques[i].tail = 0;
+    s.workers[i].scheduler = &s;
+    s.workers[i].index = i;
+    s.workers[i].stats.num_of_tasks = 0;
+    s.workers[i].stats.num_of_steals = 0;
+    s.workers[i].stats.num_of_stolen_tasks = 0;
+    s.workers[i].stats.busy_time = 0;
+    s.workers[i].stats.wall_time = 0;
+  }
+  if (num_of_tasks > 0) {
+    distribute_tasks(&s, cost_hints);
+  }
+
+  s.start_time = sbmlsim_wall_time();
+  threads = (sbmlsim_thread **)malloc(sizeof(sbmlsim_thread *) * num_of_workers);
+  num_of_started = 1;
+  for (i = 1; i < num_of_workers; i++) {
+    threads[i] = sbmlsim_thread_create(run_task_worker, &s.workers[i]);
+    if (threads[i] != NULL) {
+      num_of_started++;
+    }
+  }
+  run_task_worker(&s.workers[0]);
+  for (i = 1; i < num_of_workers; i++) {
+    if (threads[i] != NULL) {
+      sbmlsim_thread_join(threads[i]);
+    }
+  }
+
+  for (i = 0; i < num_of_workers; i++) {
+    if (stats != NULL) {
+      stats[i] = s.workers[i].stats;
+    }
+    sbmlsim_mutex_free(s.deques[i].mutex);
+    free(s.deques[i].tasks);
+  }
+  free(threads);
+  free(s.workers);
+  free(s.deques);
+  return num_of_started;
+}
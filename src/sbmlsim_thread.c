@@ -0,0 +1,332 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "libsbmlsim/sbmlsim_thread.h"
+#include <stdlib.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+#endif
+
+struct _sbmlsim_thread {
+#ifdef _WIN32
+  HANDLE handle;
+#else
+  pthread_t handle;
+#endif
+  sbmlsim_thread_func func;
+  void *arg;
+};
+
+struct _sbmlsim_mutex {
+#ifdef _WIN32
+  CRITICAL_SECTION cs;
+#else
+  pthread_mutex_t mutex;
+#endif
+};
+
+typedef struct {
+  sbmlsim_team *team;
+  int member;
+} sbmlsim_team_member;
+
+struct _sbmlsim_team {
+#ifdef _WIN32
+  CRITICAL_SECTION cs;
+  CONDITION_VARIABLE start;
+  CONDITION_VARIABLE done;
+#else
+  pthread_mutex_t mutex;
+  pthread_cond_t start;
+  pthread_cond_t done;
+#endif
+  int num_of_members;
+  sbmlsim_thread **threads;
+  sbmlsim_team_member *members;
+  /* the parallel region, numbered by generation */
+  sbmlsim_team_func func;
+  void *arg;
+  unsigned long generation;
+  int num_of_running;
+  int quit;
+};
+
+#ifdef _WIN32
+static DWORD WINAPI sbmlsim_thread_start(LPVOID data) {
+  sbmlsim_thread *thread = (sbmlsim_thread *)data;
+  thread->func(thread->arg);
+  return 0;
+}
+#else
+static void *sbmlsim_thread_start(void *data) {
+  sbmlsim_thread *thread = (sbmlsim_thread *)data;
+  thread->func(thread->arg);
+  return NULL;
+}
+#endif
+
+sbmlsim_thread *sbmlsim_thread_create(sbmlsim_thread_func func, void *arg) {
+  sbmlsim_thread *thread = (sbmlsim_thread *)malloc(sizeof(sbmlsim_thread));
+  if (thread == NULL) {
+    return NULL;
+  }
+  thread->func = func;
+  thread->arg = arg;
+#ifdef _WIN32
+  thread->handle = CreateThread(NULL, 0, sbmlsim_thread_start, thread, 0, NULL);
+  if (thread->handle == NULL) {
+    free(thread);
+    return NULL;
+  }
+#else
+  if (pthread_create(&thread->handle, NULL, sbmlsim_thread_start, thread) != 0) {
+    free(thread);
+    return NULL;
+  }
+#endif
+  return thread;
+}
+
+void sbmlsim_thread_join(sbmlsim_thread *thread) {
+  if (thread == NULL) {
+    return;
+  }
+#ifdef _WIN32
+  WaitForSingleObject(thread->handle, INFINITE);
+  CloseHandle(thread->handle);
+#else
+  pthread_join(thread->handle, NULL);
+#endif
+  free(thread);
+}
+
+sbmlsim_mutex *sbmlsim_mutex_create(void) {
+  sbmlsim_mutex *mutex = (sbmlsim_mutex *)malloc(sizeof(sbmlsim_mutex));
+#ifdef _WIN32
+  InitializeCriticalSection(&mutex->cs);
+#else
+  pthread_mutex_init(&mutex->mutex, NULL);
+#endif
+  return mutex;
+}
+
+void sbmlsim_mutex_free(sbmlsim_mutex *mutex) {
+  if (mutex == NULL) {
+    return;
+  }
+#ifdef _WIN32
+  DeleteCriticalSection(&mutex->cs);
+#else
+  pthread_mutex_destroy(&mutex->mutex);
+#endif
+  free(mutex);
+}
+
+void sbmlsim_mutex_lock(sbmlsim_mutex *mutex) {
+#ifdef _WIN32
+  EnterCriticalSection(&mutex->cs);
+#else
+  pthread_mutex_lock(&mutex->mutex);
+#endif
+}
+
+void sbmlsim_mutex_unlock(sbmlsim_mutex *mutex) {
+#ifdef _WIN32
+  LeaveCriticalSection(&mutex->cs);
+#else
+  pthread_mutex_unlock(&mutex->mutex);
+#endif
+}
+
+#ifdef _WIN32
+#define TEAM_LOCK(team) EnterCriticalSection(&(team)->cs)
+#define TEAM_UNLOCK(team) LeaveCriticalSection(&(team)->cs)
+#define TEAM_WAIT(team, cond) SleepConditionVariableCS(&(team)->cond, &(team)->cs, INFINITE)
+#define TEAM_SIGNAL(team, cond) WakeConditionVariable(&(team)->cond)
+#define TEAM_BROADCAST(team, cond) WakeAllConditionVariable(&(team)->cond)
+#else
+#define TEAM_LOCK(team) pthread_mutex_lock(&(team)->mutex)
+#define TEAM_UNLOCK(team) pthread_mutex_unlock(&(team)->mutex)
+#define TEAM_WAIT(team, cond) pthread_cond_wait(&(team)->cond, &(team)->mutex)
+#define TEAM_SIGNAL(team, cond) pthread_cond_signal(&(team)->cond)
+#define TEAM_BROADCAST(team, cond) pthread_cond_broadcast(&(team)->cond)
+#endif
+
+static void sbmlsim_team_loop(void *arg) {
+  sbmlsim_team_member *self = (sbmlsim_team_member *)arg;
+  sbmlsim_team *team = self->team;
+  unsigned long generation;
+  sbmlsim_team_func func;
+  void *func_arg;
+
+  /* the generation when the team was created, a member may start
+   * after the first parallel region is posted */
+  generation = 0;
+  TEAM_LOCK(team);
+  for (;;) {
+    while (team->generation == generation && !team->quit) {
+      TEAM_WAIT(team, start);
+    }
+    if (team->quit) {
+      break;
+    }
+    generation = team->generation;
+    func = team->func;
+    func_arg = team->arg;
+    TEAM_UNLOCK(team);
+    func(func_arg, self->member, team->num_of_members);
+    TEAM_LOCK(team);
+    if (--team->num_of_running == 0) {
+      TEAM_SIGNAL(team, done);
+    }
+  }
+  TEAM_UNLOCK(team);
+}
+
+sbmlsim_team *sbmlsim_team_create(int num_of_members) {
+  sbmlsim_team *team;
+  int i;
+
+  if (num_of_members < 1) {
+    num_of_members = 1;
+  }
+  team = (sbmlsim_team *)malloc(sizeof(sbmlsim_team));
+  if (team == NULL) {
+    return NULL;
+  }
+#ifdef _WIN32
+  InitializeCriticalSection(&team->cs);
+  InitializeConditionVariable(&team->start);
+  InitializeConditionVariable(&team->done);
+#else
+  pthread_mutex_init(&team->mutex, NULL);
+  pthread_cond_init(&team->start, NULL);
+  pthread_cond_init(&team->done, NULL);
+#endif
+  team->threads = (sbmlsim_thread **)malloc(sizeof(sbmlsim_thread *) * num_of_members);
+  team->members = (sbmlsim_team_member *)malloc(sizeof(sbmlsim_team_member) * num_of_members);
+  team->func = NULL;
+  team->arg = NULL;
+  team->generation = 0;
+  team->num_of_running = 0;
+  team->quit = 0;
+  /* members do not read the size before the first parallel region */
+  team->num_of_members = 1;
+  TEAM_LOCK(team);
+  for (i = 1; i < num_of_members; i++) {
+    team->members[i].team = team;
+    team->members[i].member = i;
+    team->threads[i] = sbmlsim_thread_create(sbmlsim_team_loop, &team->members[i]);
+    if (team->threads[i] == NULL) {
+      break;
+    }
+    team->num_of_members++;
+  }
+  TEAM_UNLOCK(team);
+  return team;
+}
+
+void sbmlsim_team_free(sbmlsim_team *team) {
+  int i;
+
+  if (team == NULL) {
+    return;
+  }
+  TEAM_LOCK(team);
+  team->quit = 1;
+  TEAM_BROADCAST(team, start);
+  TEAM_UNLOCK(team);
+  for (i = 1; i < team->num_of_members; i++) {
+    sbmlsim_thread_join(team->threads[i]);
+  }
+#ifdef _WIN32
+  DeleteCriticalSection(&team->cs);
+#else
+  pthread_cond_destroy(&team->done);
+  pthread_cond_destroy(&team->start);
+  pthread_mutex_destroy(&team->mutex);
+#endif
+  free(team->threads);
+  free(team->members);
+  free(team);
+}
+
+int sbmlsim_team_size(sbmlsim_team *team) {
+  return (team != NULL) ? team->num_of_members : 1;
+}
+
+void sbmlsim_team_run(sbmlsim_team *team, sbmlsim_team_func func, void *arg) {
+  if (team == NULL || team->num_of_members == 1) {
+    func(arg, 0, 1);
+    return;
+  }
+  TEAM_LOCK(team);
+  team->func = func;
+  team->arg = arg;
+  team->num_of_running = team->num_of_members - 1;
+  team->generation++;
+  TEAM_BROADCAST(team, start);
+  TEAM_UNLOCK(team);
+  func(arg, 0, team->num_of_members);
+  TEAM_LOCK(team);
+  while (team->num_of_running > 0) {
+    TEAM_WAIT(team, done);
+  }
+  TEAM_UNLOCK(team);
+}
+
+int sbmlsim_num_of_processors(void) {
+  long n;
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  n = (long)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+  n = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+  n = 1;
+#endif
+  return (n > 0) ? (int)n : 1;
+}
+
+int sbmlsim_num_of_workers(int num_of_threads, int num_of_tasks) {
+  int n = (num_of_threads > 0) ? num_of_threads : sbmlsim_num_of_processors();
+  if (n > num_of_tasks) {
+    n = num_of_tasks;
+  }
+  return (n > 0) ? n : 1;
+}
+
+double sbmlsim_wall_time(void) {
+#ifdef _WIN32
+  LARGE_INTEGER count, frequency;
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&frequency);
+  return (double)count.QuadPart / (double)frequency.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#else
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (double)tv.tv_sec + (double)tv.tv_usec * 1e-6;
+#endif
+}
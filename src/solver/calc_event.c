@@ -13,7 +13,7 @@
  * ---------------------------------------------------------------------- -->*/
 #include "../libsbmlsim/libsbmlsim.h"
 
-void recursive_calc_event(myEvent *event[], unsigned int num_of_events, myEvent *event_buf[], unsigned int *num_of_remained_events, double *assignment_values_from_trigger_time[], double dt, double time, int cycle, double *reverse_time){
+void recursive_calc_event(myEvent *event[], unsigned int num_of_events, myEvent *event_buf[], unsigned int *num_of_remained_events, double *assignment_values_from_trigger_time[], double dt, double time, int cycle, double *reverse_time, sbmlsim_context *ctx){
   unsigned int i, j, k;
   int is_condition_satisfied;
   int flag;
@@ -112,7 +112,7 @@ void recursive_calc_event(myEvent *event[], unsigned int num_of_events, myEvent
     }
   }
   /* rondom order determination for same priority events */
-  selected_order = rand()%num_of_same_priority_events;
+  selected_order = sbmlsim_context_random_index(ctx, num_of_same_priority_events);
   /* swap event_buf */
   temp_event = event_buf[0];
   event_buf[0] = event_buf[selected_order];
@@ -123,7 +123,7 @@ void recursive_calc_event(myEvent *event[], unsigned int num_of_events, myEvent
   assignment_values_from_trigger_time[selected_order] = temp_assignment_values_from_trigger_time;
 }
 
-void recursive_calc_eventf(myEvent *event[], unsigned int num_of_events, myEvent *event_buf[], unsigned int *num_of_remained_events, double *assignment_values_from_trigger_time[], double dt, double time, int cycle, double *reverse_time, myResult* res, int print_interval, int* err_zero_flag){
+void recursive_calc_eventf(myEvent *event[], unsigned int num_of_events, myEvent *event_buf[], unsigned int *num_of_remained_events, double *assignment_values_from_trigger_time[], double dt, double time, int cycle, double *reverse_time, myResult* res, int print_interval, int* err_zero_flag, sbmlsim_context *ctx){
   unsigned int i, j, k;
   int is_condition_satisfied;
   int flag;
@@ -225,7 +225,7 @@ void recursive_calc_eventf(myEvent *event[], unsigned int num_of_events, myEvent
     }
   }
   /* rondom order determination for same priority events */
-  selected_order = rand()%num_of_same_priority_events;
+  selected_order = sbmlsim_context_random_index(ctx, num_of_same_priority_events);
   /* swap event_buf */
   temp_event = event_buf[0];
   event_buf[0] = event_buf[selected_order];
@@ -237,22 +237,15 @@ void recursive_calc_eventf(myEvent *event[], unsigned int num_of_events, myEvent
 }
 
 
-void calc_event(myEvent *event[], unsigned int num_of_events, double dt, double time, int cycle, double *reverse_time){
+void calc_event(myEvent *event[], unsigned int num_of_events, double dt, double time, int cycle, double *reverse_time, sbmlsim_context *ctx){
   unsigned int i, j;
   myEvent *event_buf[MAX_IDENTICAL_EVENTS];
-  static double sub_assignment_values_from_trigger_time[MAX_IDENTICAL_EVENTS][MAX_EVENTASSIGNMENTS];
-  static double *assignment_values_from_trigger_time[MAX_IDENTICAL_EVENTS];
+  double **assignment_values_from_trigger_time = sbmlsim_context_event_buffer(ctx);
   unsigned int num_of_remained_events = 0;
   myEventAssignment* assignment;
 
-  if(cycle == 0){
-    for(i=0; i<MAX_IDENTICAL_EVENTS; i++){
-      assignment_values_from_trigger_time[i] = sub_assignment_values_from_trigger_time[i];
-    }
-  }
-
   /* recursive processing */
-  recursive_calc_event(event, num_of_events, event_buf, &num_of_remained_events, assignment_values_from_trigger_time, dt, time, cycle, reverse_time);
+  recursive_calc_event(event, num_of_events, event_buf, &num_of_remained_events, assignment_values_from_trigger_time, dt, time, cycle, reverse_time, ctx);
 
   /* proccess assignment start */
   while(num_of_remained_events != 0){
@@ -324,26 +317,20 @@ void calc_event(myEvent *event[], unsigned int num_of_events, double dt, double
     /*       } */
     /*     } */
     /* recursive processing */
-    recursive_calc_event(event, num_of_events, event_buf, &num_of_remained_events, assignment_values_from_trigger_time, dt, time, cycle, reverse_time);
+    recursive_calc_event(event, num_of_events, event_buf, &num_of_remained_events, assignment_values_from_trigger_time, dt, time, cycle, reverse_time, ctx);
   }/* proccess assignment finish */
 
 }
 
-void calc_eventf(myEvent *event[], unsigned int num_of_events, double dt, double time, int cycle, double *reverse_time, myResult* res, int print_interval, int* err_zero_flag){
+void calc_eventf(myEvent *event[], unsigned int num_of_events, double dt, double time, int cycle, double *reverse_time, myResult* res, int print_interval, int* err_zero_flag, sbmlsim_context *ctx){
   unsigned int i, j;
   myEvent *event_buf[MAX_IDENTICAL_EVENTS];
-  static double sub_assignment_values_from_trigger_time[MAX_IDENTICAL_EVENTS][MAX_EVENTASSIGNMENTS];
-  static double *assignment_values_from_trigger_time[MAX_IDENTICAL_EVENTS];
+  double **assignment_values_from_trigger_time = sbmlsim_context_event_buffer(ctx);
   unsigned int num_of_remained_events = 0;
   myEventAssignment* assignment;
-  if(cycle == 0){
-    for(i=0; i<MAX_IDENTICAL_EVENTS; i++){
-      assignment_values_from_trigger_time[i] = sub_assignment_values_from_trigger_time[i];
-    }
-  }
 
   /* recursive processing */
-  recursive_calc_eventf(event, num_of_events, event_buf, &num_of_remained_events, assignment_values_from_trigger_time, dt, time, cycle, reverse_time, res, print_interval, err_zero_flag);
+  recursive_calc_eventf(event, num_of_events, event_buf, &num_of_remained_events, assignment_values_from_trigger_time, dt, time, cycle, reverse_time, res, print_interval, err_zero_flag, ctx);
 
 
 
@@ -417,6 +404,6 @@ void calc_eventf(myEvent *event[], unsigned int num_of_events, double dt, double
     /*       } */
     /*     } */
     /* recursive processing */
-    recursive_calc_eventf(event, num_of_events, event_buf, &num_of_remained_events, assignment_values_from_trigger_time, dt, time, cycle, reverse_time, res, print_interval, err_zero_flag);
+    recursive_calc_eventf(event, num_of_events, event_buf, &num_of_remained_events, assignment_values_from_trigger_time, dt, time, cycle, reverse_time, res, print_interval, err_zero_flag, ctx);
   }/* proccess assignment finish */
 }
@@ -13,12 +13,13 @@
  * ---------------------------------------------------------------------- -->*/
 #include "../libsbmlsim/libsbmlsim.h"
 
-void calc_k(mySpecies *sp[], unsigned int sp_num, myParameter *param[], unsigned int param_num, myCompartment *comp[], unsigned int comp_num, mySpeciesReference *spr[], unsigned int spr_num, myReaction *re[], unsigned int re_num, myRule *rule[], unsigned int rule_num, int cycle, double dt, double *reverse_time, int use_rk, int call_first_time_in_cycle){
+void calc_k(mySpecies *sp[], unsigned int sp_num, myParameter *param[], unsigned int param_num, myCompartment *comp[], unsigned int comp_num, mySpeciesReference *spr[], unsigned int spr_num, myReaction *re[], unsigned int re_num, myRule *rule[], unsigned int rule_num, int cycle, double dt, double *reverse_time, int use_rk, int call_first_time_in_cycle, sbmlsim_context *ctx){
   unsigned int i, j;
   double k = 0;
   double rk_cef[4] = {0.5, 0.5, 1, 0};
   int step;
   int step_num;
+  parallel_rhs *rhs = sbmlsim_context_parallel_rhs(ctx, sp, sp_num, param, param_num, comp, comp_num, re, re_num);
 
   if(use_rk){
     step_num = 4;
@@ -64,17 +65,21 @@ void calc_k(mySpecies *sp[], unsigned int sp_num, myParameter *param[], unsigned
       spr[i]->k[step] = 0;
     }
     /* reaction */
-    for(i=0; i<re_num; i++){
-      if(!re[i]->is_fast){
-        k = calc(re[i]->eq, dt, cycle, reverse_time, step);
-        for(j=0; j<re[i]->num_of_products; j++){
-          if(!Species_getBoundaryCondition(re[i]->products[j]->mySp->origin)){
-            re[i]->products[j]->mySp->k[step] += calc(re[i]->products[j]->eq, dt, cycle, reverse_time, step)*k; 
+    if(rhs != NULL){
+      parallel_rhs_calc_reactions(rhs, dt, cycle, reverse_time, step);
+    }else{
+      for(i=0; i<re_num; i++){
+        if(!re[i]->is_fast){
+          k = calc(re[i]->eq, dt, cycle, reverse_time, step);
+          for(j=0; j<re[i]->num_of_products; j++){
+            if(!Species_getBoundaryCondition(re[i]->products[j]->mySp->origin)){
+              re[i]->products[j]->mySp->k[step] += calc(re[i]->products[j]->eq, dt, cycle, reverse_time, step)*k; 
+            }
           }
-        }
-        for(j=0; j<re[i]->num_of_reactants; j++){
-          if(!Species_getBoundaryCondition(re[i]->reactants[j]->mySp->origin)){
-            re[i]->reactants[j]->mySp->k[step] -= calc(re[i]->reactants[j]->eq, dt, cycle, reverse_time, step)*k; 
+          for(j=0; j<re[i]->num_of_reactants; j++){
+            if(!Species_getBoundaryCondition(re[i]->reactants[j]->mySp->origin)){
+              re[i]->reactants[j]->mySp->k[step] -= calc(re[i]->reactants[j]->eq, dt, cycle, reverse_time, step)*k; 
+            }
           }
         }
       }
@@ -0,0 +1,695 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "../libsbmlsim/libsbmlsim.h"
+
+/* relative tolerance of event time */
+#define ODE_EVENT_RTOL 1.0e-12
+
+boolean has_delay_val(mySpecies *sp[], unsigned int num_of_species, myParameter *param[], unsigned int num_of_parameters, myCompartment *comp[], unsigned int num_of_compartments, myReaction *re[], unsigned int num_of_reactions){
+  unsigned int i, j;
+  for(i=0; i<num_of_species; i++){
+    if(sp[i]->delay_val != NULL){
+      return true;
+    }
+  }
+  for(i=0; i<num_of_parameters; i++){
+    if(param[i]->delay_val != NULL){
+      return true;
+    }
+  }
+  for(i=0; i<num_of_compartments; i++){
+    if(comp[i]->delay_val != NULL){
+      return true;
+    }
+  }
+  for(i=0; i<num_of_reactions; i++){
+    for(j=0; j<re[i]->num_of_products; j++){
+      if(re[i]->products[j]->delay_val != NULL){
+        return true;
+      }
+    }
+    for(j=0; j<re[i]->num_of_reactants; j++){
+      if(re[i]->reactants[j]->delay_val != NULL){
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+ode_system *ode_system_create(Model_t *m, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myAlgebraicEquations *algEq, double *time, double dt, sbmlsim_context *ctx){
+  unsigned int i;
+  unsigned int num_of_all_vars;
+  ode_system *sys = (ode_system *)malloc(sizeof(ode_system));
+
+  sys->m = m;
+  sys->sp = sp;
+  sys->param = param;
+  sys->comp = comp;
+  sys->re = re;
+  sys->rule = rule;
+  sys->event = event;
+  sys->algEq = algEq;
+  sys->ctx = ctx;
+  sys->num_of_species = Model_getNumSpecies(m);
+  sys->num_of_parameters = Model_getNumParameters(m);
+  sys->num_of_compartments = Model_getNumCompartments(m);
+  sys->num_of_reactions = Model_getNumReactions(m);
+  sys->num_of_rules = Model_getNumRules(m);
+  sys->num_of_events = Model_getNumEvents(m);
+  sys->num_of_all_var_species = 0;
+  sys->num_of_all_var_parameters = 0;
+  sys->num_of_all_var_compartments = 0;
+  sys->num_of_all_var_species_reference = 0;
+  sys->num_of_var_species = 0;
+  sys->num_of_var_parameters = 0;
+  sys->num_of_var_compartments = 0;
+  sys->num_of_var_species_reference = 0;
+
+  check_num(sys->num_of_species, sys->num_of_parameters, sys->num_of_compartments, sys->num_of_reactions, &sys->num_of_all_var_species, &sys->num_of_all_var_parameters, &sys->num_of_all_var_compartments, &sys->num_of_all_var_species_reference, &sys->num_of_var_species, &sys->num_of_var_parameters, &sys->num_of_var_compartments, &sys->num_of_var_species_reference, sp, param, comp, re);
+
+  sys->all_var_sp = (mySpecies **)malloc(sizeof(mySpecies *) * sys->num_of_all_var_species);
+  sys->all_var_param = (myParameter **)malloc(sizeof(myParameter *) * sys->num_of_all_var_parameters);
+  sys->all_var_comp = (myCompartment **)malloc(sizeof(myCompartment *) * sys->num_of_all_var_compartments);
+  sys->all_var_spr = (mySpeciesReference **)malloc(sizeof(mySpeciesReference *) * sys->num_of_all_var_species_reference);
+  sys->var_sp = (mySpecies **)malloc(sizeof(mySpecies *) * sys->num_of_var_species);
+  sys->var_param = (myParameter **)malloc(sizeof(myParameter *) * sys->num_of_var_parameters);
+  sys->var_comp = (myCompartment **)malloc(sizeof(myCompartment *) * sys->num_of_var_compartments);
+  sys->var_spr = (mySpeciesReference **)malloc(sizeof(mySpeciesReference *) * sys->num_of_var_species_reference);
+
+  create_calc_object_list(sys->num_of_species, sys->num_of_parameters, sys->num_of_compartments, sys->num_of_reactions, sys->all_var_sp, sys->all_var_param, sys->all_var_comp, sys->all_var_spr, sys->var_sp, sys->var_param, sys->var_comp, sys->var_spr, sp, param, comp, re);
+
+  sys->num_of_vars = sys->num_of_var_species + sys->num_of_var_parameters +
+                     sys->num_of_var_compartments + sys->num_of_var_species_reference;
+
+  /* concentration species in a compartment whose size changes are
+   * integrated as amount, as the other solvers rescale them by V_old/V_new */
+  sys->is_scaled_species = (boolean *)malloc(sizeof(boolean) * sys->num_of_var_species);
+  for(i=0; i<sys->num_of_var_species; i++){
+    sys->is_scaled_species[i] = false;
+    if(sys->var_sp[i]->is_concentration && sys->var_sp[i]->locating_compartment != NULL
+        && !Compartment_getConstant(sys->var_sp[i]->locating_compartment->origin)){
+      sys->is_scaled_species[i] = true;
+    }
+  }
+
+  sys->time = time;
+  sys->reverse_time = 0;
+  sys->dt = dt;
+  sys->cycle = 0;
+
+  sys->coefficient_matrix = NULL;
+  sys->constant_vector = NULL;
+  sys->alg_pivot = NULL;
+  if(algEq != NULL){
+    sys->coefficient_matrix = (double**)malloc(sizeof(double*)*(algEq->num_of_algebraic_variables));
+    for(i=0; i<algEq->num_of_algebraic_variables; i++){
+      sys->coefficient_matrix[i] = (double*)malloc(sizeof(double)*(algEq->num_of_algebraic_variables));
+    }
+    sys->constant_vector = (double*)malloc(sizeof(double)*(algEq->num_of_algebraic_variables));
+    sys->alg_pivot = (int*)malloc(sizeof(int)*(algEq->num_of_algebraic_variables));
+  }
+
+  num_of_all_vars = sys->num_of_all_var_species + sys->num_of_all_var_parameters +
+                    sys->num_of_all_var_compartments + sys->num_of_all_var_species_reference;
+  sys->work_y = (double *)malloc(sizeof(double) * sys->num_of_vars);
+  sys->work_f = (double *)malloc(sizeof(double) * sys->num_of_vars);
+  sys->snapshot = (double *)malloc(sizeof(double) * num_of_all_vars);
+  sys->trigger_values = (boolean *)malloc(sizeof(boolean) * sys->num_of_events);
+  for(i=0; i<sys->num_of_events; i++){
+    sys->trigger_values[i] = false;
+  }
+
+  sys->num_of_steps = 0;
+  sys->num_of_rejected_steps = 0;
+  sys->num_of_rhs_evaluations = 0;
+  sys->num_of_jacobian_evaluations = 0;
+  sys->num_of_lu_decompositions = 0;
+  sys->num_of_stiff_steps = 0;
+  sys->num_of_method_switches = 0;
+  return sys;
+}
+
+void ode_system_free(ode_system *sys){
+  unsigned int i;
+  if(sys == NULL){
+    return;
+  }
+  if(sys->algEq != NULL){
+    for(i=0; i<sys->algEq->num_of_algebraic_variables; i++){
+      free(sys->coefficient_matrix[i]);
+    }
+    free(sys->coefficient_matrix);
+    free(sys->constant_vector);
+    free(sys->alg_pivot);
+  }
+  free(sys->all_var_sp);
+  free(sys->all_var_param);
+  free(sys->all_var_comp);
+  free(sys->all_var_spr);
+  free(sys->var_sp);
+  free(sys->var_param);
+  free(sys->var_comp);
+  free(sys->var_spr);
+  free(sys->is_scaled_species);
+  free(sys->work_y);
+  free(sys->work_f);
+  free(sys->snapshot);
+  free(sys->trigger_values);
+  free(sys);
+}
+
+/* calc temp value by assignment (only compartments if comp_only) */
+static void ode_system_calc_assignment(ode_system *sys, int comp_only){
+  unsigned int i;
+  for(i=0; i<sys->num_of_all_var_compartments; i++){
+    if(sys->all_var_comp[i]->depending_rule != NULL && sys->all_var_comp[i]->depending_rule->is_assignment){
+      sys->all_var_comp[i]->temp_value = calc(sys->all_var_comp[i]->depending_rule->eq, sys->dt, sys->cycle, &sys->reverse_time, 0);
+    }
+  }
+  if(comp_only){
+    return;
+  }
+  for(i=0; i<sys->num_of_all_var_species; i++){
+    if(sys->all_var_sp[i]->depending_rule != NULL && sys->all_var_sp[i]->depending_rule->is_assignment){
+      sys->all_var_sp[i]->temp_value = calc(sys->all_var_sp[i]->depending_rule->eq, sys->dt, sys->cycle, &sys->reverse_time, 0);
+    }
+  }
+  for(i=0; i<sys->num_of_all_var_parameters; i++){
+    if(sys->all_var_param[i]->depending_rule != NULL && sys->all_var_param[i]->depending_rule->is_assignment){
+      sys->all_var_param[i]->temp_value = calc(sys->all_var_param[i]->depending_rule->eq, sys->dt, sys->cycle, &sys->reverse_time, 0);
+    }
+  }
+  for(i=0; i<sys->num_of_all_var_species_reference; i++){
+    if(sys->all_var_spr[i]->depending_rule != NULL && sys->all_var_spr[i]->depending_rule->is_assignment){
+      sys->all_var_spr[i]->temp_value = calc(sys->all_var_spr[i]->depending_rule->eq, sys->dt, sys->cycle, &sys->reverse_time, 0);
+    }
+  }
+}
+
+/* calc temp value algebraic by algebraic (returns 0 on failure) */
+static int ode_system_calc_algebraic(ode_system *sys){
+  unsigned int i, j;
+  int error;
+  myAlgebraicEquations *algEq = sys->algEq;
+  double *constant_vector = sys->constant_vector;
+  double value;
+
+  if(algEq == NULL){
+    return 1;
+  }
+  if(algEq->num_of_algebraic_variables > 1){
+    /* initialize pivot */
+    for(i=0; i<algEq->num_of_algebraic_variables; i++){
+      sys->alg_pivot[i] = i;
+    }
+    for(i=0; i<algEq->num_of_algebraic_variables; i++){
+      for(j=0; j<algEq->num_of_algebraic_variables; j++){
+        sys->coefficient_matrix[i][j] = calc(algEq->coefficient_matrix[i][j], sys->dt, sys->cycle, &sys->reverse_time, 0);
+      }
+    }
+    for(i=0; i<algEq->num_of_algebraic_variables; i++){
+      constant_vector[i] = -calc(algEq->constant_vector[i], sys->dt, sys->cycle, &sys->reverse_time, 0);
+    }
+    /* LU decompostion */
+    error = lu_decomposition(sys->coefficient_matrix, sys->alg_pivot, algEq->num_of_algebraic_variables);
+    if(error == 0){/* failure in LU decomposition */
+      return 0;
+    }
+    /* forward substitution & backward substitution */
+    lu_solve(sys->coefficient_matrix, sys->alg_pivot, algEq->num_of_algebraic_variables, constant_vector);
+    for(i=0; i<algEq->num_of_alg_target_sp; i++){
+      algEq->alg_target_species[i]->target_species->temp_value = constant_vector[algEq->alg_target_species[i]->order];
+    }
+    for(i=0; i<algEq->num_of_alg_target_param; i++){
+      algEq->alg_target_parameter[i]->target_parameter->temp_value = constant_vector[algEq->alg_target_parameter[i]->order];
+    }
+    for(i=0; i<algEq->num_of_alg_target_comp; i++){
+      for(j=0; j<algEq->alg_target_compartment[i]->target_compartment->num_of_including_species; j++){
+        if(algEq->alg_target_compartment[i]->target_compartment->including_species[j]->is_concentration){
+          algEq->alg_target_compartment[i]->target_compartment->including_species[j]->temp_value = algEq->alg_target_compartment[i]->target_compartment->including_species[j]->temp_value*algEq->alg_target_compartment[i]->target_compartment->temp_value/constant_vector[algEq->alg_target_compartment[i]->order];
+        }
+      }
+      algEq->alg_target_compartment[i]->target_compartment->temp_value = constant_vector[algEq->alg_target_compartment[i]->order];
+    }
+  }else{
+    value = -calc(algEq->constant, sys->dt, sys->cycle, &sys->reverse_time, 0)/calc(algEq->coefficient, sys->dt, sys->cycle, &sys->reverse_time, 0);
+    if(algEq->target_species != NULL){
+      algEq->target_species->temp_value = value;
+    }
+    if(algEq->target_parameter != NULL){
+      algEq->target_parameter->temp_value = value;
+    }
+    if(algEq->target_compartment != NULL){
+      for(i=0; i<algEq->target_compartment->num_of_including_species; i++){
+        if(algEq->target_compartment->including_species[i]->is_concentration){
+          algEq->target_compartment->including_species[i]->temp_value = algEq->target_compartment->including_species[i]->temp_value*algEq->target_compartment->temp_value/value;
+        }
+      }
+      algEq->target_compartment->temp_value = value;
+    }
+  }
+  return 1;
+}
+
+static void ode_system_forwarding_value(ode_system *sys){
+  forwarding_value(sys->all_var_sp, sys->num_of_all_var_species, sys->all_var_param, sys->num_of_all_var_parameters, sys->all_var_comp, sys->num_of_all_var_compartments, sys->all_var_spr, sys->num_of_all_var_species_reference);
+}
+
+int ode_system_initialize(ode_system *sys, myInitialAssignment *initAssign[], timeVariantAssignments *timeVarAssign, double sim_time, allocated_memory *mem){
+  unsigned int i, j;
+  unsigned int num_of_initialAssignments = Model_getNumInitialAssignments(sys->m);
+  double *init_val;
+
+  sys->cycle = 0;
+  *sys->time = 0;
+
+  /* initialize delay_val */
+  initialize_delay_val(sys->sp, sys->num_of_species, sys->param, sys->num_of_parameters, sys->comp, sys->num_of_compartments, sys->re, sys->num_of_reactions, sim_time, sys->dt, 0);
+
+  /* calc temp value by assignment */
+  ode_system_calc_assignment(sys, 0);
+  /* forwarding value */
+  ode_system_forwarding_value(sys);
+
+  /* calc InitialAssignment */
+  calc_initial_assignment(initAssign, num_of_initialAssignments, sys->dt, sys->cycle, &sys->reverse_time);
+
+  /* rewriting for explicit delay */
+  for(i=0; i<num_of_initialAssignments; i++){
+    for(j=0; j<initAssign[i]->eq->math_length; j++){
+      if(initAssign[i]->eq->number[j] == sys->time){
+        TRACE(("time is replaced with reverse time\n"));
+        initAssign[i]->eq->number[j] = &sys->reverse_time;
+      }else if(initAssign[i]->eq->number[j] != NULL){
+        init_val = (double*)malloc(sizeof(double));
+        *init_val = *initAssign[i]->eq->number[j];
+        mem->memory[mem->num_of_allocated_memory++] = init_val;
+        initAssign[i]->eq->number[j] = init_val;
+      }
+    }
+  }
+  for(i=0; i<timeVarAssign->num_of_time_variant_assignments; i++){
+    for(j=0; j<timeVarAssign->eq[i]->math_length; j++){
+      if(timeVarAssign->eq[i]->number[j] == sys->time){
+        TRACE(("time is replaced with reverse time\n"));
+        timeVarAssign->eq[i]->number[j] = &sys->reverse_time;
+      }else if(timeVarAssign->eq[i]->number[j] != NULL){
+        init_val = (double*)malloc(sizeof(double));
+        *init_val = *timeVarAssign->eq[i]->number[j];
+        mem->memory[mem->num_of_allocated_memory++] = init_val;
+        timeVarAssign->eq[i]->number[j] = init_val;
+      }
+    }
+  }
+
+  /* calc temp value by assignment */
+  ode_system_calc_assignment(sys, 0);
+  /* forwarding value */
+  ode_system_forwarding_value(sys);
+
+  /* calc temp value algebraic by algebraic */
+  if(sys->algEq != NULL){
+    if(!ode_system_calc_algebraic(sys)){
+      return 0;
+    }
+    /* forwarding value */
+    ode_system_forwarding_value(sys);
+  }
+
+  /* initialize delay_val */
+  initialize_delay_val(sys->sp, sys->num_of_species, sys->param, sys->num_of_parameters, sys->comp, sys->num_of_compartments, sys->re, sys->num_of_reactions, sim_time, sys->dt, 1);
+  return 1;
+}
+
+void ode_system_get_state(ode_system *sys, double *y){
+  unsigned int i;
+  double *p = y;
+  for(i=0; i<sys->num_of_var_species; i++){
+    if(sys->is_scaled_species[i]){
+      *p++ = sys->var_sp[i]->value*sys->var_sp[i]->locating_compartment->value;
+    }else{
+      *p++ = sys->var_sp[i]->value;
+    }
+  }
+  for(i=0; i<sys->num_of_var_parameters; i++){
+    *p++ = sys->var_param[i]->value;
+  }
+  for(i=0; i<sys->num_of_var_compartments; i++){
+    *p++ = sys->var_comp[i]->value;
+  }
+  for(i=0; i<sys->num_of_var_species_reference; i++){
+    *p++ = sys->var_spr[i]->value;
+  }
+}
+
+static void ode_system_scatter_species(ode_system *sys, const double *y){
+  unsigned int i;
+  for(i=0; i<sys->num_of_var_species; i++){
+    if(sys->is_scaled_species[i]){
+      sys->var_sp[i]->temp_value = y[i]/sys->var_sp[i]->locating_compartment->temp_value;
+    }else{
+      sys->var_sp[i]->temp_value = y[i];
+    }
+  }
+}
+
+int ode_system_set_state(ode_system *sys, double t, const double *y){
+  unsigned int i;
+  const double *p = y + sys->num_of_var_species;
+
+  *sys->time = t;
+  for(i=0; i<sys->num_of_var_parameters; i++){
+    sys->var_param[i]->temp_value = *p++;
+  }
+  for(i=0; i<sys->num_of_var_compartments; i++){
+    sys->var_comp[i]->temp_value = *p++;
+  }
+  for(i=0; i<sys->num_of_var_species_reference; i++){
+    sys->var_spr[i]->temp_value = *p++;
+  }
+  /* compartment sizes first, so that concentrations can be derived from amounts */
+  ode_system_calc_assignment(sys, 1);
+  ode_system_scatter_species(sys, y);
+  ode_system_calc_assignment(sys, 0);
+  if(sys->algEq != NULL){
+    if(!ode_system_calc_algebraic(sys)){
+      return 0;
+    }
+    ode_system_scatter_species(sys, y);
+  }
+  return 1;
+}
+
+int ode_system_rhs(ode_system *sys, double t, const double *y, double *f){
+  unsigned int i;
+  double *p = f;
+
+  if(!ode_system_set_state(sys, t, y)){
+    return 0;
+  }
+  calc_k(sys->var_sp, sys->num_of_var_species, sys->var_param, sys->num_of_var_parameters, sys->var_comp, sys->num_of_var_compartments, sys->var_spr, sys->num_of_var_species_reference, sys->re, sys->num_of_reactions, sys->rule, sys->num_of_rules, sys->cycle, sys->dt, &sys->reverse_time, 0, 0, sys->ctx);
+  for(i=0; i<sys->num_of_var_species; i++){
+    if(sys->is_scaled_species[i]){
+      *p++ = sys->var_sp[i]->k[0]*sys->var_sp[i]->locating_compartment->temp_value;
+    }else{
+      *p++ = sys->var_sp[i]->k[0];
+    }
+  }
+  for(i=0; i<sys->num_of_var_parameters; i++){
+    *p++ = sys->var_param[i]->k[0];
+  }
+  for(i=0; i<sys->num_of_var_compartments; i++){
+    *p++ = sys->var_comp[i]->k[0];
+  }
+  for(i=0; i<sys->num_of_var_species_reference; i++){
+    *p++ = sys->var_spr[i]->k[0];
+  }
+  sys->num_of_rhs_evaluations++;
+  return 1;
+}
+
+int ode_system_jacobian(ode_system *sys, double t, const double *y, const double *f, const double *ewt, double **jac){
+  unsigned int i, j;
+  unsigned int n = sys->num_of_vars;
+  double delta;
+
+  for(i=0; i<n; i++){
+    sys->work_y[i] = y[i];
+  }
+  for(j=0; j<n; j++){
+    delta = sqrt(DBL_EPSILON)*my_fmax(fabs(y[j]), 1.0/ewt[j]);
+    sys->work_y[j] = y[j] + delta;
+    /* numerical differentiation */
+    if(!ode_system_rhs(sys, t, sys->work_y, sys->work_f)){
+      return 0;
+    }
+    for(i=0; i<n; i++){
+      jac[i][j] = (sys->work_f[i] - f[i])/delta;
+    }
+    sys->work_y[j] = y[j];
+  }
+  sys->num_of_jacobian_evaluations++;
+  return 1;
+}
+
+int ode_system_commit(ode_system *sys, double t, const double *y){
+  if(!ode_system_set_state(sys, t, y)){
+    return 0;
+  }
+  ode_system_forwarding_value(sys);
+  return 1;
+}
+
+static unsigned int ode_system_take_snapshot(ode_system *sys, int compare){
+  unsigned int i;
+  unsigned int changed = 0;
+  double *p = sys->snapshot;
+
+  for(i=0; i<sys->num_of_all_var_species; i++, p++){
+    if(compare && *p != sys->all_var_sp[i]->value) changed++;
+    *p = sys->all_var_sp[i]->value;
+  }
+  for(i=0; i<sys->num_of_all_var_parameters; i++, p++){
+    if(compare && *p != sys->all_var_param[i]->value) changed++;
+    *p = sys->all_var_param[i]->value;
+  }
+  for(i=0; i<sys->num_of_all_var_compartments; i++, p++){
+    if(compare && *p != sys->all_var_comp[i]->value) changed++;
+    *p = sys->all_var_comp[i]->value;
+  }
+  for(i=0; i<sys->num_of_all_var_species_reference; i++, p++){
+    if(compare && *p != sys->all_var_spr[i]->value) changed++;
+    *p = sys->all_var_spr[i]->value;
+  }
+  return changed;
+}
+
+static boolean ode_system_trigger(ode_system *sys, unsigned int i){
+  return calc(sys->event[i]->eq, sys->dt, sys->cycle, &sys->reverse_time, 0) >= 0.5;
+}
+
+/* returns true if any trigger differs from trigger_values at the current temp_value */
+static boolean ode_system_trigger_changed(ode_system *sys){
+  unsigned int i;
+  for(i=0; i<sys->num_of_events; i++){
+    if(ode_system_trigger(sys, i) != sys->trigger_values[i]){
+      return true;
+    }
+  }
+  return false;
+}
+
+boolean ode_system_calc_discontinuity(ode_system *sys){
+  unsigned int i, j;
+  myReaction **re = sys->re;
+  double dt = sys->dt;
+  int cycle = sys->cycle;
+  double reactants_numerator, products_numerator;
+  double min_value;
+  boolean changed;
+
+  ode_system_take_snapshot(sys, 0);
+
+  /* calculate unreversible fast reaction */
+  for(i=0; i<sys->num_of_reactions; i++){
+    if(re[i]->is_fast && !re[i]->is_reversible){
+      if(calc(re[i]->eq, dt, cycle, &sys->reverse_time, 0) > 0){
+        min_value = DBL_MAX;
+        for(j=0; j<re[i]->num_of_reactants; j++){
+          if(min_value > re[i]->reactants[j]->mySp->value/calc(re[i]->reactants[j]->eq, dt, cycle, &sys->reverse_time, 0)){
+            min_value = re[i]->reactants[j]->mySp->value/calc(re[i]->reactants[j]->eq, dt, cycle, &sys->reverse_time, 0);
+          }
+        }
+        for(j=0; j<re[i]->num_of_products; j++){
+          if(!Species_getBoundaryCondition(re[i]->products[j]->mySp->origin)){
+            re[i]->products[j]->mySp->value += calc(re[i]->products[j]->eq, dt, cycle, &sys->reverse_time, 0)*min_value;
+            re[i]->products[j]->mySp->temp_value = re[i]->products[j]->mySp->value;
+          }
+        }
+        for(j=0; j<re[i]->num_of_reactants; j++){
+          if(!Species_getBoundaryCondition(re[i]->reactants[j]->mySp->origin)){
+            re[i]->reactants[j]->mySp->value -= calc(re[i]->reactants[j]->eq, dt, cycle, &sys->reverse_time, 0)*min_value;
+            re[i]->reactants[j]->mySp->temp_value = re[i]->reactants[j]->mySp->value;
+          }
+        }
+      }
+    }
+  }
+  /* calculate reversible fast reactioin */
+  for(i=0; i<sys->num_of_reactions; i++){
+    if(re[i]->is_fast && re[i]->is_reversible){
+      if(!(Species_getBoundaryCondition(re[i]->products[0]->mySp->origin)
+            && Species_getBoundaryCondition(re[i]->reactants[0]->mySp->origin))){
+        products_numerator = calc(re[i]->products_equili_numerator, dt, cycle, &sys->reverse_time, 0);
+        reactants_numerator = calc(re[i]->reactants_equili_numerator, dt, cycle, &sys->reverse_time, 0);
+        if(products_numerator > 0 || reactants_numerator > 0){
+          if(Species_getBoundaryCondition(re[i]->products[0]->mySp->origin)){
+            re[i]->reactants[0]->mySp->value = (reactants_numerator/products_numerator)*re[i]->products[0]->mySp->value;
+            re[i]->reactants[0]->mySp->temp_value = re[i]->reactants[0]->mySp->value;
+          }else if(Species_getBoundaryCondition(re[i]->reactants[0]->mySp->origin)){
+            re[i]->products[0]->mySp->value = (products_numerator/reactants_numerator)*re[i]->reactants[0]->mySp->value;
+            re[i]->products[0]->mySp->temp_value = re[i]->products[0]->mySp->value;
+          }else{
+            re[i]->products[0]->mySp->value = (products_numerator/(products_numerator+reactants_numerator))*(re[i]->products[0]->mySp->temp_value+re[i]->reactants[0]->mySp->temp_value);
+            re[i]->reactants[0]->mySp->value = (reactants_numerator/(products_numerator+reactants_numerator))*(re[i]->products[0]->mySp->temp_value+re[i]->reactants[0]->mySp->temp_value);
+            re[i]->products[0]->mySp->temp_value = re[i]->products[0]->mySp->value;
+            re[i]->reactants[0]->mySp->temp_value = re[i]->reactants[0]->mySp->value;
+          }
+        }
+      }
+    }
+  }
+
+  /* event */
+  calc_event(sys->event, sys->num_of_events, dt, *sys->time, cycle, &sys->reverse_time, sys->ctx);
+  sys->cycle++;
+
+  changed = (ode_system_take_snapshot(sys, 1) != 0);
+  if(changed){
+    /* re-evaluate rules with the new values */
+    ode_system_get_state(sys, sys->work_y);
+    ode_system_commit(sys, *sys->time, sys->work_y);
+  }
+  for(i=0; i<sys->num_of_events; i++){
+    sys->trigger_values[i] = ode_system_trigger(sys, i);
+  }
+  return changed;
+}
+
+void ode_hermite_interpolate(void *data, double t, double *y){
+  ode_hermite *d = (ode_hermite *)data;
+  unsigned int i;
+  double theta = (t - d->t0)/d->h;
+  double dy;
+  for(i=0; i<d->n; i++){
+    dy = d->y1[i] - d->y0[i];
+    y[i] = d->y0[i] + theta*(dy + (1 - theta)*(d->h*d->f0[i] - dy + theta*(2*dy - d->h*(d->f0[i] + d->f1[i]))));
+  }
+}
+
+int ode_system_locate_event(ode_system *sys, double t0, double t1, ode_interpolant interpolant, void *data, double *te, double *ye){
+  unsigned int i;
+  myEvent *ev;
+  double lo = t0, hi = t1, mid, tol;
+  boolean is_delayed = false;
+
+  if(sys->num_of_events == 0){
+    return 0;
+  }
+  /* delayed events due in the step (the queue holds num_of_delayed_events_que firing times) */
+  for(i=0; i<sys->num_of_events; i++){
+    ev = sys->event[i];
+    if(ev->event_delay != NULL && ev->next_firing_index >= 0
+        && (unsigned int)ev->next_firing_index < ev->num_of_delayed_events_que
+        && ev->firing_times[ev->next_firing_index] > t0
+        && ev->firing_times[ev->next_firing_index] < hi){
+      hi = ev->firing_times[ev->next_firing_index];
+      is_delayed = true;
+    }
+  }
+  interpolant(data, hi, ye);
+  if(!ode_system_set_state(sys, hi, ye)){
+    return -1;
+  }
+  if(!ode_system_trigger_changed(sys)){
+    if(!is_delayed){
+      return 0;
+    }
+    *te = hi;
+    return 1;
+  }
+  /* bisection on the trigger values, which are boolean */
+  tol = ODE_EVENT_RTOL*my_fmax(fabs(t1), t1 - t0);
+  while(hi - lo > tol){
+    mid = 0.5*(lo + hi);
+    interpolant(data, mid, ye);
+    if(!ode_system_set_state(sys, mid, ye)){
+      return -1;
+    }
+    if(ode_system_trigger_changed(sys)){
+      hi = mid;
+    }else{
+      lo = mid;
+    }
+  }
+  interpolant(data, hi, ye);
+  *te = hi;
+  return 1;
+}
+
+void ode_system_store_statistics(ode_system *sys, myResult *result){
+  result->num_of_steps = sys->num_of_steps;
+  result->num_of_rejected_steps = sys->num_of_rejected_steps;
+  result->num_of_rhs_evaluations = sys->num_of_rhs_evaluations;
+  result->num_of_jacobian_evaluations = sys->num_of_jacobian_evaluations;
+  result->num_of_lu_decompositions = sys->num_of_lu_decompositions;
+  result->num_of_stiff_steps = sys->num_of_stiff_steps;
+  result->num_of_method_switches = sys->num_of_method_switches;
+}
+
+void ode_system_print_result(ode_system *sys, myResult *result, int row, int print_amount){
+  unsigned int i;
+  double *value_sp_p = result->values_sp + row*sys->num_of_species;
+  double *value_param_p = result->values_param + row*sys->num_of_parameters;
+  double *value_comp_p = result->values_comp + row*sys->num_of_compartments;
+  mySpecies **sp = sys->sp;
+
+  /*  Time */
+  result->values_time[row] = *sys->time;
+  /*  Species */
+  for(i=0; i<sys->num_of_species; i++){
+    if(print_amount){
+      if(sp[i]->is_concentration){
+        *value_sp_p = sp[i]->temp_value*sp[i]->locating_compartment->temp_value;
+      }else{
+        *value_sp_p = sp[i]->temp_value;
+      }
+    }else{
+      if(sp[i]->is_amount){
+        *value_sp_p = sp[i]->temp_value/sp[i]->locating_compartment->temp_value;
+      }else{
+        *value_sp_p = sp[i]->temp_value;
+      }
+    }
+    value_sp_p++;
+  }
+  /*  Parameter */
+  for(i=0; i<sys->num_of_parameters; i++){
+    *value_param_p++ = sys->param[i]->temp_value;
+  }
+  /*  Compartment */
+  for(i=0; i<sys->num_of_compartments; i++){
+    *value_comp_p++ = sys->comp[i]->temp_value;
+  }
+}
+
+void ode_system_error_weights(unsigned int n, const double *y, double atol, double rtol, double *ewt){
+  unsigned int i;
+  for(i=0; i<n; i++){
+    ewt[i] = 1.0/(rtol*fabs(y[i]) + atol);
+  }
+}
+
+double ode_system_wrms_norm(unsigned int n, const double *v, const double *ewt){
+  unsigned int i;
+  double sum = 0;
+  if(n == 0){
+    return 0;
+  }
+  for(i=0; i<n; i++){
+    sum += (v[i]*ewt[i])*(v[i]*ewt[i]);
+  }
+  return sqrt(sum/n);
+}
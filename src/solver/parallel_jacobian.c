@@ -0,0 +1,215 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "../libsbmlsim/libsbmlsim.h"
+
+void model_replica_init(model_replica *rep, Model_t *m, double sim_time, double dt, int print_interval){
+  sbmlsim_context *prev_ctx;
+
+  /* the ASTs of the replica are registered to its own context, so that
+   * freeing it does not free the ones of the simulation */
+  rep->ctx = sbmlsim_context_create(0);
+  prev_ctx = sbmlsim_context_attach(rep->ctx);
+  rep->mem = allocated_memory_create();
+  rep->cp_AST = copied_AST_create();
+  rep->sp = (mySpecies **)malloc(sizeof(mySpecies *) * Model_getNumSpecies(m));
+  rep->param = (myParameter **)malloc(sizeof(myParameter *) * Model_getNumParameters(m));
+  rep->comp = (myCompartment **)malloc(sizeof(myCompartment *) * Model_getNumCompartments(m));
+  rep->re = (myReaction **)malloc(sizeof(myReaction *) * Model_getNumReactions(m));
+  rep->rule = (myRule **)malloc(sizeof(myRule *) * Model_getNumRules(m));
+  rep->event = (myEvent **)malloc(sizeof(myEvent *) * Model_getNumEvents(m));
+  rep->initAssign = (myInitialAssignment **)malloc(sizeof(myInitialAssignment *) * Model_getNumInitialAssignments(m));
+  rep->algEq = NULL;
+  rep->timeVarAssign = NULL;
+  rep->time = 0;
+  rep->reverse_time = 0;
+  create_mySBML_objects(false, m, rep->sp, rep->param, rep->comp, rep->re, rep->rule, rep->event,
+      rep->initAssign, &rep->algEq, &rep->timeVarAssign,
+      sim_time, dt, &rep->time, rep->mem, rep->cp_AST, print_interval);
+  sbmlsim_context_attach(prev_ctx);
+  rep->sys = ode_system_create(m, rep->sp, rep->param, rep->comp, rep->re, rep->rule, rep->event, rep->algEq, &rep->time, dt, rep->ctx);
+}
+
+void model_replica_free(model_replica *rep){
+  Model_t *m = rep->sys->m;
+  sbmlsim_context *prev_ctx;
+
+  ode_system_free(rep->sys);
+  prev_ctx = sbmlsim_context_attach(rep->ctx);
+  free_mySBML_objects(m, rep->sp, rep->param, rep->comp, rep->re, rep->rule, rep->event,
+      rep->initAssign, rep->algEq, rep->timeVarAssign, rep->mem, rep->cp_AST);
+  sbmlsim_context_attach(prev_ctx);
+  sbmlsim_context_free(rep->ctx);
+}
+
+parallel_jacobian *parallel_jacobian_create(sbmlsim_context *ctx, Model_t *m, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], double *time, double dt){
+  parallel_jacobian *jac;
+  sbmlsim_team *team;
+  ode_system *master;
+
+  team = sbmlsim_context_team(ctx);
+  if(team == NULL || ctx->model == NULL){
+    return NULL;
+  }
+  master = ode_system_create(m, sp, param, comp, re, rule, event, NULL, time, dt, ctx);
+  if(master->num_of_vars < 2 || master->num_of_vars < ctx->jacobian_min_variables
+      || has_delay_val(sp, master->num_of_species, param, master->num_of_parameters, comp, master->num_of_compartments, re, master->num_of_reactions)){
+    ode_system_free(master);
+    return NULL;
+  }
+  jac = (parallel_jacobian *)malloc(sizeof(parallel_jacobian));
+  jac->team = team;
+  jac->master = master;
+  jac->replicas = sbmlsim_model_replicas(ctx->model, sbmlsim_team_size(team));
+  return jac;
+}
+
+void parallel_jacobian_free(parallel_jacobian *jac){
+  if(jac == NULL){
+    return;
+  }
+  ode_system_free(jac->master);
+  free(jac);
+}
+
+#define COPY_STATE(dst, src) do { \
+  (dst)->value = (src)->value; \
+  (dst)->temp_value = (src)->temp_value; \
+} while (0)
+
+#define COPY_HISTORY(dst, src) do { \
+  (dst)->prev_val[0] = (src)->prev_val[0]; \
+  (dst)->prev_val[1] = (src)->prev_val[1]; \
+  (dst)->prev_val[2] = (src)->prev_val[2]; \
+  (dst)->prev_k[0] = (src)->prev_k[0]; \
+  (dst)->prev_k[1] = (src)->prev_k[1]; \
+} while (0)
+
+/* values of all objects (including the ones set by initial assignments
+ * and events) and the history of the variables */
+static void copy_state(ode_system *dst, ode_system *src){
+  unsigned int i, j;
+
+  for(i=0; i<src->num_of_species; i++){
+    COPY_STATE(dst->sp[i], src->sp[i]);
+  }
+  for(i=0; i<src->num_of_parameters; i++){
+    COPY_STATE(dst->param[i], src->param[i]);
+  }
+  for(i=0; i<src->num_of_compartments; i++){
+    COPY_STATE(dst->comp[i], src->comp[i]);
+  }
+  for(i=0; i<src->num_of_reactions; i++){
+    for(j=0; j<src->re[i]->num_of_products; j++){
+      COPY_STATE(dst->re[i]->products[j], src->re[i]->products[j]);
+    }
+    for(j=0; j<src->re[i]->num_of_reactants; j++){
+      COPY_STATE(dst->re[i]->reactants[j], src->re[i]->reactants[j]);
+    }
+  }
+  for(i=0; i<src->num_of_var_species; i++){
+    COPY_HISTORY(dst->var_sp[i], src->var_sp[i]);
+  }
+  for(i=0; i<src->num_of_var_parameters; i++){
+    COPY_HISTORY(dst->var_param[i], src->var_param[i]);
+  }
+  for(i=0; i<src->num_of_var_compartments; i++){
+    COPY_HISTORY(dst->var_comp[i], src->var_comp[i]);
+  }
+  for(i=0; i<src->num_of_var_species_reference; i++){
+    COPY_HISTORY(dst->var_spr[i], src->var_spr[i]);
+  }
+  *dst->time = *src->time;
+}
+
+/* temp_value of the i-th variable */
+static double *variable_temp_value(ode_system *sys, unsigned int i){
+  if(i < sys->num_of_var_species){
+    return &sys->var_sp[i]->temp_value;
+  }
+  i -= sys->num_of_var_species;
+  if(i < sys->num_of_var_parameters){
+    return &sys->var_param[i]->temp_value;
+  }
+  i -= sys->num_of_var_parameters;
+  if(i < sys->num_of_var_compartments){
+    return &sys->var_comp[i]->temp_value;
+  }
+  i -= sys->num_of_var_compartments;
+  return &sys->var_spr[i]->temp_value;
+}
+
+/* calc_implicit_formula() of the i-th variable, as in simulate_implicit() */
+static double variable_formula(ode_system *sys, unsigned int i, int order, double k_t, double dt){
+  mySpecies *sp;
+  myParameter *param;
+  myCompartment *comp;
+  mySpeciesReference *spr;
+
+  if(i < sys->num_of_var_species){
+    sp = sys->var_sp[i];
+    return calc_implicit_formula(order, sp->temp_value, sp->value, sp->prev_val[0], sp->prev_val[1], sp->prev_val[2], sp->k[0], k_t, sp->prev_k[0], sp->prev_k[1], dt);
+  }
+  i -= sys->num_of_var_species;
+  if(i < sys->num_of_var_parameters){
+    param = sys->var_param[i];
+    return calc_implicit_formula(order, param->temp_value, param->value, param->prev_val[0], param->prev_val[1], param->prev_val[2], param->k[0], k_t, param->prev_k[0], param->prev_k[1], dt);
+  }
+  i -= sys->num_of_var_parameters;
+  if(i < sys->num_of_var_compartments){
+    comp = sys->var_comp[i];
+    return calc_implicit_formula(order, comp->temp_value, comp->value, comp->prev_val[0], comp->prev_val[1], comp->prev_val[2], comp->k[0], k_t, comp->prev_k[0], comp->prev_k[1], dt);
+  }
+  i -= sys->num_of_var_compartments;
+  spr = sys->var_spr[i];
+  return calc_implicit_formula(order, spr->temp_value, spr->value, spr->prev_val[0], spr->prev_val[1], spr->prev_val[2], spr->k[0], k_t, spr->prev_k[0], spr->prev_k[1], dt);
+}
+
+/* columns of the member on its replica */
+static void calc_columns(void *arg, int member, int num_of_members){
+  parallel_jacobian *jac = (parallel_jacobian *)arg;
+  model_replica *rep = &jac->replicas[member];
+  ode_system *sys = rep->sys;
+  unsigned int n = jac->master->num_of_vars;
+  unsigned int first = (unsigned int)((double)n * member / num_of_members);
+  unsigned int last = (unsigned int)((double)n * (member + 1) / num_of_members);
+  unsigned int i, loop;
+  double *x;
+  double saved;
+
+  copy_state(sys, jac->master);
+  rep->reverse_time = jac->reverse_time;
+  for(loop=first; loop<last; loop++){
+    x = variable_temp_value(sys, loop);
+    saved = *x;
+    *x += jac->delta;
+    calc_k(sys->var_sp, sys->num_of_var_species, sys->var_param, sys->num_of_var_parameters, sys->var_comp, sys->num_of_var_compartments, sys->var_spr, sys->num_of_var_species_reference, sys->re, sys->num_of_reactions, sys->rule, sys->num_of_rules, jac->cycle, jac->dt, &rep->reverse_time, 0, 0, NULL);
+    for(i=0; i<n; i++){
+      /* numerical differentiation */
+      jac->jacobian[i][loop] = (variable_formula(sys, i, jac->order, jac->k_t[i], jac->dt)-jac->b[i])/jac->delta;
+    }
+    *x = saved;
+  }
+}
+
+void parallel_jacobian_calc(parallel_jacobian *jac, int order, double dt, int cycle, double reverse_time, double delta, const double *b, const double *k_t, double **jacobian){
+  jac->order = order;
+  jac->dt = dt;
+  jac->cycle = cycle;
+  jac->reverse_time = reverse_time;
+  jac->delta = delta;
+  jac->b = b;
+  jac->k_t = k_t;
+  jac->jacobian = jacobian;
+  sbmlsim_team_run(jac->team, calc_columns, jac);
+}
@@ -0,0 +1,197 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "../libsbmlsim/libsbmlsim.h"
+
+typedef struct {
+  mySpecies *species;
+  unsigned int term;
+} rhs_incidence;
+
+/* by species, then by term (= order of the serial code) */
+static int compare_incidence(const void *a, const void *b){
+  const rhs_incidence *x = (const rhs_incidence *)a;
+  const rhs_incidence *y = (const rhs_incidence *)b;
+  if((const char *)x->species != (const char *)y->species){
+    return ((const char *)x->species < (const char *)y->species) ? -1 : 1;
+  }
+  if(x->term != y->term){
+    return (x->term < y->term) ? -1 : 1;
+  }
+  return 0;
+}
+
+/* blocks[0..n] such that the items in each block cost about the same,
+ * cost[i] is the cost of the items before i (cost[num_of_items] is the total) */
+static void split_blocks(const double *cost, unsigned int num_of_items, unsigned int *blocks, int n){
+  unsigned int i = 0;
+  int m;
+
+  blocks[0] = 0;
+  for(m=1; m<n; m++){
+    while(i < num_of_items && cost[i] < cost[num_of_items] * m / n){
+      i++;
+    }
+    blocks[m] = i;
+  }
+  blocks[n] = num_of_items;
+}
+
+static void add_terms(parallel_rhs *rhs, mySpeciesReference **refs, unsigned int num_of_refs, boolean is_reactant, unsigned int *num_of_terms){
+  unsigned int j;
+
+  for(j=0; j<num_of_refs; j++){
+    if(!Species_getBoundaryCondition(refs[j]->mySp->origin)){
+      if(rhs->term_refs != NULL){
+        rhs->term_refs[*num_of_terms] = refs[j];
+        rhs->term_is_reactant[*num_of_terms] = is_reactant;
+      }
+      (*num_of_terms)++;
+    }
+  }
+}
+
+parallel_rhs *parallel_rhs_create(myReaction *re[], unsigned int re_num, sbmlsim_team *team){
+  parallel_rhs *rhs;
+  rhs_incidence *incidences;
+  double *cost;
+  unsigned int i, j, t, num_of_terms;
+  int n = sbmlsim_team_size(team);
+
+  rhs = (parallel_rhs *)malloc(sizeof(parallel_rhs));
+  rhs->re = re;
+  rhs->re_num = re_num;
+  rhs->team = team;
+  rhs->reactions = (myReaction **)malloc(sizeof(myReaction *) * (re_num + 1));
+  rhs->first_term = (unsigned int *)malloc(sizeof(unsigned int) * (re_num + 1));
+  rhs->term_refs = NULL;
+  rhs->term_is_reactant = NULL;
+
+  /* count the terms, then fill them in */
+  rhs->num_of_reactions = 0;
+  num_of_terms = 0;
+  for(i=0; i<re_num; i++){
+    if(!re[i]->is_fast){
+      rhs->reactions[rhs->num_of_reactions++] = re[i];
+      add_terms(rhs, re[i]->products, re[i]->num_of_products, false, &num_of_terms);
+      add_terms(rhs, re[i]->reactants, re[i]->num_of_reactants, true, &num_of_terms);
+    }
+  }
+  rhs->term_refs = (mySpeciesReference **)malloc(sizeof(mySpeciesReference *) * (num_of_terms + 1));
+  rhs->term_is_reactant = (boolean *)malloc(sizeof(boolean) * (num_of_terms + 1));
+  rhs->terms = (double *)malloc(sizeof(double) * (num_of_terms + 1));
+  cost = (double *)malloc(sizeof(double) * (rhs->num_of_reactions + num_of_terms + 1));
+  num_of_terms = 0;
+  cost[0] = 0;
+  for(i=0; i<rhs->num_of_reactions; i++){
+    rhs->first_term[i] = num_of_terms;
+    add_terms(rhs, rhs->reactions[i]->products, rhs->reactions[i]->num_of_products, false, &num_of_terms);
+    add_terms(rhs, rhs->reactions[i]->reactants, rhs->reactions[i]->num_of_reactants, true, &num_of_terms);
+    /* the work of a reaction is the length of its math and stoichiometries */
+    cost[i + 1] = cost[i] + rhs->reactions[i]->eq->math_length;
+    for(t=rhs->first_term[i]; t<num_of_terms; t++){
+      cost[i + 1] += rhs->term_refs[t]->eq->math_length;
+    }
+  }
+  rhs->first_term[rhs->num_of_reactions] = num_of_terms;
+  rhs->reaction_blocks = (unsigned int *)malloc(sizeof(unsigned int) * (n + 1));
+  split_blocks(cost, rhs->num_of_reactions, rhs->reaction_blocks, n);
+
+  /* group the terms by species */
+  incidences = (rhs_incidence *)malloc(sizeof(rhs_incidence) * (num_of_terms + 1));
+  for(t=0; t<num_of_terms; t++){
+    incidences[t].species = rhs->term_refs[t]->mySp;
+    incidences[t].term = t;
+  }
+  qsort(incidences, num_of_terms, sizeof(rhs_incidence), compare_incidence);
+  rhs->species = (mySpecies **)malloc(sizeof(mySpecies *) * (num_of_terms + 1));
+  rhs->first_incidence = (unsigned int *)malloc(sizeof(unsigned int) * (num_of_terms + 1));
+  rhs->incidences = (unsigned int *)malloc(sizeof(unsigned int) * (num_of_terms + 1));
+  rhs->num_of_species = 0;
+  for(t=0; t<num_of_terms; t++){
+    if(t == 0 || incidences[t].species != incidences[t - 1].species){
+      rhs->species[rhs->num_of_species] = incidences[t].species;
+      rhs->first_incidence[rhs->num_of_species] = t;
+      rhs->num_of_species++;
+    }
+    rhs->incidences[t] = incidences[t].term;
+  }
+  rhs->first_incidence[rhs->num_of_species] = num_of_terms;
+  for(j=0; j<=rhs->num_of_species; j++){
+    cost[j] = rhs->first_incidence[j];
+  }
+  rhs->species_blocks = (unsigned int *)malloc(sizeof(unsigned int) * (n + 1));
+  split_blocks(cost, rhs->num_of_species, rhs->species_blocks, n);
+
+  free(incidences);
+  free(cost);
+  return rhs;
+}
+
+void parallel_rhs_free(parallel_rhs *rhs){
+  if(rhs == NULL){
+    return;
+  }
+  free(rhs->reactions);
+  free(rhs->first_term);
+  free(rhs->term_refs);
+  free(rhs->term_is_reactant);
+  free(rhs->terms);
+  free(rhs->species);
+  free(rhs->first_incidence);
+  free(rhs->incidences);
+  free(rhs->reaction_blocks);
+  free(rhs->species_blocks);
+  free(rhs);
+}
+
+/* terms of the reactions of the member */
+static void calc_terms(void *arg, int member, int num_of_members){
+  parallel_rhs *rhs = (parallel_rhs *)arg;
+  unsigned int i, t;
+  double k;
+
+  for(i=rhs->reaction_blocks[member]; i<rhs->reaction_blocks[member + 1]; i++){
+    k = calc(rhs->reactions[i]->eq, rhs->dt, rhs->cycle, rhs->reverse_time, rhs->step);
+    for(t=rhs->first_term[i]; t<rhs->first_term[i + 1]; t++){
+      rhs->terms[t] = calc(rhs->term_refs[t]->eq, rhs->dt, rhs->cycle, rhs->reverse_time, rhs->step)*k;
+    }
+  }
+}
+
+/* k of the species of the member */
+static void scatter_terms(void *arg, int member, int num_of_members){
+  parallel_rhs *rhs = (parallel_rhs *)arg;
+  unsigned int i, j, t;
+  int step = rhs->step;
+
+  for(i=rhs->species_blocks[member]; i<rhs->species_blocks[member + 1]; i++){
+    for(j=rhs->first_incidence[i]; j<rhs->first_incidence[i + 1]; j++){
+      t = rhs->incidences[j];
+      if(rhs->term_is_reactant[t]){
+        rhs->species[i]->k[step] -= rhs->terms[t];
+      }else{
+        rhs->species[i]->k[step] += rhs->terms[t];
+      }
+    }
+  }
+}
+
+void parallel_rhs_calc_reactions(parallel_rhs *rhs, double dt, int cycle, double *reverse_time, int step){
+  rhs->dt = dt;
+  rhs->cycle = cycle;
+  rhs->reverse_time = reverse_time;
+  rhs->step = step;
+  sbmlsim_team_run(rhs->team, calc_terms, rhs);
+  sbmlsim_team_run(rhs->team, scatter_terms, rhs);
+}
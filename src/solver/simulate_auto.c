@@ -0,0 +1,347 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "../libsbmlsim/libsbmlsim.h"
+
+/* Automatic switching between Dormand-Prince (non-stiff) and RODAS4
+ * (stiff). Both are one-step methods, so only y and f(t, y) are carried
+ * across a switch.
+ * - non-stiff -> stiff: h*|lambda| estimated from the last two stages of
+ *   Dormand-Prince exceeds the stability boundary (3.25) on
+ *   AUTO_SWITCH_STEPS accepted steps (Hairer and Wanner, IV.2).
+ * - stiff -> non-stiff: h*||J|| (an upper bound of the dominant eigenvalue)
+ *   stays inside the stability region of Dormand-Prince on
+ *   AUTO_SWITCH_STEPS consecutive accepted steps. */
+
+#define AUTO_NONSTIFF 0
+#define AUTO_STIFF 1
+#define AUTO_SWITCH_STEPS 15
+#define AUTO_STIFF_LIMIT 3.25
+#define AUTO_NONSTIFF_LIMIT 1.5
+#define AUTO_SAFETY 0.9
+#define AUTO_MIN_STEP_RATIO 0.2
+#define AUTO_DOPRI_ORDER 5
+#define AUTO_ROSENBROCK_ORDER 4
+
+/* infinity norm of the jacobian */
+static double auto_jacobian_norm(unsigned int n, double **jacobian){
+  unsigned int i, j;
+  double sum, norm = 0;
+  for(i=0; i<n; i++){
+    sum = 0;
+    for(j=0; j<n; j++){
+      sum += fabs(jacobian[i][j]);
+    }
+    norm = my_fmax(norm, sum);
+  }
+  return norm;
+}
+
+myResult* simulate_auto(Model_t *m, myResult *result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int print_amount, allocated_memory *mem, sbmlsim_context *ctx, double atol, double rtol, double facmax){
+  unsigned int i;
+  int s;
+  ode_system *sys;
+  unsigned int n;
+  myResult *rtn = result;
+  /* output */
+  int row = 0;
+  int num_of_rows = result->num_of_rows;
+  double out_interval = print_interval*dt;
+  double out_eps;
+  double tend = (num_of_rows-1)*out_interval;
+  /* step */
+  double t = 0, tnew;
+  double h = 0, hmax;
+  double d0, d1;
+  double err, fac;
+  boolean last_rejected = false;
+  boolean need_f0 = true;
+  boolean jac_is_valid = false;
+  int has_event;
+  dopri_dense dense;
+  ode_hermite hermite;
+  /* method switching */
+  int mode = AUTO_NONSTIFF;
+  int stiff_count = 0;
+  int nonstiff_count = 0;
+  double jac_norm = 0;
+  double hlamb = 0;
+  /* arrays */
+  double *k[7]; /* k[0] = f(t, y), k[6] = f(t+h, ynew) */
+  double *r[5]; /* continuous extension of Dormand-Prince */
+  double *u[MAX_ROSENBROCK_STAGES];
+  double **jacobian;
+  double **ros_matrix;
+  int *p; /* for pivot selection */
+  double *y, *ynew, *ytmp, *yerr, *fs, *dfdt, *ewt;
+
+  PRG_TRACE(("Simulation for [%s] Starts!\n", Model_getId(m)));
+
+  sys = ode_system_create(m, sp, param, comp, re, rule, event, algEq, time, dt, ctx);
+  n = sys->num_of_vars;
+  if(!ode_system_initialize(sys, initAssign, timeVarAssign, sim_time, mem)){
+    ode_system_free(sys);
+    return NULL;
+  }
+
+  for(s=0; s<7; s++){
+    k[s] = (double *)malloc(sizeof(double) * n);
+  }
+  for(s=0; s<5; s++){
+    r[s] = (double *)malloc(sizeof(double) * n);
+  }
+  for(s=0; s<MAX_ROSENBROCK_STAGES; s++){
+    u[s] = (double *)malloc(sizeof(double) * n);
+  }
+  jacobian = (double **)malloc(sizeof(double *) * n);
+  ros_matrix = (double **)malloc(sizeof(double *) * n);
+  for(i=0; i<n; i++){
+    jacobian[i] = (double *)malloc(sizeof(double) * n);
+    ros_matrix[i] = (double *)malloc(sizeof(double) * n);
+  }
+  p = (int *)malloc(sizeof(int) * n);
+  y = (double *)malloc(sizeof(double) * n);
+  ynew = (double *)malloc(sizeof(double) * n);
+  ytmp = (double *)malloc(sizeof(double) * n);
+  yerr = (double *)malloc(sizeof(double) * n);
+  fs = (double *)malloc(sizeof(double) * n);
+  dfdt = (double *)malloc(sizeof(double) * n);
+  ewt = (double *)malloc(sizeof(double) * n);
+
+  /* results are printed and events are located on the continuous
+   * extension of Dormand-Prince, or by cubic Hermite interpolation for
+   * RODAS4 */
+  hmax = tend;
+  dense.n = n;
+  dense.r = r;
+  hermite.n = n;
+  hermite.y0 = y;
+  hermite.f0 = k[0];
+  hermite.y1 = ynew;
+  hermite.f1 = k[6];
+  out_eps = 1.0e-10*out_interval;
+
+  /* t = 0 */
+  ode_system_calc_discontinuity(sys);
+  ode_system_get_state(sys, y);
+  if(ode_system_commit(sys, t, y)){
+    ode_system_print_result(sys, result, row++, print_amount);
+  }else{
+    rtn = NULL;
+  }
+
+  while(rtn != NULL && row < num_of_rows){
+    if(need_f0){
+      if(!ode_system_rhs(sys, t, y, k[0])){
+        TRACE(("the state can not be set at t = %g\n", t));
+        rtn = NULL;
+        break;
+      }
+      need_f0 = false;
+      jac_is_valid = false;
+      h = 0;
+    }
+    if(h == 0){
+      /* initial step size */
+      ode_system_error_weights(n, y, atol, rtol, ewt);
+      d0 = ode_system_wrms_norm(n, y, ewt);
+      d1 = ode_system_wrms_norm(n, k[0], ewt);
+      if(d0 > 1.0e-5 && d1 > 1.0e-5){
+        h = 0.01*d0/d1;
+      }else if(n == 0){
+        h = hmax;
+      }else{
+        h = 1.0e-6*my_fmax(out_interval, 1.0e-3);
+      }
+      last_rejected = false;
+    }
+    if(h > hmax){
+      h = hmax;
+    }
+    if(t + h > tend){
+      h = tend - t;
+    }
+    if(h < 100*DBL_EPSILON*my_fmax(fabs(t), out_interval)){
+      TRACE(("step size too small at t = %g\n", t));
+      rtn = NULL;
+      break;
+    }
+    if(mode == AUTO_NONSTIFF){
+      err = dopri_step(sys, t, h, y, k, ynew, ytmp, yerr, atol, rtol);
+      hlamb = dopri_stiffness(n, h, k, ynew, ytmp);
+      fac = pow(err, 1.0/AUTO_DOPRI_ORDER)/AUTO_SAFETY;
+    }else{
+      if(!jac_is_valid){
+        ode_system_error_weights(n, y, atol, rtol, ewt);
+        if(!ode_system_jacobian(sys, t, y, k[0], ewt, jacobian)
+            || !rosenbrock_time_derivative(sys, t, y, k[0], dfdt)){
+          TRACE(("the state can not be set near t = %g\n", t));
+          rtn = NULL;
+          break;
+        }
+        jac_norm = auto_jacobian_norm(n, jacobian);
+        jac_is_valid = true;
+      }
+      err = rosenbrock_step(sys, AUTO_ROSENBROCK_ORDER, t, h, y, k[0], jacobian, dfdt, ros_matrix, p, u, ytmp, fs, ynew, yerr, atol, rtol);
+      fac = pow(err, 1.0/AUTO_ROSENBROCK_ORDER)/AUTO_SAFETY;
+    }
+    if(err < 0){
+      /* singular matrix, or f can not be evaluated in the step */
+      sys->num_of_rejected_steps++;
+      h *= 0.5;
+      last_rejected = true;
+      continue;
+    }
+    fac = my_fmax(1.0/facmax, my_fmin(1.0/AUTO_MIN_STEP_RATIO, fac));
+    if(err > 1.0 || err != err){
+      /* reject */
+      sys->num_of_rejected_steps++;
+      if(err != err){
+        fac = 1.0/AUTO_MIN_STEP_RATIO;
+      }
+      h /= fac;
+      last_rejected = true;
+      continue;
+    }
+
+    /* accept, truncate the step at the first event and print result */
+    sys->num_of_steps++;
+    tnew = t + h;
+    if(mode == AUTO_NONSTIFF){
+      dopri_dense_output(n, h, y, ynew, k, r);
+      dense.t0 = t;
+      dense.h = h;
+      has_event = ode_system_locate_event(sys, t, tnew, dopri_dense_interpolate, &dense, &tnew, ytmp);
+    }else{
+      sys->num_of_stiff_steps++;
+      if(!ode_system_rhs(sys, tnew, ynew, k[6])){
+        TRACE(("the state can not be set at t = %g\n", tnew));
+        rtn = NULL;
+        break;
+      }
+      hermite.t0 = t;
+      hermite.h = h;
+      has_event = ode_system_locate_event(sys, t, tnew, ode_hermite_interpolate, &hermite, &tnew, ytmp);
+    }
+    if(has_event < 0){
+      TRACE(("the state can not be set in the step from t = %g\n", t));
+      rtn = NULL;
+      break;
+    }
+    /* yerr is free until the next step */
+    while(row < num_of_rows && row*out_interval < tnew - out_eps){
+      if(mode == AUTO_NONSTIFF){
+        dopri_interpolate(r, n, (row*out_interval - t)/h, yerr);
+      }else{
+        ode_hermite_interpolate(&hermite, row*out_interval, yerr);
+      }
+      if(!ode_system_set_state(sys, row*out_interval, yerr)){
+        rtn = NULL;
+        break;
+      }
+      ode_system_print_result(sys, result, row++, print_amount);
+    }
+    if(has_event){
+      for(i=0; i<n; i++){
+        ynew[i] = ytmp[i];
+      }
+    }
+
+    /* stiffness detection */
+    if(mode == AUTO_NONSTIFF){
+      if(hlamb > AUTO_STIFF_LIMIT){
+        nonstiff_count = 0;
+        if(++stiff_count >= AUTO_SWITCH_STEPS){
+          TRACE(("switch to %s at t = %g\n", MTHD_NAME_ROSENBROCK_4, t + h));
+          mode = AUTO_STIFF;
+          sys->num_of_method_switches++;
+          stiff_count = 0;
+        }
+      }else if(++nonstiff_count >= 6){
+        stiff_count = 0;
+      }
+    }else{
+      if(h*jac_norm <= AUTO_NONSTIFF_LIMIT){
+        if(++nonstiff_count >= AUTO_SWITCH_STEPS){
+          TRACE(("switch to %s at t = %g\n", MTHD_NAME_DORMAND_PRINCE, t + h));
+          mode = AUTO_NONSTIFF;
+          sys->num_of_method_switches++;
+          nonstiff_count = 0;
+        }
+      }else{
+        nonstiff_count = 0;
+      }
+    }
+
+    t = tnew;
+    for(i=0; i<n; i++){
+      y[i] = ynew[i];
+      k[0][i] = k[6][i];
+    }
+    jac_is_valid = false;
+    if(rtn == NULL || !ode_system_commit(sys, t, y)){
+      TRACE(("the state can not be set at t = %g\n", t));
+      rtn = NULL;
+      break;
+    }
+
+    /* fast reactions and events */
+    if(ode_system_calc_discontinuity(sys) || has_event){
+      ode_system_get_state(sys, y);
+      need_f0 = true;
+    }
+    while(row < num_of_rows && row*out_interval <= t + out_eps){
+      *time = row*out_interval;
+      ode_system_print_result(sys, result, row++, print_amount);
+    }
+    *time = t;
+
+    /* next step size */
+    if(last_rejected){
+      h = my_fmin(h, h/fac);
+    }else{
+      h = h/fac;
+    }
+    last_rejected = false;
+  }
+
+  TRACE(("Auto-switching: %u steps (%u stiff), %u switches, %u rejected, %u f evaluations, %u jacobians, %u LU decompositions\n", sys->num_of_steps, sys->num_of_stiff_steps, sys->num_of_method_switches, sys->num_of_rejected_steps, sys->num_of_rhs_evaluations, sys->num_of_jacobian_evaluations, sys->num_of_lu_decompositions));
+  ode_system_store_statistics(sys, result);
+  PRG_TRACE(("Simulation for [%s] Ends!\n", Model_getId(m)));
+
+  for(s=0; s<7; s++){
+    free(k[s]);
+  }
+  for(s=0; s<5; s++){
+    free(r[s]);
+  }
+  for(s=0; s<MAX_ROSENBROCK_STAGES; s++){
+    free(u[s]);
+  }
+  for(i=0; i<n; i++){
+    free(jacobian[i]);
+    free(ros_matrix[i]);
+  }
+  free(jacobian);
+  free(ros_matrix);
+  free(p);
+  free(y);
+  free(ynew);
+  free(ytmp);
+  free(yerr);
+  free(fs);
+  free(dfdt);
+  free(ewt);
+  ode_system_free(sys);
+  return rtn;
+}
@@ -0,0 +1,516 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "../libsbmlsim/libsbmlsim.h"
+
+/* Variable-step, variable-order BDF (order 1 to 5) in Nordsieck form,
+ * after the stiff part of LSODE (Hindmarsh) and CVODE.
+ * The history array z[j] holds h^j/j! * (d^j y/dt^j) at the current time. */
+
+#define BDF_MAX_ORDER 5
+#define BDF_MAX_NEWTON_ITERATIONS 4
+#define BDF_MAX_JACOBIAN_AGE 20
+#define BDF_MAX_STEP_RATIO 10.0
+#define BDF_MIN_STEP_RATIO 0.2
+#define BDF_MAX_ERROR_FAILURES 3
+
+/* l[0..q] : coefficients of the corrector, from prod_{i=1}^{q}(1+x/i) */
+static void bdf_coefficients(int q, double *l){
+  int i, j;
+  l[0] = 1.0;
+  for(i=1; i<=q; i++){
+    l[i] = 0.0;
+  }
+  for(i=1; i<=q; i++){
+    for(j=i; j>0; j--){
+      l[j] += l[j-1]/i;
+    }
+  }
+}
+
+/* prediction by Pascal triangle (z <- z * P) */
+static void bdf_predict(double **z, int q, unsigned int n){
+  int k, j;
+  unsigned int i;
+  for(k=0; k<q; k++){
+    for(j=q; j>k; j--){
+      for(i=0; i<n; i++){
+        z[j-1][i] += z[j][i];
+      }
+    }
+  }
+}
+
+/* inverse of bdf_predict, to restore z after a rejected step */
+static void bdf_restore(double **z, int q, unsigned int n){
+  int k, j;
+  unsigned int i;
+  for(k=q-1; k>=0; k--){
+    for(j=k+1; j<=q; j++){
+      for(i=0; i<n; i++){
+        z[j-1][i] -= z[j][i];
+      }
+    }
+  }
+}
+
+/* change the step size of z from h to eta*h */
+static void bdf_rescale(double **z, int q, unsigned int n, double eta){
+  int j;
+  unsigned int i;
+  double r = 1.0;
+  for(j=1; j<=q; j++){
+    r *= eta;
+    for(i=0; i<n; i++){
+      z[j][i] *= r;
+    }
+  }
+}
+
+/* y(t + x*h) by Nordsieck interpolation */
+static void bdf_interpolate(double **z, int q, unsigned int n, double x, double *y){
+  int j;
+  unsigned int i;
+  for(i=0; i<n; i++){
+    y[i] = z[q][i];
+  }
+  for(j=q-1; j>=0; j--){
+    for(i=0; i<n; i++){
+      y[i] = y[i]*x + z[j][i];
+    }
+  }
+}
+
+/* Nordsieck interpolant of the last step, for ode_system_locate_event() */
+typedef struct {
+  double **z;
+  int q;
+  unsigned int n;
+  double t;
+  double h;
+} bdf_dense;
+
+static void bdf_dense_interpolate(void *data, double t, double *y){
+  bdf_dense *d = (bdf_dense *)data;
+  bdf_interpolate(d->z, d->q, d->n, (t - d->t)/d->h, y);
+}
+
+static double bdf_factorial(int n){
+  double r = 1.0;
+  int i;
+  for(i=2; i<=n; i++){
+    r *= i;
+  }
+  return r;
+}
+
+myResult* simulate_bdf(Model_t *m, myResult *result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int print_amount, allocated_memory *mem, sbmlsim_context *ctx, double atol, double rtol){
+  unsigned int i, j;
+  int k;
+  ode_system *sys;
+  unsigned int n;
+  myResult *rtn = result;
+  /* output */
+  int row = 0;
+  int num_of_rows = result->num_of_rows;
+  double out_interval = print_interval*dt;
+  double out_eps;
+  double tend = (num_of_rows-1)*out_interval;
+  /* step */
+  double t = 0;
+  double tn, te;
+  double h, hmax;
+  double eta, eta_q, eta_up, eta_dn;
+  double err, errup, errdn;
+  double d0, d1;
+  int q = 1, newq;
+  int nsince = 0;
+  int nfail = 0;
+  boolean has_eprev = false;
+  double l[BDF_MAX_ORDER+2];
+  double lm[BDF_MAX_ORDER+2];
+  double lp[BDF_MAX_ORDER+2];
+  double tq;
+  double gamma, gamma_lu = 0;
+  int lu_is_valid = 0;
+  int jac_age = BDF_MAX_JACOBIAN_AGE;
+  int tries;
+  boolean converged;
+  int has_event;
+  bdf_dense dense;
+  double crate, dcon, del, delp;
+  /* arrays */
+  double **z;
+  double **jacobian;
+  double **newton_matrix;
+  int *p; /* for pivot selection */
+  double *y, *e, *eprev, *ewt, *yc, *fc, *dl, *yout;
+
+  PRG_TRACE(("Simulation for [%s] Starts!\n", Model_getId(m)));
+
+  sys = ode_system_create(m, sp, param, comp, re, rule, event, algEq, time, dt, ctx);
+  n = sys->num_of_vars;
+  if(!ode_system_initialize(sys, initAssign, timeVarAssign, sim_time, mem)){
+    ode_system_free(sys);
+    return NULL;
+  }
+
+  z = (double **)malloc(sizeof(double *) * (BDF_MAX_ORDER+2));
+  for(k=0; k<BDF_MAX_ORDER+2; k++){
+    z[k] = (double *)malloc(sizeof(double) * n);
+    for(i=0; i<n; i++){
+      z[k][i] = 0;
+    }
+  }
+  jacobian = (double **)malloc(sizeof(double *) * n);
+  newton_matrix = (double **)malloc(sizeof(double *) * n);
+  for(i=0; i<n; i++){
+    jacobian[i] = (double *)malloc(sizeof(double) * n);
+    newton_matrix[i] = (double *)malloc(sizeof(double) * n);
+  }
+  p = (int *)malloc(sizeof(int) * n);
+  y = (double *)malloc(sizeof(double) * n);
+  e = (double *)malloc(sizeof(double) * n);
+  eprev = (double *)malloc(sizeof(double) * n);
+  ewt = (double *)malloc(sizeof(double) * n);
+  yc = (double *)malloc(sizeof(double) * n);
+  fc = (double *)malloc(sizeof(double) * n);
+  dl = (double *)malloc(sizeof(double) * n);
+  yout = (double *)malloc(sizeof(double) * n);
+
+  /* events are located on the Nordsieck interpolant */
+  hmax = tend;
+  dense.z = z;
+  dense.n = n;
+  out_eps = 1.0e-10*out_interval;
+
+  /* t = 0 */
+  ode_system_calc_discontinuity(sys);
+  ode_system_get_state(sys, y);
+  if(ode_system_commit(sys, t, y)){
+    ode_system_print_result(sys, result, row++, print_amount);
+  }else{
+    rtn = NULL;
+  }
+
+  h = 0;
+  while(rtn != NULL && row < num_of_rows){
+    if(h == 0){
+      /* (re)start with the 1st order method */
+      if(!ode_system_rhs(sys, t, y, fc)){
+        TRACE(("the state can not be set at t = %g\n", t));
+        rtn = NULL;
+        break;
+      }
+      ode_system_error_weights(n, y, atol, rtol, ewt);
+      d0 = ode_system_wrms_norm(n, y, ewt);
+      d1 = ode_system_wrms_norm(n, fc, ewt);
+      if(d0 > 1.0e-5 && d1 > 1.0e-5){
+        h = 0.01*d0/d1;
+      }else if(n == 0){
+        h = hmax;
+      }else{
+        h = 1.0e-6*my_fmax(out_interval, 1.0e-3);
+      }
+      if(h > hmax){
+        h = hmax;
+      }
+      if(t + h > tend){
+        h = tend - t;
+      }
+      q = 1;
+      for(i=0; i<n; i++){
+        z[0][i] = y[i];
+        z[1][i] = h*fc[i];
+      }
+      nsince = 0;
+      nfail = 0;
+      has_eprev = false;
+      jac_age = BDF_MAX_JACOBIAN_AGE;
+      lu_is_valid = 0;
+    }
+    /* step size limit (maximum step and end of simulation) */
+    eta = 1.0;
+    if(h*eta > hmax){
+      eta = hmax/h;
+    }
+    if(t + h*eta > tend){
+      eta = (tend - t)/h;
+    }
+    if(eta < 1.0){
+      bdf_rescale(z, q, n, eta);
+      h *= eta;
+      if(has_eprev){
+        for(i=0; i<n; i++){
+          eprev[i] *= pow(eta, q+1);
+        }
+      }
+    }
+    if(h < 100*DBL_EPSILON*my_fmax(fabs(t), out_interval)){
+      TRACE(("step size too small at t = %g\n", t));
+      rtn = NULL;
+      break;
+    }
+
+    /* predict */
+    bdf_predict(z, q, n);
+    bdf_coefficients(q, l);
+    gamma = h/l[1];
+    tq = (q+1)*l[1] + 1;
+    tn = t + h;
+    ode_system_error_weights(n, z[0], atol, rtol, ewt);
+
+    /* correct by simplified newton method */
+    converged = false;
+    tries = 0;
+    while(1){
+      if(jac_age >= BDF_MAX_JACOBIAN_AGE){
+        if(!ode_system_rhs(sys, tn, z[0], fc)
+            || !ode_system_jacobian(sys, tn, z[0], fc, ewt, jacobian)){
+          /* f can not be evaluated at the predicted point */
+          break;
+        }
+        jac_age = 0;
+        lu_is_valid = 0;
+      }
+      if(!lu_is_valid || fabs(gamma/gamma_lu - 1.0) > 0.3){
+        for(i=0; i<n; i++){
+          for(j=0; j<n; j++){
+            newton_matrix[i][j] = -gamma*jacobian[i][j];
+          }
+          newton_matrix[i][i] += 1.0;
+          p[i] = i;
+        }
+        sys->num_of_lu_decompositions++;
+        gamma_lu = gamma;
+        lu_is_valid = lu_decomposition(newton_matrix, p, n);
+        if(!lu_is_valid){
+          break;
+        }
+      }
+      for(i=0; i<n; i++){
+        e[i] = 0;
+        yc[i] = z[0][i];
+      }
+      crate = 1.0;
+      delp = 0;
+      for(k=0; k<BDF_MAX_NEWTON_ITERATIONS; k++){
+        if(!ode_system_rhs(sys, tn, yc, fc)){
+          break;
+        }
+        for(i=0; i<n; i++){
+          dl[i] = -(e[i] - gamma*fc[i] + z[1][i]/l[1]);
+        }
+        lu_solve(newton_matrix, p, n, dl);
+        if(gamma != gamma_lu){
+          for(i=0; i<n; i++){
+            dl[i] *= 2.0/(1.0 + gamma/gamma_lu);
+          }
+        }
+        for(i=0; i<n; i++){
+          e[i] += dl[i];
+          yc[i] = z[0][i] + e[i];
+        }
+        del = ode_system_wrms_norm(n, dl, ewt);
+        if(k > 0){
+          crate = my_fmax(0.2*crate, del/delp);
+        }
+        dcon = del*my_fmin(1.0, 1.5*crate)/tq;
+        if(dcon <= 0.5/(q+2)){
+          converged = true;
+          break;
+        }
+        if(k > 0 && del > 2*delp){
+          break;
+        }
+        delp = del;
+      }
+      if(converged){
+        break;
+      }
+      tries++;
+      if(tries <= 1 && jac_age > 0){
+        /* retry with a new jacobian */
+        jac_age = BDF_MAX_JACOBIAN_AGE;
+        continue;
+      }
+      break;
+    }
+
+    if(!converged){
+      /* reduce the step size and retry */
+      bdf_restore(z, q, n);
+      eta = 0.25;
+      bdf_rescale(z, q, n, eta);
+      h *= eta;
+      has_eprev = false;
+      nsince = 0;
+      jac_age = BDF_MAX_JACOBIAN_AGE;
+      sys->num_of_rejected_steps++;
+      continue;
+    }
+    jac_age++;
+
+    /* local error test */
+    err = ode_system_wrms_norm(n, e, ewt)/tq;
+    if(err > 1.0){
+      bdf_restore(z, q, n);
+      sys->num_of_rejected_steps++;
+      nfail++;
+      eta = my_fmax(BDF_MIN_STEP_RATIO, 0.9/pow(1.2*err, 1.0/(q+1)));
+      if(nfail >= BDF_MAX_ERROR_FAILURES && q > 1){
+        q = 1;
+        eta = my_fmax(eta, 0.1);
+      }
+      bdf_rescale(z, q, n, eta);
+      h *= eta;
+      has_eprev = false;
+      nsince = 0;
+      continue;
+    }
+    nfail = 0;
+
+    /* accept */
+    for(j=0; j<=(unsigned int)q; j++){
+      for(i=0; i<n; i++){
+        z[j][i] += l[j]*e[i];
+      }
+    }
+    sys->num_of_steps++;
+    nsince++;
+
+    /* truncate the step at the first event */
+    dense.q = q;
+    dense.t = tn;
+    dense.h = h;
+    te = tn;
+    has_event = ode_system_locate_event(sys, t, tn, bdf_dense_interpolate, &dense, &te, y);
+    if(has_event < 0){
+      TRACE(("the state can not be set in the step from t = %g\n", t));
+      rtn = NULL;
+      break;
+    }
+    if(!has_event){
+      for(i=0; i<n; i++){
+        y[i] = z[0][i];
+      }
+    }
+
+    /* print result (Nordsieck interpolation) */
+    while(row < num_of_rows && row*out_interval < te - out_eps){
+      bdf_interpolate(z, q, n, (row*out_interval - tn)/h, yout);
+      if(!ode_system_set_state(sys, row*out_interval, yout)){
+        rtn = NULL;
+        break;
+      }
+      ode_system_print_result(sys, result, row++, print_amount);
+    }
+    t = te;
+    if(rtn == NULL || !ode_system_commit(sys, t, y)){
+      TRACE(("the state can not be set at t = %g\n", t));
+      rtn = NULL;
+      break;
+    }
+
+    /* fast reactions and events */
+    if(ode_system_calc_discontinuity(sys) || has_event){
+      /* restart with the 1st order method */
+      ode_system_get_state(sys, y);
+      h = 0;
+    }
+    while(row < num_of_rows && row*out_interval <= t + out_eps){
+      *time = row*out_interval;
+      ode_system_print_result(sys, result, row++, print_amount);
+    }
+    *time = t;
+    if(h == 0){
+      continue;
+    }
+
+    /* step size and order selection */
+    if(nsince >= q+1){
+      eta_q = 1.0/(pow(1.2*err, 1.0/(q+1)) + 1.0e-6);
+      eta_dn = 0;
+      eta_up = 0;
+      if(q > 1){
+        bdf_coefficients(q-1, lm);
+        errdn = ode_system_wrms_norm(n, z[q], ewt)*bdf_factorial(q-1)/lm[1];
+        eta_dn = 1.0/(pow(1.3*errdn, 1.0/q) + 1.0e-6);
+      }
+      if(q < BDF_MAX_ORDER && has_eprev){
+        bdf_coefficients(q+1, lp);
+        for(i=0; i<n; i++){
+          dl[i] = e[i] - eprev[i];
+        }
+        errup = ode_system_wrms_norm(n, dl, ewt)/((q+2)*lp[1]*(1.0 + 1.0/((q+1)*l[1])));
+        eta_up = 1.0/(pow(1.4*errup, 1.0/(q+2)) + 1.0e-6);
+      }
+      eta = eta_q;
+      newq = q;
+      if(eta_dn > eta){
+        eta = eta_dn;
+        newq = q-1;
+      }
+      if(eta_up > eta){
+        eta = eta_up;
+        newq = q+1;
+      }
+      if(eta >= 1.5){
+        if(eta > BDF_MAX_STEP_RATIO){
+          eta = BDF_MAX_STEP_RATIO;
+        }
+        if(newq == q+1){
+          for(i=0; i<n; i++){
+            z[q+1][i] = e[i]*l[q]/(q+1);
+          }
+        }
+        q = newq;
+        bdf_rescale(z, q, n, eta);
+        h *= eta;
+        has_eprev = false;
+        nsince = 0;
+        continue;
+      }
+    }
+    for(i=0; i<n; i++){
+      eprev[i] = e[i];
+    }
+    has_eprev = true;
+  }
+
+  TRACE(("BDF: %u steps, %u rejected, %u f evaluations, %u jacobians, %u LU decompositions\n", sys->num_of_steps, sys->num_of_rejected_steps, sys->num_of_rhs_evaluations, sys->num_of_jacobian_evaluations, sys->num_of_lu_decompositions));
+  ode_system_store_statistics(sys, result);
+  PRG_TRACE(("Simulation for [%s] Ends!\n", Model_getId(m)));
+
+  for(k=0; k<BDF_MAX_ORDER+2; k++){
+    free(z[k]);
+  }
+  free(z);
+  for(i=0; i<n; i++){
+    free(jacobian[i]);
+    free(newton_matrix[i]);
+  }
+  free(jacobian);
+  free(newton_matrix);
+  free(p);
+  free(y);
+  free(e);
+  free(eprev);
+  free(ewt);
+  free(yc);
+  free(fc);
+  free(dl);
+  free(yout);
+  ode_system_free(sys);
+  return rtn;
+}
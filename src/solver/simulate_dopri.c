@@ -0,0 +1,343 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "../libsbmlsim/libsbmlsim.h"
+
+/* Dormand-Prince 5(4) with FSAL and 4th order continuous extension,
+ * after DOPRI5 by Hairer and Wanner. */
+
+#define DOPRI_SAFETY 0.9
+#define DOPRI_MIN_STEP_RATIO 0.2
+#define DOPRI_BETA 0.04
+
+/* Butcher tableau */
+static const double dp_c[7] = {0.0, 1.0/5.0, 3.0/10.0, 4.0/5.0, 8.0/9.0, 1.0, 1.0};
+static const double dp_a[7][6] = {
+  {0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+  {1.0/5.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+  {3.0/40.0, 9.0/40.0, 0.0, 0.0, 0.0, 0.0},
+  {44.0/45.0, -56.0/15.0, 32.0/9.0, 0.0, 0.0, 0.0},
+  {19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0, 0.0, 0.0},
+  {9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0, 0.0},
+  {35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0}};
+/* difference between 5th and 4th order solution */
+static const double dp_e[7] = {71.0/57600.0, 0.0, -71.0/16695.0, 71.0/1920.0, -17253.0/339200.0, 22.0/525.0, -1.0/40.0};
+/* dense output */
+static const double dp_d[7] = {-12715105075.0/11282082432.0, 0.0, 87487479700.0/32700410799.0, -10690763975.0/1880347072.0, 701980252875.0/199316789632.0, -1453857185.0/822651844.0, 69997945.0/29380423.0};
+
+/* y(t_old + theta*h) from the coefficients of continuous extension */
+void dopri_interpolate(double **r, unsigned int n, double theta, double *y){
+  unsigned int i;
+  double theta1 = 1.0 - theta;
+  for(i=0; i<n; i++){
+    y[i] = r[0][i] + theta*(r[1][i] + theta1*(r[2][i] + theta*(r[3][i] + theta1*r[4][i])));
+  }
+}
+
+void dopri_dense_interpolate(void *data, double t, double *y){
+  dopri_dense *d = (dopri_dense *)data;
+  dopri_interpolate(d->r, d->n, (t - d->t0)/d->h, y);
+}
+
+static double dopri_error_norm(unsigned int n, const double *err, const double *y0, const double *y1, double atol, double rtol){
+  unsigned int i;
+  double sk, sum = 0;
+  if(n == 0){
+    return 0;
+  }
+  for(i=0; i<n; i++){
+    sk = atol + rtol*my_fmax(fabs(y0[i]), fabs(y1[i]));
+    sum += (err[i]/sk)*(err[i]/sk);
+  }
+  return sqrt(sum/n);
+}
+
+double dopri_step(ode_system *sys, double t, double h, const double *y, double **k, double *ynew, double *ystage, double *yerr, double atol, double rtol){
+  unsigned int i;
+  int s, j;
+  unsigned int n = sys->num_of_vars;
+  double *yout;
+
+  /* stages (k[0] is the last stage of the previous step) */
+  for(s=1; s<7; s++){
+    /* ystage is left as the argument of k[5] for dopri_stiffness() */
+    yout = (s == 6) ? ynew : ystage;
+    for(i=0; i<n; i++){
+      yout[i] = y[i];
+      for(j=0; j<s; j++){
+        yout[i] += h*dp_a[s][j]*k[j][i];
+      }
+    }
+    if(!ode_system_rhs(sys, t + dp_c[s]*h, yout, k[s])){
+      return -1;
+    }
+  }
+  for(i=0; i<n; i++){
+    yerr[i] = 0;
+    for(s=0; s<7; s++){
+      yerr[i] += h*dp_e[s]*k[s][i];
+    }
+  }
+  return dopri_error_norm(n, yerr, y, ynew, atol, rtol);
+}
+
+void dopri_dense_output(unsigned int n, double h, const double *y, const double *ynew, double **k, double **r){
+  unsigned int i;
+  int s;
+  for(i=0; i<n; i++){
+    r[0][i] = y[i];
+    r[1][i] = ynew[i] - y[i];
+    r[2][i] = h*k[0][i] - r[1][i];
+    r[3][i] = r[1][i] - h*k[6][i] - r[2][i];
+    r[4][i] = 0;
+    for(s=0; s<7; s++){
+      r[4][i] += h*dp_d[s]*k[s][i];
+    }
+  }
+}
+
+double dopri_stiffness(unsigned int n, double h, double **k, const double *ynew, const double *ystage){
+  unsigned int i;
+  double num = 0, den = 0;
+  for(i=0; i<n; i++){
+    num += (k[6][i] - k[5][i])*(k[6][i] - k[5][i]);
+    den += (ynew[i] - ystage[i])*(ynew[i] - ystage[i]);
+  }
+  if(den <= 0){
+    return 0;
+  }
+  return h*sqrt(num/den);
+}
+
+myResult* simulate_dopri(Model_t *m, myResult *result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int print_amount, allocated_memory *mem, sbmlsim_context *ctx, double atol, double rtol, double facmax){
+  unsigned int i;
+  int s;
+  ode_system *sys;
+  unsigned int n;
+  myResult *rtn = result;
+  /* output */
+  int row = 0;
+  int num_of_rows = result->num_of_rows;
+  double out_interval = print_interval*dt;
+  double out_eps;
+  double tend = (num_of_rows-1)*out_interval;
+  /* step */
+  double t = 0, te;
+  double h = 0, hmax;
+  double h0, h1, d0, d1, d2;
+  double err, fac, fac11;
+  double facold = 1.0e-4;
+  boolean last_rejected = false;
+  boolean need_k1 = true;
+  int has_event;
+  dopri_dense dense;
+  /* arrays */
+  double *k[7];
+  double *r[5]; /* continuous extension */
+  double *y, *ynew, *ytmp, *yerr, *ewt;
+
+  PRG_TRACE(("Simulation for [%s] Starts!\n", Model_getId(m)));
+
+  sys = ode_system_create(m, sp, param, comp, re, rule, event, algEq, time, dt, ctx);
+  n = sys->num_of_vars;
+  if(!ode_system_initialize(sys, initAssign, timeVarAssign, sim_time, mem)){
+    ode_system_free(sys);
+    return NULL;
+  }
+
+  for(s=0; s<7; s++){
+    k[s] = (double *)malloc(sizeof(double) * n);
+  }
+  for(s=0; s<5; s++){
+    r[s] = (double *)malloc(sizeof(double) * n);
+  }
+  y = (double *)malloc(sizeof(double) * n);
+  ynew = (double *)malloc(sizeof(double) * n);
+  ytmp = (double *)malloc(sizeof(double) * n);
+  yerr = (double *)malloc(sizeof(double) * n);
+  ewt = (double *)malloc(sizeof(double) * n);
+
+  /* events are located on the continuous extension */
+  hmax = tend;
+  dense.n = n;
+  dense.r = r;
+  out_eps = 1.0e-10*out_interval;
+
+  /* t = 0 */
+  ode_system_calc_discontinuity(sys);
+  ode_system_get_state(sys, y);
+  if(ode_system_commit(sys, t, y)){
+    ode_system_print_result(sys, result, row++, print_amount);
+  }else{
+    rtn = NULL;
+  }
+
+  while(rtn != NULL && row < num_of_rows){
+    if(need_k1){
+      if(!ode_system_rhs(sys, t, y, k[0])){
+        TRACE(("the state can not be set at t = %g\n", t));
+        rtn = NULL;
+        break;
+      }
+      need_k1 = false;
+      h = 0;
+    }
+    if(h == 0){
+      /* initial step size (Hairer, Norsett and Wanner, II.4) */
+      ode_system_error_weights(n, y, atol, rtol, ewt);
+      d0 = ode_system_wrms_norm(n, y, ewt);
+      d1 = ode_system_wrms_norm(n, k[0], ewt);
+      if(d0 > 1.0e-5 && d1 > 1.0e-5){
+        h0 = 0.01*d0/d1;
+      }else{
+        h0 = 1.0e-6*my_fmax(out_interval, 1.0e-3);
+      }
+      h0 = my_fmin(h0, hmax);
+      for(i=0; i<n; i++){
+        ytmp[i] = y[i] + h0*k[0][i];
+      }
+      if(ode_system_rhs(sys, t + h0, ytmp, k[1])){
+        for(i=0; i<n; i++){
+          yerr[i] = (k[1][i] - k[0][i])/h0;
+        }
+        d2 = ode_system_wrms_norm(n, yerr, ewt);
+      }else{
+        /* f can not be evaluated at the trial point, start with a small step */
+        d2 = 0;
+        d1 = 0;
+      }
+      if(my_fmax(d1, d2) <= 1.0e-15){
+        h1 = my_fmax(1.0e-6, h0*1.0e-3);
+      }else{
+        h1 = pow(0.01/my_fmax(d1, d2), 1.0/5.0);
+      }
+      h = my_fmin(100*h0, h1);
+      if(n == 0){
+        h = hmax;
+      }
+      facold = 1.0e-4;
+      last_rejected = false;
+    }
+    if(h > hmax){
+      h = hmax;
+    }
+    if(t + h > tend){
+      h = tend - t;
+    }
+    if(h < 100*DBL_EPSILON*my_fmax(fabs(t), out_interval)){
+      TRACE(("step size too small at t = %g\n", t));
+      rtn = NULL;
+      break;
+    }
+
+    err = dopri_step(sys, t, h, y, k, ynew, ytmp, yerr, atol, rtol);
+    if(err < 0){
+      /* f can not be evaluated in the step */
+      sys->num_of_rejected_steps++;
+      h *= 0.5;
+      last_rejected = true;
+      continue;
+    }
+
+    /* step size control with Lund-stabilization */
+    fac11 = pow(err, 0.2 - DOPRI_BETA*0.75);
+    fac = fac11/pow(facold, DOPRI_BETA);
+    fac = my_fmax(1.0/facmax, my_fmin(1.0/DOPRI_MIN_STEP_RATIO, fac/DOPRI_SAFETY));
+    if(err > 1.0){
+      /* reject */
+      sys->num_of_rejected_steps++;
+      h /= my_fmin(1.0/DOPRI_MIN_STEP_RATIO, fac11/DOPRI_SAFETY);
+      last_rejected = true;
+      continue;
+    }
+
+    /* accept */
+    sys->num_of_steps++;
+    facold = my_fmax(err, 1.0e-4);
+    dopri_dense_output(n, h, y, ynew, k, r);
+    dense.t0 = t;
+    dense.h = h;
+
+    /* truncate the step at the first event */
+    te = t + h;
+    has_event = ode_system_locate_event(sys, t, t + h, dopri_dense_interpolate, &dense, &te, ytmp);
+    if(has_event < 0){
+      TRACE(("the state can not be set in the step from t = %g\n", t));
+      rtn = NULL;
+      break;
+    }
+    if(has_event){
+      for(i=0; i<n; i++){
+        ynew[i] = ytmp[i];
+      }
+    }
+
+    /* print result (continuous extension) */
+    while(row < num_of_rows && row*out_interval < te - out_eps){
+      dopri_interpolate(r, n, (row*out_interval - t)/h, ytmp);
+      if(!ode_system_set_state(sys, row*out_interval, ytmp)){
+        rtn = NULL;
+        break;
+      }
+      ode_system_print_result(sys, result, row++, print_amount);
+    }
+    t = te;
+    for(i=0; i<n; i++){
+      y[i] = ynew[i];
+      k[0][i] = k[6][i]; /* first same as last */
+    }
+    if(rtn == NULL || !ode_system_commit(sys, t, y)){
+      TRACE(("the state can not be set at t = %g\n", t));
+      rtn = NULL;
+      break;
+    }
+
+    /* fast reactions and events */
+    if(ode_system_calc_discontinuity(sys) || has_event){
+      /* restart, since k[6] is not f(t, y) after the event */
+      ode_system_get_state(sys, y);
+      need_k1 = true;
+    }
+    while(row < num_of_rows && row*out_interval <= t + out_eps){
+      *time = row*out_interval;
+      ode_system_print_result(sys, result, row++, print_amount);
+    }
+    *time = t;
+
+    /* next step size */
+    if(last_rejected){
+      h = my_fmin(h, h/fac);
+    }else{
+      h = h/fac;
+    }
+    last_rejected = false;
+  }
+
+  TRACE(("Dormand-Prince: %u steps, %u rejected, %u f evaluations\n", sys->num_of_steps, sys->num_of_rejected_steps, sys->num_of_rhs_evaluations));
+  ode_system_store_statistics(sys, result);
+  PRG_TRACE(("Simulation for [%s] Ends!\n", Model_getId(m)));
+
+  for(s=0; s<7; s++){
+    free(k[s]);
+  }
+  for(s=0; s<5; s++){
+    free(r[s]);
+  }
+  free(y);
+  free(ynew);
+  free(ytmp);
+  free(yerr);
+  free(ewt);
+  ode_system_free(sys);
+  return rtn;
+}
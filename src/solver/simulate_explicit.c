@@ -15,7 +15,7 @@
 #include "../libsbmlsim/libsbmlsim.h"
 
 /* coefficient matrix for Adams Bashforth */
-double c_e[4][4] = {{1.0, 0, 0, 0}, /* AB1 (Euler) : order = 0 */
+static const double c_e[4][4] = {{1.0, 0, 0, 0}, /* AB1 (Euler) : order = 0 */
   {3.0/2.0, -1.0/2.0, 0, 0}, /* AB2 : order = 1 */
   {23.0/12.0, -16.0/12.0, 5.0/12.0, 0}, /* AB3 : order = 2 */
   {55.0/24.0, -59.0/24.0, 37.0/24.0, -9.0/24.0}}; /* AB4 : order = 3 */
@@ -24,7 +24,7 @@ double calc_explicit_formula(int order, double k1, double k2, double k3, double
   return c_e[order][0]*k1 + c_e[order][1]*k2 + c_e[order][2]*k3 + c_e[order][3]*k4;
 }
 
-myResult* simulate_explicit(Model_t *m, myResult* result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int order, int print_amount, allocated_memory *mem){
+myResult* simulate_explicit(Model_t *m, myResult* result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int order, int print_amount, allocated_memory *mem, sbmlsim_context *ctx){
   unsigned int i, j;
   int cycle;
   int error;
@@ -70,7 +70,6 @@ myResult* simulate_explicit(Model_t *m, myResult* result, mySpecies *sp[], myPar
   myCompartment **var_comp;
   mySpeciesReference **var_spr;
 
-  set_seed();
 
   check_num(num_of_species, num_of_parameters, num_of_compartments, num_of_reactions, &num_of_all_var_species, &num_of_all_var_parameters, &num_of_all_var_compartments, &num_of_all_var_species_reference, &num_of_var_species, &num_of_var_parameters, &num_of_var_compartments, &num_of_var_species_reference, sp, param, comp, re);
 
@@ -321,7 +320,7 @@ myResult* simulate_explicit(Model_t *m, myResult* result, mySpecies *sp[], myPar
     }
 
     /* event */
-    calc_event(event, num_of_events, dt, *time, cycle, &reverse_time);
+    calc_event(event, num_of_events, dt, *time, cycle, &reverse_time, ctx);
 
     /* substitute delay val */
     substitute_delay_val(sp, num_of_species, param, num_of_parameters, comp, num_of_compartments, re, num_of_reactions, cycle);
@@ -370,11 +369,11 @@ myResult* simulate_explicit(Model_t *m, myResult* result, mySpecies *sp[], myPar
     *time = (cycle+1)*dt;
 
     if(order == 4){/* runge kutta       */
-      calc_k(all_var_sp, num_of_all_var_species, all_var_param, num_of_all_var_parameters, all_var_comp, num_of_all_var_compartments, all_var_spr, num_of_all_var_species_reference, re, num_of_reactions, rule, num_of_rules, cycle, dt, &reverse_time, 1, 1);
+      calc_k(all_var_sp, num_of_all_var_species, all_var_param, num_of_all_var_parameters, all_var_comp, num_of_all_var_compartments, all_var_spr, num_of_all_var_species_reference, re, num_of_reactions, rule, num_of_rules, cycle, dt, &reverse_time, 1, 1, ctx);
       calc_temp_value(all_var_sp, num_of_all_var_species, all_var_param, num_of_all_var_parameters, all_var_comp, num_of_all_var_compartments, all_var_spr, num_of_all_var_species_reference, dt, 1);      
     } else {/* Adams-Bashforth */
       /* calc k */
-      calc_k(var_sp, num_of_var_species, var_param, num_of_var_parameters, var_comp, num_of_var_compartments, var_spr, num_of_var_species_reference, re, num_of_reactions, rule, num_of_rules, cycle, dt, &reverse_time, 0, 1);      
+      calc_k(var_sp, num_of_var_species, var_param, num_of_var_parameters, var_comp, num_of_var_compartments, var_spr, num_of_var_species_reference, re, num_of_reactions, rule, num_of_rules, cycle, dt, &reverse_time, 0, 1, ctx);      
       /* calc temp value by Adams Bashforth */
       for(i=0; i<num_of_var_species; i++){
         var_sp[i]->temp_value = var_sp[i]->value + calc_explicit_formula(order, var_sp[i]->k[0], var_sp[i]->prev_k[0], var_sp[i]->prev_k[1], var_sp[i]->prev_k[2])*dt;
@@ -527,7 +526,7 @@ myResult* simulate_explicit(Model_t *m, myResult* result, mySpecies *sp[], myPar
   return result;
 }
 
-myResult* simulate_explicitf(Model_t *m, myResult* result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int order, int print_amount, allocated_memory *mem, double atol, double rtol, double facmax, copied_AST *cp_AST, int* err_zero_flag){
+myResult* simulate_explicitf(Model_t *m, myResult* result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int order, int print_amount, allocated_memory *mem, sbmlsim_context *ctx, double atol, double rtol, double facmax, copied_AST *cp_AST, int* err_zero_flag){
   unsigned int i, j;
   int cycle;
   int error;
@@ -604,7 +603,6 @@ myResult* simulate_explicitf(Model_t *m, myResult* result, mySpecies *sp[], myPa
 	  *(ode_check + i) = 0;
   }
 
-  set_seed();
 
   check_num(num_of_species, num_of_parameters, num_of_compartments, num_of_reactions, &num_of_all_var_species, &num_of_all_var_parameters, &num_of_all_var_compartments, &num_of_all_var_species_reference, &num_of_var_species, &num_of_var_parameters, &num_of_var_compartments, &num_of_var_species_reference, sp, param, comp, re);
 
@@ -931,7 +929,7 @@ myResult* simulate_explicitf(Model_t *m, myResult* result, mySpecies *sp[], myPa
 	  }
 
 	  /* event */
-	  calc_eventf(event, num_of_events, dt, *time, cycle, &reverse_time, result, print_interval, err_zero_flag);
+	  calc_eventf(event, num_of_events, dt, *time, cycle, &reverse_time, result, print_interval, err_zero_flag, ctx);
 
 	  /* substitute delay val */
 	  substitute_delay_valf(sp, num_of_species, param, num_of_parameters, comp, num_of_compartments, re, num_of_reactions, cycle);
@@ -15,7 +15,7 @@
 #include "../libsbmlsim/libsbmlsim.h"
 
 /* coefficient matrix for implicit numerical integration */
-int c_i[7][9] = {{1, -1, 0, 0, 0, -1, 0, 0, 0}, /* AM1 & AM2 (Backward-Euler) : orcer = 0 */
+static const int c_i[7][9] = {{1, -1, 0, 0, 0, -1, 0, 0, 0}, /* AM1 & AM2 (Backward-Euler) : orcer = 0 */
   {2, -2, 0, 0, 0, -1, -1, 0, 0}, /* AM2 (Crank-Nicolson) : order = 1 */
   {12, -12, 0, 0, 0, -5, -8, 1, 0}, /* AM3 : order = 2 */
   {24, -24, 0, 0, 0, -9, -19, 5, -1}, /* AM4 : order = 3 */
@@ -29,11 +29,7 @@ double calc_implicit_formula(int order, double x1, double x2, double x3, double
   return c_i[order][0]*x1 + c_i[order][1]*x2 + c_i[order][2]*x3 + c_i[order][3]*x4 + c_i[order][4]*x5 + dt*(c_i[order][5]*k1 + c_i[order][6]*k2 + c_i[order][7]*k3 + c_i[order][8]*k4);
 }
 
-/* void seed_set_imp(){
-  srand((unsigned)time(NULL));
-} */
-
-myResult* simulate_implicit(Model_t *m, myResult *result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int order, int use_lazy_method, int print_amount, allocated_memory *mem){
+myResult* simulate_implicit(Model_t *m, myResult *result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int order, int use_lazy_method, int print_amount, allocated_memory *mem, sbmlsim_context *ctx){
   unsigned int i, j;
   int cycle;
   int error;
@@ -62,6 +58,8 @@ myResult* simulate_implicit(Model_t *m, myResult *result, mySpecies *sp[], myPar
   double *delta_value;
   double k_next; /* speculated k value : k(t+1) */
   double *k_t;   /* k(t) */
+  double saved_value; /* value of the variable perturbed for the jacobian */
+  parallel_jacobian *jac; /* columns of the jacobian by threads, or NULL */
 
   /* num of SBase objects */
   unsigned int num_of_species = Model_getNumSpecies(m);
@@ -94,7 +92,6 @@ myResult* simulate_implicit(Model_t *m, myResult *result, mySpecies *sp[], myPar
   myCompartment **var_comp;
   mySpeciesReference **var_spr;
 
-  set_seed();
 
   check_num(num_of_species, num_of_parameters, num_of_compartments, num_of_reactions, &num_of_all_var_species, &num_of_all_var_parameters, &num_of_all_var_compartments, &num_of_all_var_species_reference, &num_of_var_species, &num_of_var_parameters, &num_of_var_compartments, &num_of_var_species_reference, sp, param, comp, re);
 
@@ -121,6 +118,8 @@ myResult* simulate_implicit(Model_t *m, myResult *result, mySpecies *sp[], myPar
   sum_num_of_vars = num_of_var_species + num_of_var_parameters +
                     num_of_var_compartments + num_of_var_species_reference;
 
+  jac = parallel_jacobian_create(ctx, m, sp, param, comp, re, rule, event, time, dt);
+
   jacobian = (double**)malloc(sizeof(double*)*(sum_num_of_vars));
   for(i=0; i<sum_num_of_vars; i++){
     jacobian[i] = (double*)malloc(sizeof(double)*(sum_num_of_vars));
@@ -366,7 +365,7 @@ myResult* simulate_implicit(Model_t *m, myResult *result, mySpecies *sp[], myPar
     }
 
     /* event */
-    calc_event(event, num_of_events, dt, *time, cycle, &reverse_time);    
+    calc_event(event, num_of_events, dt, *time, cycle, &reverse_time, ctx);    
 
     /* substitute delay val */
     substitute_delay_val(sp, num_of_species, param, num_of_parameters, comp, num_of_compartments, re, num_of_reactions, cycle);
@@ -422,7 +421,7 @@ myResult* simulate_implicit(Model_t *m, myResult *result, mySpecies *sp[], myPar
 
     /* implicit method */
     /* define init value by Euler start */
-    calc_k(all_var_sp, num_of_all_var_species, all_var_param, num_of_all_var_parameters, all_var_comp, num_of_all_var_compartments, all_var_spr, num_of_all_var_species_reference, re, num_of_reactions, rule, num_of_rules, cycle, dt, &reverse_time, 0, 1);
+    calc_k(all_var_sp, num_of_all_var_species, all_var_param, num_of_all_var_parameters, all_var_comp, num_of_all_var_compartments, all_var_spr, num_of_all_var_species_reference, re, num_of_reactions, rule, num_of_rules, cycle, dt, &reverse_time, 0, 1, ctx);
 
     /* preserve k(t) value */
     for(i=0; i<sum_num_of_vars; i++){
@@ -450,7 +449,7 @@ myResult* simulate_implicit(Model_t *m, myResult *result, mySpecies *sp[], myPar
     flag = 1;
     while(flag){
       /* calc b */
-      calc_k(var_sp, num_of_var_species, var_param, num_of_var_parameters, var_comp, num_of_var_compartments, var_spr, num_of_var_species_reference, re, num_of_reactions, rule, num_of_rules, cycle, dt, &reverse_time, 0, 0);
+      calc_k(var_sp, num_of_var_species, var_param, num_of_var_parameters, var_comp, num_of_var_compartments, var_spr, num_of_var_species_reference, re, num_of_reactions, rule, num_of_rules, cycle, dt, &reverse_time, 0, 0, ctx);
       for(i=0; i<num_of_var_species; i++){
         k_next = var_sp[i]->k[0];
         b[i] = calc_implicit_formula(order, var_sp[i]->temp_value, var_sp[i]->value, var_sp[i]->prev_val[0], var_sp[i]->prev_val[1], var_sp[i]->prev_val[2], k_next, k_t[i], var_sp[i]->prev_k[0], var_sp[i]->prev_k[1], dt);
@@ -467,46 +466,55 @@ myResult* simulate_implicit(Model_t *m, myResult *result, mySpecies *sp[], myPar
 
       if(!use_lazy_method || !is_convergence){
         /* calc jacobian by numerical differentiation */
-        for(loop=0; loop<sum_num_of_vars; loop++){
-          if(loop < num_of_var_species){
-            var_sp[loop]->temp_value += delta;
-          }else if(loop < num_of_var_species+num_of_var_parameters){
-            var_param[loop-num_of_var_species]->temp_value += delta;
-          }else if(loop < num_of_var_species+num_of_var_parameters+num_of_var_compartments){
-            var_comp[loop-num_of_var_species-num_of_var_parameters]->temp_value += delta;
-          }else{
-            var_spr[loop-num_of_var_species-num_of_var_parameters-num_of_var_compartments]->temp_value += delta;
-          }
-          calc_k(var_sp, num_of_var_species, var_param, num_of_var_parameters, var_comp, num_of_var_compartments, var_spr, num_of_var_species_reference, re, num_of_reactions, rule, num_of_rules, cycle, dt, &reverse_time, 0, 0);
-          for(i=0; i<num_of_var_species; i++){
-            k_next = var_sp[i]->k[0];
-            delta_value[i] = calc_implicit_formula(order, var_sp[i]->temp_value, var_sp[i]->value, var_sp[i]->prev_val[0], var_sp[i]->prev_val[1], var_sp[i]->prev_val[2], k_next, k_t[i], var_sp[i]->prev_k[0], var_sp[i]->prev_k[1], dt);
-            /* numerical differentiation */
-            jacobian[i][loop] = (delta_value[i]-b[i])/delta;
-          }
-          for(i=0; i<num_of_var_parameters; i++){
-            delta_value[num_of_var_species+i] = calc_implicit_formula(order, var_param[i]->temp_value, var_param[i]->value, var_param[i]->prev_val[0], var_param[i]->prev_val[1], var_param[i]->prev_val[2], var_param[i]->k[0], k_t[num_of_var_species+i], var_param[i]->prev_k[0], var_param[i]->prev_k[1], dt);
-            /* numerical differentiation */
-            jacobian[num_of_var_species+i][loop] = (delta_value[num_of_var_species+i]-b[num_of_var_species+i])/delta;
-          }
-          for(i=0; i<num_of_var_compartments; i++){
-            delta_value[num_of_var_species+num_of_var_parameters+i] = calc_implicit_formula(order, var_comp[i]->temp_value, var_comp[i]->value, var_comp[i]->prev_val[0], var_comp[i]->prev_val[1], var_comp[i]->prev_val[2], var_comp[i]->k[0], k_t[num_of_var_species+num_of_var_parameters+i], var_comp[i]->prev_k[0], var_comp[i]->prev_k[1], dt);
-            /* numerical differentiation */
-            jacobian[num_of_var_species+num_of_var_parameters+i][loop] = (delta_value[num_of_var_species+num_of_var_parameters+i]-b[num_of_var_species+num_of_var_parameters+i])/delta;
-          }
-          for(i=0; i<num_of_var_species_reference; i++){
-            delta_value[num_of_var_species+num_of_var_parameters+num_of_var_compartments+i] = calc_implicit_formula(order, var_spr[i]->temp_value, var_spr[i]->value, var_spr[i]->prev_val[0], var_spr[i]->prev_val[1], var_spr[i]->prev_val[2], var_spr[i]->k[0], k_t[num_of_var_species+num_of_var_parameters+num_of_var_compartments+i], var_spr[i]->prev_k[0], var_spr[i]->prev_k[1], dt);
-            /* numerical differentiation */
-            jacobian[num_of_var_species+num_of_var_parameters+num_of_var_compartments+i][loop] = (delta_value[num_of_var_species+num_of_var_parameters+num_of_var_compartments+i]-b[num_of_var_species+num_of_var_parameters+num_of_var_compartments+i])/delta;
-          }
-          if(loop < num_of_var_species){
-            var_sp[loop]->temp_value -= delta;
-          }else if(loop < num_of_var_species+num_of_var_parameters){
-            var_param[loop-num_of_var_species]->temp_value -= delta;
-          }else if(loop < num_of_var_species+num_of_var_parameters+num_of_var_compartments){
-            var_comp[loop-num_of_var_species-num_of_var_parameters]->temp_value -= delta;
-          }else{
-            var_spr[loop-num_of_var_species-num_of_var_parameters-num_of_var_compartments]->temp_value -= delta;
+        if(jac != NULL){
+          parallel_jacobian_calc(jac, order, dt, cycle, reverse_time, delta, b, k_t, jacobian);
+        }else{
+          for(loop=0; loop<sum_num_of_vars; loop++){
+            if(loop < num_of_var_species){
+              saved_value = var_sp[loop]->temp_value;
+              var_sp[loop]->temp_value += delta;
+            }else if(loop < num_of_var_species+num_of_var_parameters){
+              saved_value = var_param[loop-num_of_var_species]->temp_value;
+              var_param[loop-num_of_var_species]->temp_value += delta;
+            }else if(loop < num_of_var_species+num_of_var_parameters+num_of_var_compartments){
+              saved_value = var_comp[loop-num_of_var_species-num_of_var_parameters]->temp_value;
+              var_comp[loop-num_of_var_species-num_of_var_parameters]->temp_value += delta;
+            }else{
+              saved_value = var_spr[loop-num_of_var_species-num_of_var_parameters-num_of_var_compartments]->temp_value;
+              var_spr[loop-num_of_var_species-num_of_var_parameters-num_of_var_compartments]->temp_value += delta;
+            }
+            calc_k(var_sp, num_of_var_species, var_param, num_of_var_parameters, var_comp, num_of_var_compartments, var_spr, num_of_var_species_reference, re, num_of_reactions, rule, num_of_rules, cycle, dt, &reverse_time, 0, 0, ctx);
+            for(i=0; i<num_of_var_species; i++){
+              k_next = var_sp[i]->k[0];
+              delta_value[i] = calc_implicit_formula(order, var_sp[i]->temp_value, var_sp[i]->value, var_sp[i]->prev_val[0], var_sp[i]->prev_val[1], var_sp[i]->prev_val[2], k_next, k_t[i], var_sp[i]->prev_k[0], var_sp[i]->prev_k[1], dt);
+              /* numerical differentiation */
+              jacobian[i][loop] = (delta_value[i]-b[i])/delta;
+            }
+            for(i=0; i<num_of_var_parameters; i++){
+              delta_value[num_of_var_species+i] = calc_implicit_formula(order, var_param[i]->temp_value, var_param[i]->value, var_param[i]->prev_val[0], var_param[i]->prev_val[1], var_param[i]->prev_val[2], var_param[i]->k[0], k_t[num_of_var_species+i], var_param[i]->prev_k[0], var_param[i]->prev_k[1], dt);
+              /* numerical differentiation */
+              jacobian[num_of_var_species+i][loop] = (delta_value[num_of_var_species+i]-b[num_of_var_species+i])/delta;
+            }
+            for(i=0; i<num_of_var_compartments; i++){
+              delta_value[num_of_var_species+num_of_var_parameters+i] = calc_implicit_formula(order, var_comp[i]->temp_value, var_comp[i]->value, var_comp[i]->prev_val[0], var_comp[i]->prev_val[1], var_comp[i]->prev_val[2], var_comp[i]->k[0], k_t[num_of_var_species+num_of_var_parameters+i], var_comp[i]->prev_k[0], var_comp[i]->prev_k[1], dt);
+              /* numerical differentiation */
+              jacobian[num_of_var_species+num_of_var_parameters+i][loop] = (delta_value[num_of_var_species+num_of_var_parameters+i]-b[num_of_var_species+num_of_var_parameters+i])/delta;
+            }
+            for(i=0; i<num_of_var_species_reference; i++){
+              delta_value[num_of_var_species+num_of_var_parameters+num_of_var_compartments+i] = calc_implicit_formula(order, var_spr[i]->temp_value, var_spr[i]->value, var_spr[i]->prev_val[0], var_spr[i]->prev_val[1], var_spr[i]->prev_val[2], var_spr[i]->k[0], k_t[num_of_var_species+num_of_var_parameters+num_of_var_compartments+i], var_spr[i]->prev_k[0], var_spr[i]->prev_k[1], dt);
+              /* numerical differentiation */
+              jacobian[num_of_var_species+num_of_var_parameters+num_of_var_compartments+i][loop] = (delta_value[num_of_var_species+num_of_var_parameters+num_of_var_compartments+i]-b[num_of_var_species+num_of_var_parameters+num_of_var_compartments+i])/delta;
+            }
+            if(loop < num_of_var_species){
+              /* restore the value itself, x + delta - delta may differ from x */
+              var_sp[loop]->temp_value = saved_value;
+            }else if(loop < num_of_var_species+num_of_var_parameters){
+              var_param[loop-num_of_var_species]->temp_value = saved_value;
+            }else if(loop < num_of_var_species+num_of_var_parameters+num_of_var_compartments){
+              var_comp[loop-num_of_var_species-num_of_var_parameters]->temp_value = saved_value;
+            }else{
+              var_spr[loop-num_of_var_species-num_of_var_parameters-num_of_var_compartments]->temp_value = saved_value;
+            }
           }
         }
       }
@@ -519,6 +527,7 @@ myResult* simulate_implicit(Model_t *m, myResult *result, mySpecies *sp[], myPar
       /* LU decomposition */
       error = lu_decomposition(jacobian, p, sum_num_of_vars);
       if(error == 0){/* failure in LU decomposition */
+        parallel_jacobian_free(jac);
         return NULL;
       }
 
@@ -699,5 +708,6 @@ myResult* simulate_implicit(Model_t *m, myResult *result, mySpecies *sp[], myPar
   free(var_spr);
   /* for implicit */
   free(jacobian);
+  parallel_jacobian_free(jac);
   return result;
 }
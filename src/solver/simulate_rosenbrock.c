@@ -0,0 +1,394 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "../libsbmlsim/libsbmlsim.h"
+
+/* Linearly implicit Rosenbrock methods (Hairer and Wanner, IV.7).
+ * Each stage solves
+ *   (1/(gamma*h) I - J) u_i = f(t + alpha_i*h, y + sum a_ij*u_j)
+ *                             + sum (c_ij/h)*u_j + gamma_i*h*df/dt
+ * with the same LU matrix, so a step needs one jacobian, one LU
+ * decomposition and no Newton iteration. */
+
+#define ROS_MAX_STAGES MAX_ROSENBROCK_STAGES
+#define ROS_SAFETY 0.9
+#define ROS_MIN_STEP_RATIO 0.2
+
+typedef struct {
+  int stages;
+  int order; /* order of the error estimate + 1 */
+  double gamma;
+  double a[ROS_MAX_STAGES][ROS_MAX_STAGES];
+  double c[ROS_MAX_STAGES][ROS_MAX_STAGES];
+  double m[ROS_MAX_STAGES];
+  double e[ROS_MAX_STAGES];
+  double alpha[ROS_MAX_STAGES];
+  double gammas[ROS_MAX_STAGES];
+  int new_f[ROS_MAX_STAGES]; /* 0: reuse f of the previous stage */
+} rosenbrock_tableau;
+
+/* RODAS3 by Sandu et al., stiffly accurate, L-stable */
+static const rosenbrock_tableau rodas3 = {
+  4, 3, 0.5,
+  {{0, 0, 0}, {0, 0, 0}, {2, 0, 0}, {2, 0, 1}},
+  {{0, 0, 0}, {4, 0, 0}, {1, -1, 0}, {1, -1, -8.0/3.0}},
+  {2, 0, 1, 1},
+  {0, 0, 0, 1},
+  {0, 0, 1, 1},
+  {0.5, 1.5, 0, 0},
+  {1, 0, 1, 1}
+};
+
+/* RODAS4 by Hairer and Wanner, stiffly accurate, L-stable */
+static const rosenbrock_tableau rodas4 = {
+  6, 4, 0.25,
+  {{0, 0, 0, 0, 0},
+   {1.544, 0, 0, 0, 0},
+   {0.9466785280815826, 0.2557011698983284, 0, 0, 0},
+   {3.314825187068521, 2.896124015972201, 0.9986419139977817, 0, 0},
+   {1.221224509226641, 6.019134481288629, 12.53708332932087, -0.6878860361058950, 0},
+   {1.221224509226641, 6.019134481288629, 12.53708332932087, -0.6878860361058950, 1}},
+  {{0, 0, 0, 0, 0},
+   {-5.6688, 0, 0, 0, 0},
+   {-2.430093356833875, -0.2063599157091915, 0, 0, 0},
+   {-0.1073529058151375, -9.594562251023355, -20.47028614809616, 0, 0},
+   {7.496443313967647, -10.24680431464352, -33.99990352819905, 11.70890893206160, 0},
+   {8.083246795921522, -7.981132988064893, -31.52159432874371, 16.31930543123136, -6.058818238834054}},
+  {1.221224509226641, 6.019134481288629, 12.53708332932087, -0.6878860361058950, 1, 1},
+  {0, 0, 0, 0, 0, 1},
+  {0, 0.386, 0.21, 0.63, 1, 1},
+  {0.25, -0.1043, 0.1035, -0.03620000000000023, 0, 0},
+  {1, 1, 1, 1, 1, 1}
+};
+
+static double rosenbrock_error_norm(unsigned int n, const double *err, const double *y0, const double *y1, double atol, double rtol){
+  unsigned int i;
+  double sk, sum = 0;
+  if(n == 0){
+    return 0;
+  }
+  for(i=0; i<n; i++){
+    sk = atol + rtol*my_fmax(fabs(y0[i]), fabs(y1[i]));
+    sum += (err[i]/sk)*(err[i]/sk);
+  }
+  return sqrt(sum/n);
+}
+
+int rosenbrock_time_derivative(ode_system *sys, double t, const double *y, const double *f0, double *dfdt){
+  unsigned int i;
+  double delta = sqrt(DBL_EPSILON)*my_fmax(fabs(t), 1.0e-5);
+  if(!ode_system_rhs(sys, t + delta, y, dfdt)){
+    return 0;
+  }
+  for(i=0; i<sys->num_of_vars; i++){
+    dfdt[i] = (dfdt[i] - f0[i])/delta;
+  }
+  return 1;
+}
+
+double rosenbrock_step(ode_system *sys, int order, double t, double h, const double *y, const double *f0, double **jacobian, const double *dfdt, double **ros_matrix, int *p, double **u, double *ytmp, double *fs, double *ynew, double *yerr, double atol, double rtol){
+  unsigned int i, j;
+  int s, l;
+  unsigned int n = sys->num_of_vars;
+  const rosenbrock_tableau *tab = (order == 3) ? &rodas3 : &rodas4;
+
+  for(i=0; i<n; i++){
+    for(j=0; j<n; j++){
+      ros_matrix[i][j] = -jacobian[i][j];
+    }
+    ros_matrix[i][i] += 1.0/(tab->gamma*h);
+  }
+  sys->num_of_lu_decompositions++;
+  if(n > 0 && !lu_decomposition(ros_matrix, p, n)){
+    return -1;
+  }
+
+  /* stages */
+  for(s=0; s<tab->stages; s++){
+    if(s == 0){
+      for(i=0; i<n; i++){
+        fs[i] = f0[i];
+      }
+    }else if(tab->new_f[s]){
+      for(i=0; i<n; i++){
+        ytmp[i] = y[i];
+        for(l=0; l<s; l++){
+          ytmp[i] += tab->a[s][l]*u[l][i];
+        }
+      }
+      if(!ode_system_rhs(sys, t + tab->alpha[s]*h, ytmp, fs)){
+        return -1;
+      }
+    }
+    for(i=0; i<n; i++){
+      u[s][i] = fs[i] + tab->gammas[s]*h*dfdt[i];
+      for(l=0; l<s; l++){
+        u[s][i] += tab->c[s][l]/h*u[l][i];
+      }
+    }
+    if(n > 0){
+      lu_solve(ros_matrix, p, n, u[s]);
+    }
+  }
+  for(i=0; i<n; i++){
+    ynew[i] = y[i];
+    yerr[i] = 0;
+    for(s=0; s<tab->stages; s++){
+      ynew[i] += tab->m[s]*u[s][i];
+      yerr[i] += tab->e[s]*u[s][i];
+    }
+  }
+  return rosenbrock_error_norm(n, yerr, y, ynew, atol, rtol);
+}
+
+myResult* simulate_rosenbrock(Model_t *m, myResult *result, mySpecies *sp[], myParameter *param[], myCompartment *comp[], myReaction *re[], myRule *rule[], myEvent *event[], myInitialAssignment *initAssign[], myAlgebraicEquations *algEq, timeVariantAssignments *timeVarAssign, double sim_time, double dt, int print_interval, double *time, int order, int print_amount, allocated_memory *mem, sbmlsim_context *ctx, double atol, double rtol, double facmax){
+  unsigned int i;
+  int s;
+  ode_system *sys;
+  unsigned int n;
+  myResult *rtn = result;
+  const rosenbrock_tableau *tab = (order == 3) ? &rodas3 : &rodas4;
+  /* output */
+  int row = 0;
+  int num_of_rows = result->num_of_rows;
+  double out_interval = print_interval*dt;
+  double out_eps;
+  double tend = (num_of_rows-1)*out_interval;
+  /* step */
+  double t = 0, tnew;
+  double h = 0, hmax;
+  double d0, d1;
+  double err, fac;
+  boolean last_rejected = false;
+  boolean need_f0 = true;
+  boolean jac_is_valid = false;
+  int has_event = 0;
+  ode_hermite hermite;
+  /* arrays */
+  double **jacobian;
+  double **ros_matrix;
+  int *p; /* for pivot selection */
+  double *u[ROS_MAX_STAGES];
+  double *y, *ynew, *ytmp, *yerr, *f0, *fs, *dfdt, *ewt;
+
+  PRG_TRACE(("Simulation for [%s] Starts!\n", Model_getId(m)));
+
+  sys = ode_system_create(m, sp, param, comp, re, rule, event, algEq, time, dt, ctx);
+  n = sys->num_of_vars;
+  if(!ode_system_initialize(sys, initAssign, timeVarAssign, sim_time, mem)){
+    ode_system_free(sys);
+    return NULL;
+  }
+
+  jacobian = (double **)malloc(sizeof(double *) * n);
+  ros_matrix = (double **)malloc(sizeof(double *) * n);
+  for(i=0; i<n; i++){
+    jacobian[i] = (double *)malloc(sizeof(double) * n);
+    ros_matrix[i] = (double *)malloc(sizeof(double) * n);
+  }
+  p = (int *)malloc(sizeof(int) * n);
+  for(s=0; s<tab->stages; s++){
+    u[s] = (double *)malloc(sizeof(double) * n);
+  }
+  y = (double *)malloc(sizeof(double) * n);
+  ynew = (double *)malloc(sizeof(double) * n);
+  ytmp = (double *)malloc(sizeof(double) * n);
+  yerr = (double *)malloc(sizeof(double) * n);
+  f0 = (double *)malloc(sizeof(double) * n);
+  fs = (double *)malloc(sizeof(double) * n);
+  dfdt = (double *)malloc(sizeof(double) * n);
+  ewt = (double *)malloc(sizeof(double) * n);
+
+  /* results are printed and events are located by cubic Hermite
+   * interpolation */
+  hmax = tend;
+  hermite.n = n;
+  hermite.y0 = y;
+  hermite.f0 = f0;
+  hermite.y1 = ynew;
+  hermite.f1 = fs;
+  out_eps = 1.0e-10*out_interval;
+
+  /* t = 0 */
+  ode_system_calc_discontinuity(sys);
+  ode_system_get_state(sys, y);
+  if(ode_system_commit(sys, t, y)){
+    ode_system_print_result(sys, result, row++, print_amount);
+  }else{
+    rtn = NULL;
+  }
+
+  while(rtn != NULL && row < num_of_rows){
+    if(need_f0){
+      if(!ode_system_rhs(sys, t, y, f0)){
+        TRACE(("the state can not be set at t = %g\n", t));
+        rtn = NULL;
+        break;
+      }
+      need_f0 = false;
+      jac_is_valid = false;
+      h = 0;
+    }
+    ode_system_error_weights(n, y, atol, rtol, ewt);
+    if(h == 0){
+      /* initial step size */
+      d0 = ode_system_wrms_norm(n, y, ewt);
+      d1 = ode_system_wrms_norm(n, f0, ewt);
+      if(d0 > 1.0e-5 && d1 > 1.0e-5){
+        h = 0.01*d0/d1;
+      }else if(n == 0){
+        h = hmax;
+      }else{
+        h = 1.0e-6*my_fmax(out_interval, 1.0e-3);
+      }
+      last_rejected = false;
+    }
+    if(h > hmax){
+      h = hmax;
+    }
+    if(t + h > tend){
+      h = tend - t;
+    }
+    if(h < 100*DBL_EPSILON*my_fmax(fabs(t), out_interval)){
+      TRACE(("step size too small at t = %g\n", t));
+      rtn = NULL;
+      break;
+    }
+
+    /* jacobian and df/dt at (t, y), kept while the step is retried */
+    if(!jac_is_valid){
+      if(!ode_system_jacobian(sys, t, y, f0, ewt, jacobian)
+          || !rosenbrock_time_derivative(sys, t, y, f0, dfdt)){
+        TRACE(("the state can not be set near t = %g\n", t));
+        rtn = NULL;
+        break;
+      }
+      jac_is_valid = true;
+    }
+    err = rosenbrock_step(sys, order, t, h, y, f0, jacobian, dfdt, ros_matrix, p, u, ytmp, fs, ynew, yerr, atol, rtol);
+    if(err < 0){
+      /* singular matrix, or f can not be evaluated in the step */
+      sys->num_of_rejected_steps++;
+      h *= 0.5;
+      last_rejected = true;
+      continue;
+    }
+
+    /* step size control */
+    fac = pow(err, 1.0/tab->order)/ROS_SAFETY;
+    fac = my_fmax(1.0/facmax, my_fmin(1.0/ROS_MIN_STEP_RATIO, fac));
+    if(err > 1.0 || err != err){
+      /* reject */
+      sys->num_of_rejected_steps++;
+      if(err != err){
+        fac = 1.0/ROS_MIN_STEP_RATIO;
+      }
+      h /= fac;
+      last_rejected = true;
+      continue;
+    }
+
+    /* accept, truncate the step at the first event */
+    sys->num_of_steps++;
+    tnew = t + h;
+    if(!ode_system_rhs(sys, tnew, ynew, fs)){
+      TRACE(("the state can not be set at t = %g\n", tnew));
+      rtn = NULL;
+      break;
+    }
+    hermite.t0 = t;
+    hermite.h = h;
+    if(sys->num_of_events > 0){
+      has_event = ode_system_locate_event(sys, t, tnew, ode_hermite_interpolate, &hermite, &tnew, ytmp);
+      if(has_event < 0){
+        TRACE(("the state can not be set in the step from t = %g\n", t));
+        rtn = NULL;
+        break;
+      }
+    }
+
+    /* print result (yerr is free until the next step) */
+    while(row < num_of_rows && row*out_interval < tnew - out_eps){
+      ode_hermite_interpolate(&hermite, row*out_interval, yerr);
+      if(!ode_system_set_state(sys, row*out_interval, yerr)){
+        rtn = NULL;
+        break;
+      }
+      ode_system_print_result(sys, result, row++, print_amount);
+    }
+    if(has_event){
+      for(i=0; i<n; i++){
+        ynew[i] = ytmp[i];
+      }
+    }
+    t = tnew;
+    for(i=0; i<n; i++){
+      y[i] = ynew[i];
+    }
+    jac_is_valid = false;
+    if(rtn == NULL || !ode_system_commit(sys, t, y)){
+      TRACE(("the state can not be set at t = %g\n", t));
+      rtn = NULL;
+      break;
+    }
+
+    /* fast reactions and events */
+    if(ode_system_calc_discontinuity(sys) || has_event){
+      ode_system_get_state(sys, y);
+      need_f0 = true;
+    }else{
+      /* f(t, y) is evaluated above */
+      for(i=0; i<n; i++){
+        f0[i] = fs[i];
+      }
+    }
+    while(row < num_of_rows && row*out_interval <= t + out_eps){
+      *time = row*out_interval;
+      ode_system_print_result(sys, result, row++, print_amount);
+    }
+    *time = t;
+
+    /* next step size */
+    if(last_rejected){
+      h = my_fmin(h, h/fac);
+    }else{
+      h = h/fac;
+    }
+    last_rejected = false;
+  }
+
+  TRACE(("Rosenbrock: %u steps, %u rejected, %u f evaluations, %u jacobians, %u LU decompositions\n", sys->num_of_steps, sys->num_of_rejected_steps, sys->num_of_rhs_evaluations, sys->num_of_jacobian_evaluations, sys->num_of_lu_decompositions));
+  ode_system_store_statistics(sys, result);
+  PRG_TRACE(("Simulation for [%s] Ends!\n", Model_getId(m)));
+
+  for(i=0; i<n; i++){
+    free(jacobian[i]);
+    free(ros_matrix[i]);
+  }
+  free(jacobian);
+  free(ros_matrix);
+  free(p);
+  for(s=0; s<tab->stages; s++){
+    free(u[s]);
+  }
+  free(y);
+  free(ynew);
+  free(ytmp);
+  free(yerr);
+  free(f0);
+  free(fs);
+  free(dfdt);
+  free(ewt);
+  ode_system_free(sys);
+  return rtn;
+}
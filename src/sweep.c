@@ -0,0 +1,267 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "libsbmlsim/libsbmlsim.h"
+#include "sweep.h"
+
+/* Parameter sweep API.
+ * The document is parsed (and validated) once. Each worker owns a clone
+ * of the document, prepared once as an sbmlsim_model, and its own
+ * sbmlsim_context, and the points are run by the work-stealing
+ * scheduler (see sbmlsim_scheduler.h). The values of a point are set
+ * in the prepared model of the worker, so no object is shared between
+ * threads and the model is not prepared again for each point. */
+
+typedef struct _sweep_job {
+  mySweepPoints *points;
+  double sim_time;
+  double dt;
+  int print_interval;
+  int print_amount;
+  int method;
+  int use_lazy_method;
+  double atol;
+  double rtol;
+  double facmax;
+  sbmlsim_mutex *mutex; /* for result */
+  LibsbmlsimErrorCode *point_error_codes;
+  double *point_times;
+  mySweepResult *result;
+  struct _sweep_worker *workers;
+} sweep_job;
+
+typedef struct _sweep_worker {
+  sweep_job *job;
+  SBMLDocument_t *d;
+  Model_t *m;
+  sbmlsim_model *model;
+  sbmlsim_context *ctx;
+} sweep_worker;
+
+/* find the target of id in m, returns 0 if there is no such
+ * species, parameter or compartment */
+int sbmlsim_sweep_find_target(Model_t *m, const char *id, int *kind, SBase_t **target, double *value) {
+  Species_t *s;
+  Parameter_t *p;
+  Compartment_t *c;
+
+  if ((s = Model_getSpeciesById(m, id)) != NULL) {
+    if (Species_isSetInitialAmount(s)) {
+      *kind = SWEEP_SPECIES_AMOUNT;
+      *value = Species_getInitialAmount(s);
+    } else {
+      *kind = SWEEP_SPECIES_CONCENTRATION;
+      *value = Species_getInitialConcentration(s);
+    }
+    *target = (SBase_t *)s;
+    return 1;
+  }
+  if ((p = Model_getParameterById(m, id)) != NULL) {
+    *kind = SWEEP_PARAMETER;
+    *value = Parameter_getValue(p);
+    *target = (SBase_t *)p;
+    return 1;
+  }
+  if ((c = Model_getCompartmentById(m, id)) != NULL) {
+    *kind = SWEEP_COMPARTMENT;
+    *value = Compartment_getSize(c);
+    *target = (SBase_t *)c;
+    return 1;
+  }
+  return 0;
+}
+
+/* set the values of a point in model, the ids without a value keep the
+ * one of the model */
+void sbmlsim_sweep_set_point(sbmlsim_model *model, mySweepPoints *points, int point) {
+  double value;
+  int i;
+
+  sbmlsim_model_reset_values(model);
+  for (i = 0; i < points->num_of_ids; i++) {
+    value = points->values[point * points->num_of_ids + i];
+    if (!my_isnan(value)) {
+      sbmlsim_model_set_value(model, points->ids[i], value);
+    }
+  }
+}
+
+/* sbmlsim_task_func of the scheduler, task is the index of the point */
+static void run_sweep_point(void *arg, int point, int worker_index) {
+  sweep_job *job = (sweep_job *)arg;
+  sweep_worker *worker = &job->workers[worker_index];
+  mySweepResult *result;
+  myResult *res;
+  LibsbmlsimErrorCode code;
+  double start_time;
+
+  start_time = sbmlsim_wall_time();
+  sbmlsim_sweep_set_point(worker->model, job->points, point);
+  /* each point has its own stream of the seed, so that stochastic events
+   * give the same results for any number of threads */
+  sbmlsim_context_seed_stream(worker->ctx, job->points->seed, (unsigned int)point);
+  res = sbmlsim_model_run(worker->model, worker->ctx, job->sim_time,
+      job->dt, job->print_interval, job->print_amount, job->method,
+      job->use_lazy_method, job->atol, job->rtol, job->facmax);
+  code = (res == NULL) ? SimulationFailed : res->error_code;
+  result = NULL;
+  sbmlsim_mutex_lock(job->mutex);
+  if (code == NoError) {
+    if (job->result == NULL) {
+      job->result = create_mySweepResult(res, job->points->num_of_points);
+    }
+    result = job->result;
+    if (res->num_of_rows != result->num_of_rows) {
+      code = SimulationFailed;
+      result = NULL;
+    }
+  }
+  job->point_error_codes[point] = code;
+  sbmlsim_mutex_unlock(job->mutex);
+  /* each point has its own rows in the block */
+  if (result != NULL) {
+    mySweepResult_store(result, point, res);
+  }
+  if (res != NULL) {
+    free_myResult(res);
+  }
+  job->point_times[point] = sbmlsim_wall_time() - start_time;
+}
+
+SBMLSIM_EXPORT mySweepResult *simulateSBMLModelSweep(Model_t *m, mySweepPoints *points,
+    double sim_time, double dt, int print_interval, int print_amount, int method,
+    int use_lazy_method, double atol, double rtol, double facmax, int num_of_threads) {
+  sweep_job job;
+  sweep_worker *workers;
+  sbmlsim_worker_stats *stats;
+  mySweepResult *result;
+  SBMLDocument_t *d;
+  SBase_t *target;
+  double value;
+  double start_time;
+  int num_of_workers, kind;
+  int i;
+
+  if (m == NULL || points == NULL || points->num_of_points == 0) {
+    return create_mySweepResult_with_errorCode(InvalidArgument);
+  }
+  for (i = 0; i < points->num_of_ids; i++) {
+    if (!sbmlsim_sweep_find_target(m, points->ids[i], &kind, &target, &value)) {
+      return create_mySweepResult_with_error(InvalidArgument, "Unknown Species, Parameter or Compartment ID");
+    }
+  }
+  d = (SBMLDocument_t *)SBase_getSBMLDocument((SBase_t *)m);
+  if (d == NULL) {
+    return create_mySweepResult_with_errorCode(InvalidArgument);
+  }
+
+  job.points = points;
+  job.sim_time = sim_time;
+  job.dt = dt;
+  job.print_interval = print_interval;
+  job.print_amount = print_amount;
+  job.method = method;
+  job.use_lazy_method = use_lazy_method;
+  job.atol = atol;
+  job.rtol = rtol;
+  job.facmax = facmax;
+  job.mutex = sbmlsim_mutex_create();
+  job.point_error_codes = (LibsbmlsimErrorCode *)malloc(sizeof(LibsbmlsimErrorCode) * points->num_of_points);
+  job.point_times = (double *)malloc(sizeof(double) * points->num_of_points);
+  job.result = NULL;
+
+  /* clone the documents here, libSBML objects are not thread safe */
+  num_of_workers = sbmlsim_num_of_workers(num_of_threads, points->num_of_points);
+  workers = (sweep_worker *)malloc(sizeof(sweep_worker) * num_of_workers);
+  job.workers = workers;
+  for (i = 0; i < num_of_workers; i++) {
+    workers[i].job = &job;
+    workers[i].d = SBMLDocument_clone(d);
+    workers[i].m = SBMLDocument_getModel(workers[i].d);
+    workers[i].model = sbmlsim_model_create(workers[i].m);
+    workers[i].ctx = sbmlsim_context_create(0);
+    /* the points are already run in parallel */
+    sbmlsim_context_set_num_of_threads(workers[i].ctx, 1);
+  }
+
+  stats = (sbmlsim_worker_stats *)malloc(sizeof(sbmlsim_worker_stats) * num_of_workers);
+  start_time = sbmlsim_wall_time();
+  sbmlsim_run_tasks(points->num_of_points, points->costs, num_of_workers,
+      run_sweep_point, &job, stats);
+
+  if (job.result == NULL) {
+    /* no point succeeded */
+    result = create_mySweepResult_with_errorCode(job.point_error_codes[0]);
+  } else {
+    result = job.result;
+    for (i = 0; i < points->num_of_points; i++) {
+      result->point_error_codes[i] = job.point_error_codes[i];
+    }
+  }
+  result->num_of_threads = num_of_workers;
+  result->point_times = job.point_times;
+  result->elapsed_time = sbmlsim_wall_time() - start_time;
+  result->worker_stats = stats;
+
+  for (i = 0; i < num_of_workers; i++) {
+    sbmlsim_model_free(workers[i].model);
+    sbmlsim_context_free(workers[i].ctx);
+    SBMLDocument_free(workers[i].d);
+  }
+  free(workers);
+  free(job.point_error_codes);
+  sbmlsim_mutex_free(job.mutex);
+  return result;
+}
+
+SBMLSIM_EXPORT mySweepResult *simulateSBMLFromFileSweep(const char *file, mySweepPoints *points,
+    double sim_time, double dt, int print_interval, int print_amount, int method,
+    int use_lazy_method, int num_of_threads) {
+  SBMLDocument_t *d;
+  mySweepResult *rtn;
+  LibsbmlsimErrorCode err_code;
+
+  d = readSBMLFromFile(file);
+  if (d == NULL)
+    return create_mySweepResult_with_errorCode(Unknown);
+  err_code = get_SBMLDocument_errorCode(d);
+  if (err_code == NoError) {
+    rtn = simulateSBMLModelSweep(SBMLDocument_getModel(d), points, sim_time, dt,
+        print_interval, print_amount, method, use_lazy_method, 0.0, 0.0, 0.0, num_of_threads);
+  } else {
+    rtn = create_mySweepResult_with_errorCode(err_code);
+  }
+  SBMLDocument_free(d);
+  return rtn;
+}
+
+SBMLSIM_EXPORT mySweepResult *simulateSBMLFromStringSweep(const char *str, mySweepPoints *points,
+    double sim_time, double dt, int print_interval, int print_amount, int method,
+    int use_lazy_method, int num_of_threads) {
+  SBMLDocument_t *d;
+  mySweepResult *rtn;
+  LibsbmlsimErrorCode err_code;
+
+  d = readSBMLFromString(str);
+  if (d == NULL)
+    return create_mySweepResult_with_errorCode(Unknown);
+  err_code = get_SBMLDocument_errorCode(d);
+  if (err_code == NoError) {
+    rtn = simulateSBMLModelSweep(SBMLDocument_getModel(d), points, sim_time, dt,
+        print_interval, print_amount, method, use_lazy_method, 0.0, 0.0, 0.0, num_of_threads);
+  } else {
+    rtn = create_mySweepResult_with_errorCode(err_code);
+  }
+  SBMLDocument_free(d);
+  return rtn;
+}
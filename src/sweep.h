@@ -0,0 +1,32 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#ifndef LibSBMLSim_Sweep_h
+#define LibSBMLSim_Sweep_h
+
+/* internal functions of the sweep (sweep.c) shared with the ensemble
+ * runner (ensemble.c), not installed with the public headers */
+
+#include "libsbmlsim/libsbmlsim.h"
+
+/* targets of the values of a sweep point. sbmlsim_sweep_find_target
+ * returns 0 if id is not a species, parameter or compartment of m.
+ * sbmlsim_sweep_set_point sets the values of a point in a prepared model */
+#define SWEEP_SPECIES_AMOUNT 0
+#define SWEEP_SPECIES_CONCENTRATION 1
+#define SWEEP_PARAMETER 2
+#define SWEEP_COMPARTMENT 3
+int sbmlsim_sweep_find_target(Model_t *m, const char *id, int *kind, SBase_t **target, double *value);
+void sbmlsim_sweep_set_point(sbmlsim_model *model, mySweepPoints *points, int point);
+
+#endif /* LibSBMLSim_Sweep_h */
@@ -0,0 +1,282 @@
+/**
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBMLSim.  Please visit
+ * http://fun.bio.keio.ac.jp/software/libsbmlsim/ for more
+ * information about libSBMLSim and its latest version.
+ *
+ * Copyright (C) 2011-2017 by the Keio University, Yokohama, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution.
+ * ---------------------------------------------------------------------- -->*/
+#include "libsbmlsim/libsbmlsim.h"
+#include <pthread.h>
+
+/* Simulate the same model on several threads at once, each in its own
+ * context, and compare the results with the one simulated alone, and
+ * with the one evaluated by several threads (reactions and jacobian).
+ * Then simulate a prepared model with each method in turn, twice, and
+ * run a parameter sweep with one and with several threads. */
+
+#define NUM_OF_THREADS 8
+#define NUM_OF_POINTS 32
+#define SEED 5489
+
+typedef struct {
+  const char *file;
+  int method;
+  int inner_threads; /* threads of the simulation, regardless of the size of the model */
+  myResult *result;
+} simulation;
+
+static void *simulate(void *arg) {
+  simulation *sim = (simulation *)arg;
+  SBMLDocument_t *d;
+  sbmlsim_context *ctx;
+
+  d = readSBMLFromFile(sim->file);
+  ctx = sbmlsim_context_create(SEED);
+  sbmlsim_context_set_num_of_threads(ctx, sim->inner_threads);
+  sbmlsim_context_set_parallel_thresholds(ctx, 0, 0);
+  sim->result = simulateSBMLModelWithContext(ctx, SBMLDocument_getModel(d),
+      10, 0.01, 10, 0, sim->method, false, 0.0, 0.0, 0.0);
+  sbmlsim_context_free(ctx);
+  SBMLDocument_free(d);
+  return NULL;
+}
+
+static int same_values(const double *a, const double *b, int n) {
+  return n == 0 || memcmp(a, b, sizeof(double) * n) == 0;
+}
+
+static int same_result(myResult *a, myResult *b) {
+  if (a == NULL || b == NULL || myResult_isError(a) || myResult_isError(b))
+    return 0;
+  return a->num_of_rows == b->num_of_rows
+    && same_values(a->values_time, b->values_time, a->num_of_rows)
+    && same_values(a->values_sp, b->values_sp, a->num_of_rows * a->num_of_columns_sp)
+    && same_values(a->values_param, b->values_param, a->num_of_rows * a->num_of_columns_param)
+    && same_values(a->values_comp, b->values_comp, a->num_of_rows * a->num_of_columns_comp);
+}
+
+/* simulate one prepared model with the methods in turn, twice (with a
+ * shorter simulation in between), and with the value of a parameter set
+ * or updated, return 1 if a result differs from the one of a model
+ * prepared for each simulation, or if the model is not taken from a model
+ * cache again */
+static int prepared(const char *file, const int *methods, int num_of_methods) {
+  sbmlsim_model *model;
+  sbmlsim_model_cache *cache;
+  sbmlsim_context *ctx;
+  SBMLDocument_t *d;
+  Parameter_t *p;
+  const char *id;
+  simulation reference;
+  myResult *result;
+  int i, j;
+  int failed = 0;
+
+  model = sbmlsim_model_create_from_file(file);
+  for (i = 0; i < 2; i++) {
+    for (j = 0; j < num_of_methods; j++) {
+      reference.file = file;
+      reference.method = methods[j];
+      reference.inner_threads = 1;
+      simulate(&reference);
+      ctx = sbmlsim_context_create(SEED);
+      if (i == 1) {
+        free_myResult(sbmlsim_model_simulate_with_context(model, ctx,
+              5, 0.01, 10, 0, methods[j], false, 0.0, 0.0, 0.0));
+        sbmlsim_context_free(ctx);
+        ctx = sbmlsim_context_create(SEED);
+      }
+      result = sbmlsim_model_simulate_with_context(model, ctx,
+          10, 0.01, 10, 0, methods[j], false, 0.0, 0.0, 0.0);
+      if (!same_result(reference.result, result)) {
+        printf("method %d: result of the prepared model differs (run %d)\n", methods[j], i);
+        failed = 1;
+      }
+      free_myResult(result);
+      sbmlsim_context_free(ctx);
+      if (reference.result != NULL) {
+        free_myResult(reference.result);
+      }
+    }
+  }
+  if (Model_getNumParameters(model->m) > 0) {
+    d = readSBMLFromFile(file);
+    p = Model_getParameter(SBMLDocument_getModel(d), 0);
+    Parameter_setValue(p, Parameter_getValue(p) * 1.5);
+    ctx = sbmlsim_context_create(SEED);
+    reference.result = simulateSBMLModelWithContext(ctx, SBMLDocument_getModel(d),
+        10, 0.01, 10, 0, MTHD_RUNGE_KUTTA, false, 0.0, 0.0, 0.0);
+    sbmlsim_context_free(ctx);
+    SBMLDocument_free(d);
+    /* a value set in the prepared model, then in the SBML model */
+    for (i = 0; i < 2; i++) {
+      p = Model_getParameter(model->m, 0);
+      id = Parameter_getId(p);
+      if (i == 0) {
+        sbmlsim_model_set_value(model, id, Parameter_getValue(p) * 1.5);
+      } else {
+        sbmlsim_model_reset_values(model);
+        Parameter_setValue(p, Parameter_getValue(p) * 1.5);
+        if (!sbmlsim_model_update(model, &id, 1)) {
+          printf("prepared model is not updated with the value of %s\n", id);
+          failed = 1;
+        }
+      }
+      ctx = sbmlsim_context_create(SEED);
+      result = sbmlsim_model_simulate_with_context(model, ctx,
+          10, 0.01, 10, 0, MTHD_RUNGE_KUTTA, false, 0.0, 0.0, 0.0);
+      sbmlsim_context_free(ctx);
+      if (!same_result(reference.result, result)) {
+        printf("value of %s %s differs\n", id,
+            i == 0 ? "set in the prepared model" : "updated in the SBML model");
+        failed = 1;
+      }
+      free_myResult(result);
+    }
+    if (reference.result != NULL) {
+      free_myResult(reference.result);
+    }
+  }
+  sbmlsim_model_free(model);
+
+  /* the second model of the file is the first one, put back */
+  cache = sbmlsim_model_cache_create(1);
+  model = sbmlsim_model_cache_get_file(cache, file);
+  sbmlsim_model_cache_put(cache, model);
+  if (sbmlsim_model_cache_get_file(cache, file) != model
+      || sbmlsim_model_cache_get_num_of_hits(cache) != 1) {
+    printf("prepared model of %s is not taken from the cache\n", file);
+    failed = 1;
+  }
+  sbmlsim_model_cache_put(cache, model);
+  sbmlsim_model_cache_free(cache);
+  return failed;
+}
+
+/* sweep the first parameter (or the first species) from 0.5 to 2.5 times
+ * of its value, return 1 if the sweep differs between 1 and NUM_OF_THREADS
+ * threads */
+static int sweep(const char *file) {
+  SBMLDocument_t *d;
+  Model_t *m;
+  mySweepPoints *points;
+  mySweepResult *r1, *rn;
+  const char *id;
+  double value;
+  int i, index, num_of_points;
+  int failed = 0;
+
+  d = readSBMLFromFile(file);
+  m = SBMLDocument_getModel(d);
+  if (Model_getNumParameters(m) > 0) {
+    id = Parameter_getId(Model_getParameter(m, 0));
+    value = Parameter_getValue(Model_getParameter(m, 0));
+  } else if (Model_getNumSpecies(m) > 0) {
+    id = Species_getId(Model_getSpecies(m, 0));
+    value = Species_isSetInitialAmount(Model_getSpecies(m, 0)) ?
+      Species_getInitialAmount(Model_getSpecies(m, 0)) : Species_getInitialConcentration(Model_getSpecies(m, 0));
+  } else {
+    SBMLDocument_free(d);
+    return 0;
+  }
+  points = create_mySweepPoints();
+  index = mySweepPoints_addId(points, id);
+  for (i = 0; i < NUM_OF_POINTS; i++) {
+    mySweepPoints_setValue(points, mySweepPoints_addPoint(points), index, value * (0.5 + i / 16.0));
+  }
+  r1 = simulateSBMLModelSweep(m, points, 10, 0.01, 10, 0, MTHD_DORMAND_PRINCE, false, 0.0, 0.0, 0.0, 1);
+  /* the second run is scheduled by the times of the first one */
+  mySweepPoints_setCostsFromResult(points, r1);
+  rn = simulateSBMLModelSweep(m, points, 10, 0.01, 10, 0, MTHD_DORMAND_PRINCE, false, 0.0, 0.0, 0.0, NUM_OF_THREADS);
+  if (mySweepResult_isError(r1) || mySweepResult_isError(rn)
+      || r1->num_of_rows != rn->num_of_rows || r1->num_of_columns != rn->num_of_columns
+      || !same_values(r1->values, rn->values, NUM_OF_POINTS * r1->num_of_rows * r1->num_of_columns)) {
+    printf("sweep of %s: results of 1 and %d threads differ\n", id, NUM_OF_THREADS);
+    failed = 1;
+  } else {
+    num_of_points = 0;
+    for (i = 0; i < rn->num_of_threads; i++) {
+      num_of_points += rn->worker_stats[i].num_of_tasks;
+      printf("sweep worker %d: %d points, %d steals, utilisation %.2f\n", i,
+          rn->worker_stats[i].num_of_tasks, rn->worker_stats[i].num_of_steals,
+          mySweepResult_getWorkerUtilization(rn, i));
+    }
+    if (num_of_points != NUM_OF_POINTS) {
+      printf("sweep of %s: %d points run instead of %d\n", id, num_of_points, NUM_OF_POINTS);
+      failed = 1;
+    }
+  }
+  free_mySweepResult(r1);
+  free_mySweepResult(rn);
+  free_mySweepPoints(points);
+  SBMLDocument_free(d);
+  return failed;
+}
+
+int main(int argc, char *argv[]) {
+  int methods[] = {MTHD_RUNGE_KUTTA, MTHD_BACKWARD_DIFFERENCE_4, MTHD_ADAPTIVE_BACKWARD_DIFFERENCE, MTHD_DORMAND_PRINCE, MTHD_ROSENBROCK_4};
+  int num_of_methods = sizeof(methods) / sizeof(methods[0]);
+  simulation reference, inner;
+  simulation sims[NUM_OF_THREADS];
+  pthread_t threads[NUM_OF_THREADS];
+  int i, j;
+  int failed = 0;
+
+  if (argc < 2) {
+    printf("threadtest.c: Input SBML file is not specified.\n  Usage: %s sbml.xml\n", argv[0]);
+    exit(1);
+  }
+  for (j = 0; j < num_of_methods; j++) {
+    reference.file = argv[1];
+    reference.method = methods[j];
+    reference.inner_threads = 1;
+    simulate(&reference);
+    inner.file = argv[1];
+    inner.method = methods[j];
+    inner.inner_threads = NUM_OF_THREADS;
+    simulate(&inner);
+    if (!same_result(reference.result, inner.result)) {
+      printf("method %d: result of %d inner threads differs\n", methods[j], NUM_OF_THREADS);
+      failed = 1;
+    }
+    if (inner.result != NULL) {
+      free_myResult(inner.result);
+    }
+    for (i = 0; i < NUM_OF_THREADS; i++) {
+      sims[i].file = argv[1];
+      sims[i].method = methods[j];
+      sims[i].inner_threads = 1;
+      sims[i].result = NULL;
+      pthread_create(&threads[i], NULL, simulate, &sims[i]);
+    }
+    for (i = 0; i < NUM_OF_THREADS; i++) {
+      pthread_join(threads[i], NULL);
+      if (!same_result(reference.result, sims[i].result)) {
+        printf("method %d: result of thread %d differs\n", methods[j], i);
+        failed = 1;
+      }
+      if (sims[i].result != NULL) {
+        free_myResult(sims[i].result);
+      }
+    }
+    if (reference.result != NULL) {
+      free_myResult(reference.result);
+    }
+  }
+  if (prepared(argv[1], methods, num_of_methods)) {
+    failed = 1;
+  }
+  if (sweep(argv[1])) {
+    failed = 1;
+  }
+  if (!failed) {
+    printf("%d threads x %d methods, prepared model and sweep of %d points done\n", NUM_OF_THREADS, num_of_methods, NUM_OF_POINTS);
+  }
+  return failed;
+}
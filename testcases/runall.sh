@@ -90,6 +90,8 @@ for i in {0000{1..9},000{10..99},00{100..999},0100{0..9},010{10..99},0110{0..9},
   echo -en $print_msg
   ./simulateSBML -t $duration -s $steps $opt_delta -m 1 -n $opt_amount $sbml && \
   #./simulateSBML -t $duration -s $steps $opt_delta -m 13 -A $atol -R $rtol $opt_facmax -n $opt_amount $sbml && \
+  # adaptive step size methods (-m 15 .. 19) locate event times by themselves, so $opt_delta is not needed
+  #./simulateSBML -t $duration -s $steps -m 16 -A $atol -R $rtol -n $opt_amount $sbml && \
   ./genresult.pl out.csv $variables $steps > $result 
   echo -en $dbl_sp
   ./compare.pl $i